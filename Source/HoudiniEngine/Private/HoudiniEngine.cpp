@@ -50,6 +50,7 @@
 #include "ISettingsModule.h"
 #include "HAL/PlatformFileManager.h"
 #include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
 #include "Logging/LogMacros.h"
 #include "Framework/Application/SlateApplication.h"
 
@@ -63,6 +64,14 @@
 IMPLEMENT_MODULE(FHoudiniEngine, HoudiniEngine)
 DEFINE_LOG_CATEGORY( LogHoudiniEngine );
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineMultiSessionScheduler(
+	TEXT("HoudiniEngine.MultiSessionScheduler"),
+	0,
+	TEXT("Controls how instantiation and cook tasks are dispatched when using multiple sessions.\n")
+	TEXT("0: All tasks are processed in order by a single scheduler on the main session (default)\n")
+	TEXT("1: One scheduler per session, HDAs that don't feed each other are instantiated and cooked concurrently\n")
+);
+
 FHoudiniEngine *
 FHoudiniEngine::HoudiniEngineInstance = nullptr;
 
@@ -314,6 +323,8 @@ FHoudiniEngine::ShutdownModule()
 	FUnrealObjectInputManager::DestroySingleton();
 
 	// Do scheduler and thread clean up.
+	DestroySessionSchedulers();
+
 	if (HoudiniEngineScheduler)
 		HoudiniEngineScheduler->Stop();
 
@@ -358,11 +369,184 @@ FHoudiniEngine::ShutdownModule()
 	FHoudiniEngine::HoudiniEngineInstance = nullptr;
 }
 
+bool
+FHoudiniEngine::IsMultiSessionSchedulingEnabled()
+{
+	return CVarHoudiniEngineMultiSessionScheduler.GetValueOnAnyThread() > 0;
+}
+
+void
+FHoudiniEngine::UpdateSessionSchedulers()
+{
+	// We need one scheduler per session, the main scheduler handles session 0
+	const int32 NumNeeded = Sessions.Num() - 1;
+	while (SessionSchedulers.Num() < NumNeeded)
+	{
+		const int32 SessionIndex = SessionSchedulers.Num() + 1;
+		FHoudiniEngineScheduler* Scheduler = new FHoudiniEngineScheduler(SessionIndex);
+		FRunnableThread* SchedulerThread = FRunnableThread::Create(
+			Scheduler, *FString::Printf(TEXT("HoudiniSchedulerThread%d"), SessionIndex), 0, TPri_Normal);
+
+		SessionSchedulers.Add(Scheduler);
+		SessionSchedulerThreads.Add(SchedulerThread);
+	}
+}
+
+void
+FHoudiniEngine::DestroySessionSchedulers()
+{
+	// Take the workers out under the lock, but wait for them without it as they report their tasks to us
+	TArray<FHoudiniEngineScheduler*> Schedulers;
+	TArray<FRunnableThread*> SchedulerThreads;
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		Schedulers = MoveTemp(SessionSchedulers);
+		SchedulerThreads = MoveTemp(SessionSchedulerThreads);
+		SessionSchedulers.Empty();
+		SessionSchedulerThreads.Empty();
+		SchedulerAffinities.Empty();
+	}
+
+	for (FHoudiniEngineScheduler* Scheduler : Schedulers)
+	{
+		if (Scheduler)
+			Scheduler->Stop();
+	}
+
+	for (FRunnableThread* SchedulerThread : SchedulerThreads)
+	{
+		if (!SchedulerThread)
+			continue;
+
+		SchedulerThread->WaitForCompletion();
+		delete SchedulerThread;
+	}
+
+	for (FHoudiniEngineScheduler* Scheduler : Schedulers)
+	{
+		if (Scheduler)
+			delete Scheduler;
+	}
+}
+
+FHoudiniEngineScheduler*
+FHoudiniEngine::GetSchedulerForTask(const FHoudiniEngineTask& InTask)
+{
+	if (InTask.SchedulerAffinity == INDEX_NONE || !IsMultiSessionSchedulingEnabled())
+		return HoudiniEngineScheduler;
+
+	FScopeLock ScopeLock(&CriticalSection);
+
+	UpdateSessionSchedulers();
+
+	auto GetWorker = [&](const int32& InWorkerIndex)
+	{
+		return InWorkerIndex == 0 ? HoudiniEngineScheduler : SessionSchedulers[InWorkerIndex - 1];
+	};
+
+	// The task stays pending for its node tree until the scheduler reports it as processed
+	FSchedulerAffinityInfo& Affinity = SchedulerAffinities.FindOrAdd(InTask.SchedulerAffinity);
+	Affinity.NumPendingTasks++;
+
+	// Sessions may have been stopped/restarted with fewer sessions, only use workers with a valid session
+	const int32 NumWorkers = FMath::Min(Sessions.Num(), SessionSchedulers.Num() + 1);
+	if (NumWorkers <= 1)
+	{
+		Affinity.WorkerIndex = 0;
+		return HoudiniEngineScheduler;
+	}
+
+	// Tasks of a node tree that already has a worker must stay on it so they're processed in order.
+	if (Affinity.WorkerIndex != INDEX_NONE && Affinity.WorkerIndex < NumWorkers)
+		return GetWorker(Affinity.WorkerIndex);
+
+	// New node tree, or its worker went away: assign it to the worker with the least node trees,
+	// then the least pending tasks. Its asset and task counts are kept.
+	TArray<int32> NumAffinitiesPerWorker;
+	NumAffinitiesPerWorker.SetNumZeroed(NumWorkers);
+	for (const auto& Pair : SchedulerAffinities)
+	{
+		if (NumAffinitiesPerWorker.IsValidIndex(Pair.Value.WorkerIndex))
+			NumAffinitiesPerWorker[Pair.Value.WorkerIndex]++;
+	}
+
+	int32 BestWorkerIndex = 0;
+	for (int32 WorkerIndex = 1; WorkerIndex < NumWorkers; WorkerIndex++)
+	{
+		if (NumAffinitiesPerWorker[WorkerIndex] > NumAffinitiesPerWorker[BestWorkerIndex])
+			continue;
+
+		if (NumAffinitiesPerWorker[WorkerIndex] == NumAffinitiesPerWorker[BestWorkerIndex]
+			&& GetWorker(WorkerIndex)->GetNumPendingTasks() >= GetWorker(BestWorkerIndex)->GetNumPendingTasks())
+			continue;
+
+		BestWorkerIndex = WorkerIndex;
+	}
+
+	Affinity.WorkerIndex = BestWorkerIndex;
+
+	return GetWorker(BestWorkerIndex);
+}
+
+void
+FHoudiniEngine::AcquireSchedulerAffinity(const int32& InSchedulerAffinity)
+{
+	if (InSchedulerAffinity == INDEX_NONE)
+		return;
+
+	FScopeLock ScopeLock(&CriticalSection);
+	SchedulerAffinities.FindOrAdd(InSchedulerAffinity).NumAssets++;
+}
+
+void
+FHoudiniEngine::ReleaseSchedulerAffinity(const int32& InSchedulerAffinity)
+{
+	if (InSchedulerAffinity == INDEX_NONE)
+		return;
+
+	FScopeLock ScopeLock(&CriticalSection);
+	FSchedulerAffinityInfo* FoundAffinity = SchedulerAffinities.Find(InSchedulerAffinity);
+	if (!FoundAffinity)
+		return;
+
+	FoundAffinity->NumAssets = FMath::Max(FoundAffinity->NumAssets - 1, 0);
+	if (FoundAffinity->NumAssets == 0 && FoundAffinity->NumPendingTasks == 0)
+		SchedulerAffinities.Remove(InSchedulerAffinity);
+}
+
+bool
+FHoudiniEngine::IsSchedulerAffinityIdle(const int32& InSchedulerAffinity)
+{
+	if (InSchedulerAffinity == INDEX_NONE)
+		return true;
+
+	FScopeLock ScopeLock(&CriticalSection);
+	const FSchedulerAffinityInfo* FoundAffinity = SchedulerAffinities.Find(InSchedulerAffinity);
+	return !FoundAffinity || FoundAffinity->NumPendingTasks <= 0;
+}
+
+void
+FHoudiniEngine::OnSchedulerTaskProcessed(const FHoudiniEngineTask& InTask)
+{
+	if (InTask.SchedulerAffinity == INDEX_NONE)
+		return;
+
+	FScopeLock ScopeLock(&CriticalSection);
+	FSchedulerAffinityInfo* FoundAffinity = SchedulerAffinities.Find(InTask.SchedulerAffinity);
+	if (!FoundAffinity)
+		return;
+
+	FoundAffinity->NumPendingTasks = FMath::Max(FoundAffinity->NumPendingTasks - 1, 0);
+	if (FoundAffinity->NumAssets == 0 && FoundAffinity->NumPendingTasks == 0)
+		SchedulerAffinities.Remove(InTask.SchedulerAffinity);
+}
+
 void
 FHoudiniEngine::AddTask(const FHoudiniEngineTask & InTask)
 {
-	if ( HoudiniEngineScheduler )
-		HoudiniEngineScheduler->AddTask(InTask);
+	FHoudiniEngineScheduler* Scheduler = GetSchedulerForTask(InTask);
+	if ( Scheduler )
+		Scheduler->AddTask(InTask);
 
 	FScopeLock ScopeLock(&CriticalSection);
 	FHoudiniEngineTaskInfo TaskInfo;
@@ -843,6 +1027,10 @@ FHoudiniEngine::StartSessions(
 		HOUDINI_LOG_MESSAGE(TEXT("Limiting Number of Sessions to 1 when using Shared Memory."));
 		NumSessions = 1;
 	}
+
+	if (HoudiniEngineManager)
+		HoudiniEngineManager->OnSessionTeardown();
+
 	Sessions.Empty(NumSessions);
 
 	// Create the sessions...
@@ -895,6 +1083,10 @@ FHoudiniEngine::SessionSyncConnect(
 
 	FHoudiniEngine::Get().SetFirstSessionCreated(true);
 
+	// The sessions are about to be reset, make sure no worker thread is still using them
+	if (HoudiniEngineManager)
+		HoudiniEngineManager->OnSessionTeardown();
+
 	// Consider the session failed as long as we dont connect
 	SetSessionStatus(EHoudiniSessionStatus::Failed);
 
@@ -1108,6 +1300,10 @@ FHoudiniEngine::InitializeHAPISession()
 void
 FHoudiniEngine::OnSessionLost()
 {
+	// Make sure no worker thread is still using the session
+	if (HoudiniEngineManager)
+		HoudiniEngineManager->OnSessionTeardown();
+
 	// Mark the session as invalid
 	Sessions.Empty();
 	SetSessionStatus(EHoudiniSessionStatus::Lost);
@@ -1129,6 +1325,10 @@ FHoudiniEngine::StopSession()
 	if (!FHoudiniApi::IsHAPIInitialized())
 		return false;
 
+	// Make sure no worker thread is still using the session
+	if (HoudiniEngineManager)
+		HoudiniEngineManager->OnSessionTeardown();
+
 	// If the current session is valid, clean up and close the session
 	if (HAPI_RESULT_SUCCESS == FHoudiniApi::IsSessionValid(GetSession()))
 	{
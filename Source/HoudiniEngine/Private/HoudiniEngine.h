@@ -184,6 +184,17 @@ class HOUDINIENGINE_API FHoudiniEngine : public IModuleInterface
 		virtual void RemoveTaskInfo(const FGuid& InHapiGUID);
 		// Remove task info.
 		virtual bool RetrieveTaskInfo(const FGuid& InHapiGUID, FHoudiniEngineTaskInfo & OutTaskInfo);
+		// Returns true if instantiation/cook tasks are dispatched to one scheduler worker per session.
+		static bool IsMultiSessionSchedulingEnabled();
+		// Registers an asset instantiated with the given scheduler affinity.
+		void AcquireSchedulerAffinity(const int32& InSchedulerAffinity);
+		// Unregisters an asset from its scheduler affinity, the affinity's worker is forgotten
+		// once it has no asset and no pending task left.
+		void ReleaseSchedulerAffinity(const int32& InSchedulerAffinity);
+		// Returns true if no task of the given scheduler affinity is queued or being processed.
+		bool IsSchedulerAffinityIdle(const int32& InSchedulerAffinity);
+		// Called by the schedulers once they've processed a task.
+		void OnSchedulerTaskProcessed(const FHoudiniEngineTask& InTask);
 		// Register asset to the manager
 		//virtual void AddHoudiniAssetComponent(UHoudiniAssetComponent* HAC);
 
@@ -278,6 +289,18 @@ class HOUDINIENGINE_API FHoudiniEngine : public IModuleInterface
 
 	private:
 
+		// Returns the scheduler that should process the given task, and counts the task as pending for its affinity.
+		// With multi-session scheduling, tasks are assigned to a worker per node tree (see SchedulerAffinity).
+		FHoudiniEngineScheduler* GetSchedulerForTask(const FHoudiniEngineTask& InTask);
+
+		// Creates the additional scheduler workers needed to have one worker per session.
+		// CriticalSection must be locked.
+		void UpdateSessionSchedulers();
+
+		// Stops and destroys all the additional scheduler workers.
+		void DestroySessionSchedulers();
+
+
 		// Singleton instance of Houdini Engine.
 		static FHoudiniEngine * HoudiniEngineInstance;
 
@@ -303,6 +326,23 @@ class HOUDINIENGINE_API FHoudiniEngine : public IModuleInterface
 		// Scheduler used to schedule HAPI instantiation and cook tasks. 
 		FHoudiniEngineScheduler * HoudiniEngineScheduler;
 
+		// Additional schedulers and their threads used for multi-session scheduling.
+		// SessionSchedulers[i] processes its tasks on session i + 1, the main scheduler uses session 0.
+		TArray<FHoudiniEngineScheduler*> SessionSchedulers;
+		TArray<FRunnableThread*> SessionSchedulerThreads;
+
+		// Worker of a scheduler affinity, the number of instantiated assets that use it
+		// and the number of its tasks that are queued or being processed.
+		struct FSchedulerAffinityInfo
+		{
+			int32 WorkerIndex = INDEX_NONE;
+			int32 NumAssets = 0;
+			int32 NumPendingTasks = 0;
+		};
+
+		// Scheduler affinity to worker index (0 being the main scheduler).
+		TMap<int32, FSchedulerAffinityInfo> SchedulerAffinities;
+
 		// Thread used to execute the manager.
 		FRunnableThread * HoudiniEngineManagerThread;
 		// Scheduler used to monitor and process Houdini Asset Components
@@ -29,6 +29,9 @@
 #include <type_traits>
 
 #include "HoudiniEngine.h"
+#include "HoudiniEngineCookStats.h"
+#include "HoudiniEngineSessionPool.h"
+#include "HoudiniOutputPrefetchCache.h"
 #include "HoudiniEngineTimers.h"
 #include "HoudiniEngineUtils.h"
 #include "HoudiniApi.h"
@@ -93,6 +96,11 @@ FHoudiniHapiAccessor::GetInfo(HAPI_AttributeInfo& OutAttributeInfo, const HAPI_A
 
 	FHoudiniApi::AttributeInfo_Init(&OutAttributeInfo);
 
+	// Use the infos read after the cook if this part has been prefetched
+	const FHoudiniOutputPrefetchCache* PrefetchCache = FHoudiniOutputPrefetchCache::GetActive();
+	if (PrefetchCache && PrefetchCache->FindAttributeInfo(NodeId, PartId, AttributeName, InOwner, OutAttributeInfo))
+		return OutAttributeInfo.exists;
+
 	const auto GetInfoLambda =
 		[&](const HAPI_AttributeOwner Owner) -> bool
 	{
@@ -277,21 +285,6 @@ void FHoudiniHapiAccessor::ConvertToRawData(HAPI_StorageType StorageType, FHoudi
 }
 
 
-struct FHoudiniAttributeTask
-{
-	int RawIndex;
-	int Count;
-	const FHoudiniHapiAccessor* Accessor;
-	const HAPI_AttributeInfo * StorageInfo;
-	const HAPI_Session* Session;
-	bool bSuccess;
-
-	static bool CanAbandon() { return false; }
-	static void Abandon() {  }
-	TStatId GetStatId() const { RETURN_QUICK_DECLARE_CYCLE_STAT(FHoudiniAttributeTask, STATGROUP_ThreadPoolAsyncTasks); }
-
-};
-
 int FHoudiniHapiAccessor::CalculateNumberOfSessions(const HAPI_AttributeInfo& AttributeInfo) const
 {
 	// GetStringBatchSize does not seem to function correctly with multisession. Arrays are slower with more than one session.
@@ -341,6 +334,17 @@ int FHoudiniHapiAccessor::CalculateNumberOfTasks(int64 SizeInBytes, int NumSessi
 	{
 		NumTasks = (SizeInBytes + MaxSize - 1) / MaxSize;
 	}
+
+	// When using multiple sessions, split large transfers into a few chunks per session so that
+	// sessions finishing early can pick up the remaining chunks of the slower ones.
+	constexpr int64 ChunksPerSession = 4;
+	constexpr int64 MinChunkSize = 1 * 1024 * 1024;
+	if (NumSessions > 1)
+	{
+		int64 NumBalancedTasks = FMath::Min(NumSessions * ChunksPerSession, SizeInBytes / MinChunkSize);
+		NumTasks = FMath::Max(NumTasks, NumBalancedTasks);
+	}
+
 	return static_cast<int>(NumTasks);
 }
 
@@ -363,6 +367,8 @@ template<typename DataType> bool FHoudiniHapiAccessor::GetAttributeDataViaSessio
 
 		ConvertFromRawData(RawData, Results, IndexCount * AttributeInfo.tupleSize);
 	}
+
+	FHoudiniEngineCookStats::AddDataFetch(Session->id, GetHapiSize(GetTypeWithoutArray(AttributeInfo.storage)) * AttributeInfo.tupleSize * IndexCount);
 	return true;
 }
 
@@ -424,155 +430,112 @@ template<typename DataType> bool FHoudiniHapiAccessor::GetAttributeData(const HA
 		TotalCount = IndexCount * AttributeInfo.tupleSize;
 	}
 
-	Results.SetNum(TotalCount);
+	// The data is fully overwritten, no need to initialize it
+	if constexpr (std::is_arithmetic_v<DataType>)
+		Results.SetNumUninitialized(TotalCount);
+	else
+		Results.SetNum(TotalCount);
 
 	return GetAttributeData(AttributeInfo, Results.GetData(), IndexStart, IndexCount);
 }
 
-template<typename DataType>
-bool FHoudiniHapiAccessor::GetAttributeData(const HAPI_AttributeInfo& AttributeInfo, DataType* Results, int IndexStart, int IndexCount)
+template<typename DataType> bool FHoudiniHapiAccessor::GetAttributeDataView(HAPI_AttributeOwner Owner, TArray<DataType>& OutStorage, TArrayView<const DataType>& OutView)
 {
-	return GetAttributeDataMultiSession(AttributeInfo, Results, IndexStart, IndexCount);
-}
+	HAPI_AttributeInfo AttrInfo;
+	if (!GetInfo(AttrInfo, Owner))
+		return false;
 
+	return GetAttributeDataView(AttrInfo, OutStorage, OutView);
+}
 
-template<typename TaskType>
-bool FHoudiniHapiAccessor::ExecuteTasksWithSessions(TArray<TaskType> & Tasks, int NumSessions)
+template<typename DataType> bool FHoudiniHapiAccessor::GetAttributeDataView(const HAPI_AttributeInfo& AttributeInfo, TArray<DataType>& OutStorage, TArrayView<const DataType>& OutView)
 {
-	// Create a pool of all available sessions.
-	TArray<const HAPI_Session*> AvailableSessions;
-	TSet< TaskType* > ActiveTasks;
-
-	for (int Session = 0; Session < NumSessions; Session++)
-	{
-		const HAPI_Session* SessionToAdd = FHoudiniEngine::Get().GetSession(Session);
-		AvailableSessions.Add(SessionToAdd);
-	}
+	OutView = TArrayView<const DataType>();
 
-	// No sessions.
-	if (AvailableSessions.IsEmpty())
+	if (!AttributeInfo.exists)
 		return false;
 
-	for (int NextTaskToSTart = 0; NextTaskToSTart < Tasks.Num(); NextTaskToSTart++)
+	if constexpr (std::is_arithmetic_v<DataType>)
 	{
-		// Allocate sessions to tasks. We cannot assign a session to multiple tasks at the same
-		// time or there will be conflicts. So grab a free session from the pool
-
-		auto& Task = Tasks[NextTaskToSTart];
-
-		if (AvailableSessions.IsEmpty())
-		{
-			// This should never happen.
-			HOUDINI_LOG_ERROR(TEXT("Internal Error. No Available Houdini Sessions"));
-			return false;
-		}
-		else
-		{
-			Task.GetTask().Session = AvailableSessions.Pop();
-		}
-
-		Task.StartBackgroundTask();
-		ActiveTasks.Add(&Task);
-
-		if (AvailableSessions.IsEmpty())
+		// Point directly to the prefetched data if it was read with the requested type
+		const FHoudiniOutputPrefetchCache* PrefetchCache = FHoudiniOutputPrefetchCache::GetActive();
+		const uint8* PrefetchedData = PrefetchCache ? PrefetchCache->FindAttributeData(
+			NodeId, PartId, AttributeName, AttributeInfo, GetHapiType<DataType>(), sizeof(DataType)) : nullptr;
+		if (PrefetchedData && !IsHapiArrayType(AttributeInfo.storage))
 		{
-			// We have to wait for a free session.
-			bool bFreedSessions = false;
-			while (!bFreedSessions)
-			{
-				for (auto It : ActiveTasks)
-				{
-					auto& ActiveTask = It;
-					if (ActiveTask->IsDone())
-					{
-						ActiveTasks.Remove(ActiveTask);
-						AvailableSessions.Add(ActiveTask->GetTask().Session);
-						bFreedSessions = true;
-						break;
-
-					}
-				}
-			}
+			OutView = TArrayView<const DataType>(reinterpret_cast<const DataType*>(PrefetchedData), AttributeInfo.count * AttributeInfo.tupleSize);
+			return true;
 		}
 	}
 
-	// Wait for completion of all tasks
-	bool bSuccess = true;
-	for (int Task = 0; Task < Tasks.Num(); Task++)
-	{
-		Tasks[Task].EnsureCompletion();
-		bSuccess &= Tasks[Task].GetTask().bSuccess;
-	}
-	return bSuccess;
+	if (!GetAttributeData(AttributeInfo, OutStorage))
+		return false;
+
+	OutView = OutStorage;
+	return true;
 }
 
-struct FHoudiniHeightFieldGetTask : public  FHoudiniAttributeTask
+template<typename DataType>
+bool FHoudiniHapiAccessor::GetAttributeData(const HAPI_AttributeInfo& AttributeInfo, DataType* Results, int IndexStart, int IndexCount)
 {
-	float* Results;
-
-	void DoWork()
+	if constexpr (std::is_arithmetic_v<DataType>)
 	{
-		bSuccess = Accessor->GetHeightFieldDataViaSession(Session, *StorageInfo, Results, RawIndex, Count);
+		// Copy the data from the prefetch cache if it was read with the requested type
+		const FHoudiniOutputPrefetchCache* PrefetchCache = FHoudiniOutputPrefetchCache::GetActive();
+		if (PrefetchCache && PrefetchCache->GetAttributeData(
+			NodeId, PartId, AttributeName, AttributeInfo, GetHapiType<DataType>(), sizeof(DataType), Results, IndexStart, IndexCount))
+			return true;
 	}
-};
+
+	return GetAttributeDataMultiSession(AttributeInfo, Results, IndexStart, IndexCount);
+}
+
 
 bool FHoudiniHapiAccessor::GetHeightFieldDataViaSession(const HAPI_Session* Session, const HAPI_AttributeInfo& AttributeInfo, float* Results, int IndexStart, int IndexCount) const
 {
 	HAPI_Result Result = FHoudiniApi::GetHeightFieldData(Session, NodeId, PartId, Results, IndexStart, IndexCount);
-	return Result == HAPI_Result::HAPI_RESULT_SUCCESS;
+	if (Result != HAPI_Result::HAPI_RESULT_SUCCESS)
+		return false;
+
+	FHoudiniEngineCookStats::AddDataFetch(Session->id, static_cast<int64>(IndexCount) * sizeof(float));
+	return true;
 }
 
 bool FHoudiniHapiAccessor::GetHeightFieldData(TArray<float>& Results, int IndexCount)
 {
 	H_SCOPED_FUNCTION_TIMER();
+	H_SCOPED_COOK_STAT(EHoudiniCookStage::DataFetch);
+
+	Results.SetNumUninitialized(IndexCount);
 
 	int64 TotalSize = Results.Num() * sizeof(Results[0]);
-	int64 NumSessions = bAllowMultiThreading ? FHoudiniEngine::Get().GetNumSessions() : 1;
+	int NumSessions = bAllowMultiThreading ? FHoudiniEngine::Get().GetNumSessions() : 1;
 	int NumTasks = CalculateNumberOfTasks(TotalSize, NumSessions);
-	// Task array.
-	TArray<FAsyncTask<FHoudiniHeightFieldGetTask>> Tasks;
-	Tasks.SetNum(NumTasks);
-
-	Results.SetNumUninitialized(IndexCount);
 
-	for(int64 TaskId = 0; TaskId < NumTasks; TaskId++)
-	{
-		// Fill a task, one per session.
-		FHoudiniHeightFieldGetTask& Task = Tasks[TaskId].GetTask();
+	HAPI_AttributeInfo AttributeInfo;
+	FHoudiniApi::AttributeInfo_Init(&AttributeInfo);
 
-		int StartOffset = static_cast<int>(IndexCount * TaskId / NumTasks);
-		int EndOffset = static_cast<int>(IndexCount * (TaskId + 1) / NumTasks);
-		Task.Accessor = this;
-		Task.RawIndex = StartOffset;
-		Task.Results = Results.GetData() + StartOffset;
-		Task.Count = EndOffset - StartOffset;
-		Task.Session = nullptr;
-	}
+	bool bSuccess = FHoudiniEngineSessionPool::ExecuteChunks(NumTasks, NumSessions, TotalSize,
+		[&](const HAPI_Session* Session, int32 TaskId)
+		{
+			int StartOffset = static_cast<int>(static_cast<int64>(IndexCount) * TaskId / NumTasks);
+			int EndOffset = static_cast<int>(static_cast<int64>(IndexCount) * (TaskId + 1) / NumTasks);
+			return GetHeightFieldDataViaSession(Session, AttributeInfo, Results.GetData() + StartOffset, StartOffset, EndOffset - StartOffset);
+		});
 
-	bool bSuccess = ExecuteTasksWithSessions(Tasks, NumSessions);
 	if (!bSuccess)
 		Results.Empty();
 
 	return bSuccess;
 }
 
-template<typename DataType>
-struct FHoudiniAttributeGetTask : public  FHoudiniAttributeTask
-{
-	DataType* Results;
-
-	void DoWork()
-	{
-		bSuccess = Accessor->GetAttributeDataViaSession(Session, *StorageInfo, Results, RawIndex, Count);
-	}
-};
-
 template<typename DataType>
 bool FHoudiniHapiAccessor::GetAttributeDataMultiSession(const HAPI_AttributeInfo& AttributeInfo, DataType * Results, int IndexStart, int IndexCount)
 {
 	// This is the actual main function for getting data.
 
 	H_SCOPED_FUNCTION_DYNAMIC_LABEL(FString::Printf(TEXT("FHoudiniAttributeAccessor::GetAttributeDataMultiSession (%s)"), ANSI_TO_TCHAR(AttributeName)));
+	H_SCOPED_COOK_STAT(EHoudiniCookStage::DataFetch);
 
 	if (!AttributeInfo.exists)
 		return false;
@@ -582,42 +545,21 @@ bool FHoudiniHapiAccessor::GetAttributeDataMultiSession(const HAPI_AttributeInfo
 
 	int NumTasks = CalculateNumberOfTasks(AttributeInfo);
 	int NumSessions = CalculateNumberOfSessions(AttributeInfo);
-	// Task array.
-	TArray<FAsyncTask<FHoudiniAttributeGetTask<DataType>>> Tasks;
-	Tasks.SetNum(NumTasks);
-
-	for(int TaskId = 0; TaskId < NumTasks; TaskId++)
-	{
-		// Fill a task, one per session.
-		FHoudiniAttributeGetTask<DataType> & Task = Tasks[TaskId].GetTask();
-
-		int StartOffset = IndexCount * TaskId / NumTasks;
-		int EndOffset = IndexCount * (TaskId + 1) / NumTasks;
-		Task.Accessor = this;
-		Task.StorageInfo = &AttributeInfo;
-		Task.RawIndex = StartOffset + IndexStart;
-		Task.Results = Results + StartOffset * AttributeInfo.tupleSize;
-		Task.Count = EndOffset - StartOffset;
-		Task.Session = nullptr;
-	}
+	int64 TotalSize = GetHapiSize(AttributeInfo.storage) * AttributeInfo.tupleSize * IndexCount;
 
-	bool bSuccess = ExecuteTasksWithSessions(Tasks, NumSessions);
+	// Chunks are pulled by each session until none are left.
+	bool bSuccess = FHoudiniEngineSessionPool::ExecuteChunks(NumTasks, NumSessions, TotalSize,
+		[&](const HAPI_Session* Session, int32 TaskId)
+		{
+			int StartOffset = static_cast<int>(static_cast<int64>(IndexCount) * TaskId / NumTasks);
+			int EndOffset = static_cast<int>(static_cast<int64>(IndexCount) * (TaskId + 1) / NumTasks);
+			return GetAttributeDataViaSession(
+				Session, AttributeInfo, Results + StartOffset * AttributeInfo.tupleSize, StartOffset + IndexStart, EndOffset - StartOffset);
+		});
 
 	return bSuccess;
 }
 
-template<typename DataType>
-struct FHoudiniAttributeSetTask : public  FHoudiniAttributeTask
-{
-	const DataType* Input;
-
-	void DoWork()
-	{
-		bSuccess = Accessor->SetAttributeDataViaSession(Session, *StorageInfo, Input, RawIndex, Count);
-	}
-
-};
-
 template<typename DataType>
 bool FHoudiniHapiAccessor::SetAttributeData(const HAPI_AttributeInfo& AttributeInfo, const TArray<DataType>& Data)
 {
@@ -640,27 +582,17 @@ bool FHoudiniHapiAccessor::SetAttributeDataMultiSession(const HAPI_AttributeInfo
 
 	int NumTasks = CalculateNumberOfTasks(AttributeInfo);
 	int NumSessions = CalculateNumberOfSessions(AttributeInfo);
+	int64 TotalSize = GetHapiSize(AttributeInfo.storage) * AttributeInfo.tupleSize * IndexCount;
 
-	// Task array.
-	TArray<FAsyncTask<FHoudiniAttributeSetTask<DataType>>> Tasks;
-	Tasks.SetNum(NumTasks);
-
-	for (int TaskId = 0; TaskId < NumTasks; TaskId++)
-	{
-		// Fill a task, one per session.
-		FHoudiniAttributeSetTask<DataType>& Task = Tasks[TaskId].GetTask();
-
-		int StartOffset = IndexCount * TaskId / NumTasks;
-		int EndOffset = IndexCount * (TaskId + 1) / NumTasks;
-		Task.Accessor = this;
-		Task.StorageInfo = &AttributeInfo;
-		Task.RawIndex = StartOffset + IndexStart;
-		Task.Input = Data + StartOffset * AttributeInfo.tupleSize;
-		Task.Count = EndOffset - StartOffset;
-		Task.Session = nullptr;
-	}
-
-	bool bSuccess = ExecuteTasksWithSessions(Tasks, NumSessions);
+	// Chunks are pulled by each session until none are left.
+	bool bSuccess = FHoudiniEngineSessionPool::ExecuteChunks(NumTasks, NumSessions, TotalSize,
+		[&](const HAPI_Session* Session, int32 TaskId)
+		{
+			int StartOffset = static_cast<int>(static_cast<int64>(IndexCount) * TaskId / NumTasks);
+			int EndOffset = static_cast<int>(static_cast<int64>(IndexCount) * (TaskId + 1) / NumTasks);
+			return SetAttributeDataViaSession(
+				Session, AttributeInfo, Data + StartOffset * AttributeInfo.tupleSize, StartOffset + IndexStart, EndOffset - StartOffset);
+		});
 
 	return bSuccess;
 }
@@ -807,7 +739,7 @@ bool FHoudiniHapiAccessor::SetAttributeDataViaSession(const HAPI_Session* Sessio
 	if (StorageType == AttributeInfo.storage)
 	{
 		// No conversion is necessary so send the data directly.
-		SendHapiData(Session, AttributeInfo, Data, StartIndex, IndexCount);
+		HOUDINI_CHECK_ERROR_RETURN(SendHapiData(Session, AttributeInfo, Data, StartIndex, IndexCount), false);
 	}
 	else
 	{
@@ -1139,7 +1071,7 @@ template<> bool FHoudiniHapiAccessor::GetAttributeData(HAPI_AttributeOwner Owner
 		HOUDINI_LOG_ERROR(TEXT("Tried to get a Vector3f, but tuple size is not 3"));
 		return false;
 	}
-	Results.SetNum(AttrInfo.count);
+	Results.SetNumUninitialized(AttrInfo.count);
 
 	return GetAttributeData(AttrInfo, (float *)Results.GetData(), IndexStart, IndexCount);
 }
@@ -1517,6 +1449,8 @@ TArray<FString> FHoudiniHapiAccessor::GetAttributeNames(HAPI_AttributeOwner Owne
 	template bool FHoudiniHapiAccessor::GetAttributeData(HAPI_AttributeOwner Owner, int TupleSize, TArray<DATA_TYPE>& Results, int IndexStart, int IndexCount);\
 	template bool FHoudiniHapiAccessor::GetAttributeData(HAPI_AttributeOwner Owner, int TupleSize, DATA_TYPE * Results, int IndexStart, int IndexCount);\
 	template bool FHoudiniHapiAccessor::GetAttributeData(const HAPI_AttributeInfo& AttributeInfo, TArray<DATA_TYPE>& Results, int IndexStart , int IndexCount);\
+	template bool FHoudiniHapiAccessor::GetAttributeDataView(HAPI_AttributeOwner Owner, TArray<DATA_TYPE>& OutStorage, TArrayView<const DATA_TYPE>& OutView);\
+	template bool FHoudiniHapiAccessor::GetAttributeDataView(const HAPI_AttributeInfo& AttributeInfo, TArray<DATA_TYPE>& OutStorage, TArrayView<const DATA_TYPE>& OutView);\
 	template bool FHoudiniHapiAccessor::SetAttributeData(const HAPI_AttributeInfo& AttributeInfo, const DATA_TYPE* Data, int IndexStart, int IndexCount) const;\
 	template bool FHoudiniHapiAccessor::SetAttributeDataViaSession(const HAPI_Session* Session, const HAPI_AttributeInfo& AttributeInfo, const DATA_TYPE* Data, int IndexStart, int IndexCount) const;\
 	template bool FHoudiniHapiAccessor::SetAttributeData(const HAPI_AttributeInfo& AttributeInfo, const TArray<DATA_TYPE>& Data);\
@@ -79,6 +79,13 @@ struct FHoudiniHapiAccessor
 	template<typename DataType> bool GetAttributeData(const HAPI_AttributeInfo& AttributeInfo, DataType* Results, int IndexStart, int IndexCount);
 	template<typename DataType> bool GetAttributeDataViaSession(const HAPI_Session* Session, const HAPI_AttributeInfo& AttributeInfo, DataType* Results, int IndexStart, int IndexCount) const;
 
+	// Read-only access to an attribute's data, avoiding copies when possible.
+	// If the data was prefetched after the cook with the requested type, the view points directly to it.
+	// Otherwise, the data is read into OutStorage, without any intermediate buffer if the type matches the attribute's storage.
+	// The view must not be kept: it's only valid while OutStorage is alive and the output processing hasn't finished.
+	template<typename DataType> bool GetAttributeDataView(HAPI_AttributeOwner Owner, TArray<DataType>& OutStorage, TArrayView<const DataType>& OutView);
+	template<typename DataType> bool GetAttributeDataView(const HAPI_AttributeInfo& AttributeInfo, TArray<DataType>& OutStorage, TArrayView<const DataType>& OutView);
+
 	bool GetAttributeStrings(HAPI_AttributeOwner Owner, FHoudiniEngineIndexedStringMap& StringMap, int IndexStart = 0, int IndexCount = -1);
 	bool GetAttributeStrings(const HAPI_AttributeInfo& AttributeInfo, FHoudiniEngineIndexedStringMap& StringMap, int IndexStart = 0, int IndexCount = -1);
 
@@ -140,10 +147,6 @@ protected:
 	static bool IsHapiArrayType(HAPI_StorageType);
 	static HAPI_StorageType GetTypeWithoutArray(HAPI_StorageType StorageType);
 
-
-	template<typename TaskType>
-	static bool ExecuteTasksWithSessions(TArray<TaskType>& Tasks, int NumSessions);
-
 	template<typename DataType>
 	HAPI_Result SendHapiDataRunLengthEncoded(const HAPI_Session* Session, const HAPI_AttributeInfo& AttributeInfo, const DataType* Data, int StartIndex, int IndexCount) const;
 
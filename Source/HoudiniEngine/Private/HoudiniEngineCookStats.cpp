@@ -0,0 +1,506 @@
+/*
+* Copyright (c) <2024> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniEngineCookStats.h"
+
+#include "HoudiniEnginePrivatePCH.h"
+#include "HoudiniEngineUtils.h"
+
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+// Number of cook records kept per asset
+static constexpr int32 HoudiniCookStatsMaxRecentCooks = 32;
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineCookStats(
+	TEXT("HoudiniEngine.CookStats"),
+	1,
+	TEXT("When enabled, the time spent in each stage of a Houdini Asset's cook and the amount of data read from the sessions are recorded per asset.\n")
+	TEXT("0: Disabled\n")
+	TEXT("1: Enabled\n")
+);
+
+static FAutoConsoleCommand CCmdHoudiniCookStatsPrint(
+	TEXT("HoudiniEngine.CookStats.Print"),
+	TEXT("Prints the cook stats of every Houdini Asset Component."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FHoudiniEngineCookStats::LogStats();
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniCookStatsReset(
+	TEXT("HoudiniEngine.CookStats.Reset"),
+	TEXT("Clears the cook stats of every Houdini Asset Component."),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		FHoudiniEngineCookStats::Reset();
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniCookStatsDump(
+	TEXT("HoudiniEngine.CookStats.Dump"),
+	TEXT("Writes the cook stats to a JSON file. Takes an optional file path, defaults to Saved/HoudiniEngine/CookStats-<date>.json."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FString FilePath = Args.Num() > 0 ? Args[0] : FString();
+		if (FilePath.IsEmpty())
+		{
+			FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("HoudiniEngine"),
+				FString::Printf(TEXT("CookStats-%s.json"), *FDateTime::Now().ToString()));
+		}
+
+		if (FHoudiniEngineCookStats::DumpToFile(FilePath))
+			HOUDINI_LOG_MESSAGE(TEXT("Cook Stats: written to %s"), *FilePath);
+		else
+			HOUDINI_LOG_ERROR(TEXT("Cook Stats: failed to write %s"), *FilePath);
+	}));
+
+static FAutoConsoleCommand CCmdHoudiniCookStatsDiff(
+	TEXT("HoudiniEngine.CookStats.Diff"),
+	TEXT("Compares two JSON dumps of the cook stats: HoudiniEngine.CookStats.Diff <Before.json> <After.json>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() < 2)
+		{
+			HOUDINI_LOG_ERROR(TEXT("Cook Stats: HoudiniEngine.CookStats.Diff expects two file paths."));
+			return;
+		}
+
+		FHoudiniEngineCookStats::LogDiff(Args[0], Args[1]);
+	}));
+
+FCriticalSection FHoudiniEngineCookStats::Lock;
+TMap<FString, FHoudiniAssetCookStats> FHoudiniEngineCookStats::Assets;
+FString FHoudiniEngineCookStats::CurrentAsset;
+
+static thread_local FHoudiniCookStageScope* HoudiniCurrentCookStageScope = nullptr;
+
+void
+FHoudiniCookRecord::Add(const FHoudiniCookRecord& InOther)
+{
+	for (int32 StageIndex = 0; StageIndex < (int32)EHoudiniCookStage::Num; StageIndex++)
+		StageSeconds[StageIndex] += InOther.StageSeconds[StageIndex];
+
+	for (const auto& Pair : InOther.SessionFetches)
+	{
+		FHoudiniCookFetchStats& Fetch = SessionFetches.FindOrAdd(Pair.Key);
+		Fetch.NumBytes += Pair.Value.NumBytes;
+		Fetch.NumCalls += Pair.Value.NumCalls;
+	}
+}
+
+double
+FHoudiniCookRecord::GetTotalSeconds() const
+{
+	double Seconds = 0.0;
+	for (int32 StageIndex = 0; StageIndex < (int32)EHoudiniCookStage::Num; StageIndex++)
+		Seconds += StageSeconds[StageIndex];
+
+	return Seconds;
+}
+
+FHoudiniCookFetchStats
+FHoudiniCookRecord::GetTotalFetch() const
+{
+	FHoudiniCookFetchStats Total;
+	for (const auto& Pair : SessionFetches)
+	{
+		Total.NumBytes += Pair.Value.NumBytes;
+		Total.NumCalls += Pair.Value.NumCalls;
+	}
+
+	return Total;
+}
+
+bool
+FHoudiniEngineCookStats::IsEnabled()
+{
+	return CVarHoudiniEngineCookStats.GetValueOnAnyThread() != 0;
+}
+
+const TCHAR*
+FHoudiniEngineCookStats::GetStageName(const EHoudiniCookStage& InStage)
+{
+	switch (InStage)
+	{
+		case EHoudiniCookStage::InputUpload:	return TEXT("InputUpload");
+		case EHoudiniCookStage::HapiCook:		return TEXT("HapiCook");
+		case EHoudiniCookStage::DataFetch:		return TEXT("DataFetch");
+		case EHoudiniCookStage::MeshBuild:		return TEXT("MeshBuild");
+		case EHoudiniCookStage::Materials:		return TEXT("Materials");
+		case EHoudiniCookStage::Components:		return TEXT("Components");
+		default:
+			break;
+	}
+
+	return TEXT("Unknown");
+}
+
+FHoudiniCookRecord*
+FHoudiniEngineCookStats::GetCurrentRecord_Locked(const FString& InAssetId)
+{
+	if (InAssetId.IsEmpty())
+		return nullptr;
+
+	// Output updates can happen without a cook, start a record if needed
+	FHoudiniAssetCookStats& AssetStats = Assets.FindOrAdd(InAssetId);
+	if (AssetStats.RecentCooks.Num() <= 0)
+	{
+		AssetStats.NumCooks++;
+		AssetStats.RecentCooks.AddDefaulted_GetRef().StartTime = FDateTime::Now();
+	}
+
+	return &AssetStats.RecentCooks.Last();
+}
+
+void
+FHoudiniEngineCookStats::BeginCook(const FString& InAssetId, const FString& InLabel)
+{
+	if (!IsEnabled() || InAssetId.IsEmpty())
+		return;
+
+	FScopeLock ScopeLock(&Lock);
+	FHoudiniAssetCookStats& AssetStats = Assets.FindOrAdd(InAssetId);
+	AssetStats.Label = InLabel;
+	if (AssetStats.RecentCooks.Num() >= HoudiniCookStatsMaxRecentCooks)
+		AssetStats.RecentCooks.RemoveAt(0, AssetStats.RecentCooks.Num() - HoudiniCookStatsMaxRecentCooks + 1);
+
+	AssetStats.NumCooks++;
+	AssetStats.RecentCooks.AddDefaulted_GetRef().StartTime = FDateTime::Now();
+	AssetStats.HapiCookStartTime = -1.0;
+}
+
+void
+FHoudiniEngineCookStats::BeginHapiCook(const FString& InAssetId)
+{
+	if (!IsEnabled() || InAssetId.IsEmpty())
+		return;
+
+	FScopeLock ScopeLock(&Lock);
+	Assets.FindOrAdd(InAssetId).HapiCookStartTime = FPlatformTime::Seconds();
+}
+
+void
+FHoudiniEngineCookStats::EndHapiCook(const FString& InAssetId)
+{
+	FScopeLock ScopeLock(&Lock);
+	FHoudiniAssetCookStats* AssetStats = Assets.Find(InAssetId);
+	if (!AssetStats || AssetStats->HapiCookStartTime < 0.0)
+		return;
+
+	const double Seconds = FPlatformTime::Seconds() - AssetStats->HapiCookStartTime;
+	AssetStats->HapiCookStartTime = -1.0;
+
+	FHoudiniCookRecord* Record = GetCurrentRecord_Locked(InAssetId);
+	Record->StageSeconds[(int32)EHoudiniCookStage::HapiCook] += Seconds;
+	AssetStats->Totals.StageSeconds[(int32)EHoudiniCookStage::HapiCook] += Seconds;
+}
+
+void
+FHoudiniEngineCookStats::AddStageTime(const EHoudiniCookStage& InStage, const double& InSeconds)
+{
+	FScopeLock ScopeLock(&Lock);
+	FHoudiniCookRecord* Record = GetCurrentRecord_Locked(CurrentAsset);
+	if (!Record)
+		return;
+
+	Record->StageSeconds[(int32)InStage] += InSeconds;
+	Assets.FindChecked(CurrentAsset).Totals.StageSeconds[(int32)InStage] += InSeconds;
+}
+
+void
+FHoudiniEngineCookStats::AddDataFetch(const int64& InSessionId, const int64& InNumBytes)
+{
+	if (!IsEnabled())
+		return;
+
+	FScopeLock ScopeLock(&Lock);
+	if (!CurrentAsset.IsEmpty())
+		AddDataFetch(CurrentAsset, InSessionId, InNumBytes);
+}
+
+void
+FHoudiniEngineCookStats::AddDataFetch(const FString& InAssetId, const int64& InSessionId, const int64& InNumBytes)
+{
+	if (!IsEnabled() || InAssetId.IsEmpty())
+		return;
+
+	FScopeLock ScopeLock(&Lock);
+	FHoudiniCookRecord* Record = GetCurrentRecord_Locked(InAssetId);
+	FHoudiniCookFetchStats& RecordFetch = Record->SessionFetches.FindOrAdd(InSessionId);
+	RecordFetch.NumBytes += InNumBytes;
+	RecordFetch.NumCalls++;
+
+	FHoudiniCookFetchStats& TotalFetch = Assets.FindChecked(InAssetId).Totals.SessionFetches.FindOrAdd(InSessionId);
+	TotalFetch.NumBytes += InNumBytes;
+	TotalFetch.NumCalls++;
+}
+
+FString
+FHoudiniEngineCookStats::SetCurrentAsset(const FString& InAssetId)
+{
+	check(IsInGameThread());
+
+	FScopeLock ScopeLock(&Lock);
+	FString PreviousAsset = MoveTemp(CurrentAsset);
+	CurrentAsset = IsEnabled() ? InAssetId : FString();
+	return PreviousAsset;
+}
+
+void
+FHoudiniEngineCookStats::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Assets.Empty();
+}
+
+void
+FHoudiniEngineCookStats::LogStats()
+{
+	FScopeLock ScopeLock(&Lock);
+	if (Assets.Num() <= 0)
+	{
+		HOUDINI_LOG_MESSAGE(TEXT("Cook Stats: no cook recorded."));
+		return;
+	}
+
+	TArray<FString> AssetIds;
+	Assets.GetKeys(AssetIds);
+	AssetIds.Sort();
+
+	for (const FString& AssetId : AssetIds)
+	{
+		const FHoudiniAssetCookStats& AssetStats = Assets[AssetId];
+		const FHoudiniCookRecord& Last = AssetStats.RecentCooks.Last();
+		const double NumCooks = FMath::Max(AssetStats.NumCooks, 1);
+
+		HOUDINI_LOG_MESSAGE(TEXT("Cook Stats: %s (%s) - %d cooks, last cook %.3fs, average %.3fs"),
+			*AssetStats.Label, *AssetId, AssetStats.NumCooks, Last.GetTotalSeconds(), AssetStats.Totals.GetTotalSeconds() / NumCooks);
+
+		for (int32 StageIndex = 0; StageIndex < (int32)EHoudiniCookStage::Num; StageIndex++)
+		{
+			HOUDINI_LOG_MESSAGE(TEXT("    %-12s last %8.3fs   average %8.3fs"),
+				GetStageName((EHoudiniCookStage)StageIndex),
+				Last.StageSeconds[StageIndex], AssetStats.Totals.StageSeconds[StageIndex] / NumCooks);
+		}
+
+		for (const auto& Pair : Last.SessionFetches)
+		{
+			HOUDINI_LOG_MESSAGE(TEXT("    session %lld: last cook read %.2f MB in %lld calls"),
+				Pair.Key, static_cast<double>(Pair.Value.NumBytes) / (1024.0 * 1024.0), Pair.Value.NumCalls);
+		}
+	}
+}
+
+static TSharedPtr<FJsonObject>
+HoudiniCookRecordToJson(const FHoudiniCookRecord& InRecord)
+{
+	TSharedPtr<FJsonObject> RecordObject = MakeShared<FJsonObject>();
+	RecordObject->SetStringField(TEXT("start"), InRecord.StartTime.ToIso8601());
+	RecordObject->SetNumberField(TEXT("total_seconds"), InRecord.GetTotalSeconds());
+
+	TSharedPtr<FJsonObject> StagesObject = MakeShared<FJsonObject>();
+	for (int32 StageIndex = 0; StageIndex < (int32)EHoudiniCookStage::Num; StageIndex++)
+		StagesObject->SetNumberField(FHoudiniEngineCookStats::GetStageName((EHoudiniCookStage)StageIndex), InRecord.StageSeconds[StageIndex]);
+	RecordObject->SetObjectField(TEXT("stages"), StagesObject);
+
+	const FHoudiniCookFetchStats TotalFetch = InRecord.GetTotalFetch();
+	RecordObject->SetNumberField(TEXT("fetch_bytes"), static_cast<double>(TotalFetch.NumBytes));
+	RecordObject->SetNumberField(TEXT("fetch_calls"), static_cast<double>(TotalFetch.NumCalls));
+
+	TSharedPtr<FJsonObject> SessionsObject = MakeShared<FJsonObject>();
+	for (const auto& Pair : InRecord.SessionFetches)
+	{
+		TSharedPtr<FJsonObject> SessionObject = MakeShared<FJsonObject>();
+		SessionObject->SetNumberField(TEXT("bytes"), static_cast<double>(Pair.Value.NumBytes));
+		SessionObject->SetNumberField(TEXT("calls"), static_cast<double>(Pair.Value.NumCalls));
+		SessionsObject->SetObjectField(LexToString(Pair.Key), SessionObject);
+	}
+	RecordObject->SetObjectField(TEXT("sessions"), SessionsObject);
+
+	return RecordObject;
+}
+
+TSharedPtr<FJsonObject>
+FHoudiniEngineCookStats::ToJson()
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TSharedPtr<FJsonObject> AssetsObject = MakeShared<FJsonObject>();
+	for (const auto& Pair : Assets)
+	{
+		TSharedPtr<FJsonObject> AssetObject = MakeShared<FJsonObject>();
+		AssetObject->SetStringField(TEXT("label"), Pair.Value.Label);
+		AssetObject->SetNumberField(TEXT("num_cooks"), Pair.Value.NumCooks);
+		AssetObject->SetObjectField(TEXT("totals"), HoudiniCookRecordToJson(Pair.Value.Totals));
+
+		TArray<TSharedPtr<FJsonValue>> RecentValues;
+		for (const FHoudiniCookRecord& Record : Pair.Value.RecentCooks)
+			RecentValues.Add(MakeShared<FJsonValueObject>(HoudiniCookRecordToJson(Record)));
+		AssetObject->SetArrayField(TEXT("recent"), RecentValues);
+
+		AssetsObject->SetObjectField(Pair.Key, AssetObject);
+	}
+
+	TSharedPtr<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetNumberField(TEXT("version"), 2);
+	RootObject->SetStringField(TEXT("date"), FDateTime::Now().ToIso8601());
+	RootObject->SetObjectField(TEXT("assets"), AssetsObject);
+
+	return RootObject;
+}
+
+bool
+FHoudiniEngineCookStats::DumpToFile(const FString& InFilePath)
+{
+	const FString JSONString = FHoudiniEngineUtils::JSONToString(ToJson());
+	return FFileHelper::SaveStringToFile(JSONString, *InFilePath);
+}
+
+// Per-cook averages of an asset in a JSON dump
+struct FHoudiniCookStatsAverages
+{
+	FString Label;
+	double StageSeconds[(int32)EHoudiniCookStage::Num] = {};
+	double FetchBytes = 0.0;
+	double FetchCalls = 0.0;
+};
+
+static bool
+HoudiniLoadCookStatsAverages(const FString& InFilePath, TMap<FString, FHoudiniCookStatsAverages>& OutAverages)
+{
+	FString JSONString;
+	TSharedPtr<FJsonObject> RootObject;
+	if (!FFileHelper::LoadFileToString(JSONString, *InFilePath) || !FHoudiniEngineUtils::JSONFromString(JSONString, RootObject))
+	{
+		HOUDINI_LOG_ERROR(TEXT("Cook Stats: could not read %s"), *InFilePath);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* AssetsObject = nullptr;
+	if (!RootObject->TryGetObjectField(TEXT("assets"), AssetsObject))
+		return false;
+
+	for (const auto& Pair : (*AssetsObject)->Values)
+	{
+		const TSharedPtr<FJsonObject>* AssetObject = nullptr;
+		const TSharedPtr<FJsonObject>* TotalsObject = nullptr;
+		if (!Pair.Value->TryGetObject(AssetObject) || !(*AssetObject)->TryGetObjectField(TEXT("totals"), TotalsObject))
+			continue;
+
+		const double NumCooks = FMath::Max((*AssetObject)->GetNumberField(TEXT("num_cooks")), 1.0);
+
+		FHoudiniCookStatsAverages& Averages = OutAverages.Add(Pair.Key);
+		(*AssetObject)->TryGetStringField(TEXT("label"), Averages.Label);
+		const TSharedPtr<FJsonObject>* StagesObject = nullptr;
+		if ((*TotalsObject)->TryGetObjectField(TEXT("stages"), StagesObject))
+		{
+			for (int32 StageIndex = 0; StageIndex < (int32)EHoudiniCookStage::Num; StageIndex++)
+			{
+				double Seconds = 0.0;
+				(*StagesObject)->TryGetNumberField(FHoudiniEngineCookStats::GetStageName((EHoudiniCookStage)StageIndex), Seconds);
+				Averages.StageSeconds[StageIndex] = Seconds / NumCooks;
+			}
+		}
+
+		(*TotalsObject)->TryGetNumberField(TEXT("fetch_bytes"), Averages.FetchBytes);
+		(*TotalsObject)->TryGetNumberField(TEXT("fetch_calls"), Averages.FetchCalls);
+		Averages.FetchBytes /= NumCooks;
+		Averages.FetchCalls /= NumCooks;
+	}
+
+	return true;
+}
+
+bool
+FHoudiniEngineCookStats::LogDiff(const FString& InFilePathA, const FString& InFilePathB)
+{
+	TMap<FString, FHoudiniCookStatsAverages> AveragesA;
+	TMap<FString, FHoudiniCookStatsAverages> AveragesB;
+	if (!HoudiniLoadCookStatsAverages(InFilePathA, AveragesA) || !HoudiniLoadCookStatsAverages(InFilePathB, AveragesB))
+		return false;
+
+	TArray<FString> AssetIds;
+	AveragesA.GetKeys(AssetIds);
+	for (const auto& Pair : AveragesB)
+		AssetIds.AddUnique(Pair.Key);
+	AssetIds.Sort();
+
+	auto LogLine = [](const TCHAR* InLabel, const double& InA, const double& InB)
+	{
+		const double Delta = InA > 0.0 ? 100.0 * (InB - InA) / InA : 0.0;
+		HOUDINI_LOG_MESSAGE(TEXT("    %-12s %12.3f -> %12.3f  (%+.1f%%)"), InLabel, InA, InB, Delta);
+	};
+
+	HOUDINI_LOG_MESSAGE(TEXT("Cook Stats: per-cook averages, %s -> %s"), *InFilePathA, *InFilePathB);
+	const FHoudiniCookStatsAverages Empty;
+	for (const FString& AssetId : AssetIds)
+	{
+		const FHoudiniCookStatsAverages* A = AveragesA.Find(AssetId);
+		const FHoudiniCookStatsAverages* B = AveragesB.Find(AssetId);
+		HOUDINI_LOG_MESSAGE(TEXT("Cook Stats: %s (%s)%s"), A ? *A->Label : *B->Label, *AssetId,
+			!A ? TEXT(" (only in second file)") : !B ? TEXT(" (only in first file)") : TEXT(""));
+
+		A = A ? A : &Empty;
+		B = B ? B : &Empty;
+		for (int32 StageIndex = 0; StageIndex < (int32)EHoudiniCookStage::Num; StageIndex++)
+			LogLine(GetStageName((EHoudiniCookStage)StageIndex), A->StageSeconds[StageIndex], B->StageSeconds[StageIndex]);
+
+		LogLine(TEXT("FetchMB"), A->FetchBytes / (1024.0 * 1024.0), B->FetchBytes / (1024.0 * 1024.0));
+		LogLine(TEXT("FetchCalls"), A->FetchCalls, B->FetchCalls);
+	}
+
+	return true;
+}
+
+FHoudiniCookStageScope::FHoudiniCookStageScope(const EHoudiniCookStage& InStage)
+	: Stage(InStage)
+{
+	bEnabled = FHoudiniEngineCookStats::IsEnabled();
+	if (!bEnabled)
+		return;
+
+	Parent = HoudiniCurrentCookStageScope;
+	HoudiniCurrentCookStageScope = this;
+	StartTime = FPlatformTime::Seconds();
+}
+
+FHoudiniCookStageScope::~FHoudiniCookStageScope()
+{
+	if (!bEnabled)
+		return;
+
+	const double Seconds = FPlatformTime::Seconds() - StartTime;
+	HoudiniCurrentCookStageScope = Parent;
+	if (Parent)
+		Parent->ChildSeconds += Seconds;
+
+	FHoudiniEngineCookStats::AddStageTime(Stage, FMath::Max(Seconds - ChildSeconds, 0.0));
+}
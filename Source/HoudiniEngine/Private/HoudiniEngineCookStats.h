@@ -0,0 +1,164 @@
+/*
+* Copyright (c) <2024> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FJsonObject;
+
+// Stages of a HAC's cook that are measured by the cook stats
+enum class EHoudiniCookStage : uint8
+{
+	InputUpload,	// PreCook: uploading parameters and inputs
+	HapiCook,		// Wall-clock time of the cook task in the session
+	DataFetch,		// Reading output data from the session
+	MeshBuild,		// Building static meshes from the output parts
+	Materials,		// Creating materials, material instances and textures
+	Components,		// Creating, updating and registering components and instancers
+	Num
+};
+
+// Data read from a single session
+struct FHoudiniCookFetchStats
+{
+	int64 NumBytes = 0;
+	int64 NumCalls = 0;
+};
+
+// Measurements of one cook, or the sum of several cooks
+struct FHoudiniCookRecord
+{
+	FDateTime StartTime;
+	double StageSeconds[(int32)EHoudiniCookStage::Num] = {};
+
+	// Data fetch stats, by HAPI_Session::id
+	TMap<int64, FHoudiniCookFetchStats> SessionFetches;
+
+	void Add(const FHoudiniCookRecord& InOther);
+	double GetTotalSeconds() const;
+	FHoudiniCookFetchStats GetTotalFetch() const;
+};
+
+// Stats gathered for a single HAC
+struct FHoudiniAssetCookStats
+{
+	// Display name of the HAC, several HACs can have the same one
+	FString Label;
+
+	int32 NumCooks = 0;
+	FHoudiniCookRecord Totals;
+
+	// The most recent cooks, oldest first. The last entry is the cook in progress.
+	TArray<FHoudiniCookRecord> RecentCooks;
+
+	// Time at which the current HAPI cook task was started, negative if none.
+	double HapiCookStartTime = -1.0;
+};
+
+// Always-on collector of per-HAC cook and output translation timings.
+//
+// Assets are identified by the path name of their HAC, their display name is only used as a label.
+// Stages are attributed to the "current" asset, which is set on the game thread by FHoudiniCookStatsAssetScope
+// while a HAC is processed by the manager. Data fetches done by session pool workers during that time are
+// attributed to it as well. Stats can be printed, reset, dumped to JSON and compared with the
+// HoudiniEngine.CookStats console commands.
+class HOUDINIENGINE_API FHoudiniEngineCookStats
+{
+public:
+
+	// Returns true if the stats are being gathered (HoudiniEngine.CookStats)
+	static bool IsEnabled();
+
+	static const TCHAR* GetStageName(const EHoudiniCookStage& InStage);
+
+	// Starts a new cook record for the given asset
+	static void BeginCook(const FString& InAssetId, const FString& InLabel);
+
+	// Starts/stops the HAPI cook timer of the given asset
+	static void BeginHapiCook(const FString& InAssetId);
+	static void EndHapiCook(const FString& InAssetId);
+
+	// Adds time to a stage of the current asset's cook. Ignored if there is no current asset.
+	static void AddStageTime(const EHoudiniCookStage& InStage, const double& InSeconds);
+
+	// Adds a data fetch of the current asset's cook, can be called from any thread.
+	static void AddDataFetch(const int64& InSessionId, const int64& InNumBytes);
+
+	// Adds a data fetch done for a given asset, can be called from any thread.
+	static void AddDataFetch(const FString& InAssetId, const int64& InSessionId, const int64& InNumBytes);
+
+	// Sets the current asset, returns the previous one. Game thread only.
+	static FString SetCurrentAsset(const FString& InAssetId);
+
+	static void Reset();
+	static void LogStats();
+
+	// Converts the stats to / dumps the stats as JSON
+	static TSharedPtr<FJsonObject> ToJson();
+	static bool DumpToFile(const FString& InFilePath);
+
+	// Logs the per-cook averages of two JSON dumps side by side
+	static bool LogDiff(const FString& InFilePathA, const FString& InFilePathB);
+
+private:
+
+	// Must be called with the lock held
+	static FHoudiniCookRecord* GetCurrentRecord_Locked(const FString& InAssetId);
+
+	static FCriticalSection Lock;
+	static TMap<FString, FHoudiniAssetCookStats> Assets;
+	static FString CurrentAsset;
+};
+
+// Makes the given asset the current one for the lifetime of the scope
+struct FHoudiniCookStatsAssetScope
+{
+	FHoudiniCookStatsAssetScope(const FString& InAssetId)
+		: PreviousAsset(FHoudiniEngineCookStats::SetCurrentAsset(InAssetId)) {}
+
+	~FHoudiniCookStatsAssetScope() { FHoudiniEngineCookStats::SetCurrentAsset(PreviousAsset); }
+
+	FString PreviousAsset;
+};
+
+// Adds the time spent in a scope to a stage of the current asset's cook.
+// Time spent in nested stage scopes on the same thread is only counted once, by the innermost scope.
+struct HOUDINIENGINE_API FHoudiniCookStageScope
+{
+	FHoudiniCookStageScope(const EHoudiniCookStage& InStage);
+	~FHoudiniCookStageScope();
+
+	EHoudiniCookStage Stage;
+	double StartTime = 0.0;
+	double ChildSeconds = 0.0;
+	bool bEnabled = false;
+	FHoudiniCookStageScope* Parent = nullptr;
+};
+
+// Adds the time spent in the current scope to a cook stage of the current asset
+#define H_SCOPED_COOK_STAT(__STAGE) \
+				FHoudiniCookStageScope ANONYMOUS_VARIABLE(HoudiniCookStageScope)(__STAGE)
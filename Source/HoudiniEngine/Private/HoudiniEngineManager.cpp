@@ -33,18 +33,24 @@
 #include "HoudiniAssetComponent.h"
 #include "HoudiniEngineString.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniEngineCookStats.h"
 #include "HoudiniParameterTranslator.h"
 #include "HoudiniPDGManager.h"
+#include "HoudiniInput.h"
+#include "HoudiniInputObject.h"
 #include "HoudiniInputTranslator.h"
 #include "HoudiniNodeSyncComponent.h"
 #include "HoudiniOutputTranslator.h"
+#include "HoudiniOutputPrefetchCache.h"
 #include "HoudiniHandleTranslator.h"
+#include "UnrealLandscapeTranslator.h"
 #include "HoudiniLandscapeRuntimeUtils.h"
 
 #include "Misc/MessageDialog.h"
 #include "Misc/ScopedSlowTask.h"
 #include "Containers/Ticker.h"
 #include "HAL/IConsoleManager.h"
+#include "Async/Async.h"
 #if (ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION > 0)
 	#include "LevelInstance/LevelInstanceInterface.h"
 #endif
@@ -76,6 +82,20 @@ static TAutoConsoleVariable<float> CVarHoudiniEngineLiveSyncTickTime(
 	TEXT("1.0: Default\n")
 );
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineAsyncOutputFetch(
+	TEXT("HoudiniEngine.AsyncOutputFetch"),
+	1,
+	TEXT("Read the attributes of the cooked outputs on a worker thread before processing them on the game thread.\n")
+	TEXT("0: Disabled, all the output data is read while processing the outputs\n")
+	TEXT("1: Enabled (default)\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineAsyncOutputFetchMaxMB(
+	TEXT("HoudiniEngine.AsyncOutputFetchMaxMB"),
+	1024,
+	TEXT("Maximum amount of attribute data (in MB) prefetched per HDA after a cook. Remaining data is read while processing the outputs.\n")
+);
+
 FHoudiniEngineManager::FHoudiniEngineManager()
 	: CurrentIndex(0)
 	, ComponentCount(0)
@@ -111,9 +131,34 @@ FHoudiniEngineManager::StartHoudiniTicking()
 	}
 }
 
+void
+FHoudiniEngineManager::OnSessionTeardown()
+{
+	PDGManager.DetachPDGEventPumpSession();
+
+	// The streamed landscape inputs and the cached node parameters refer to nodes of the session,
+	// they can't be reused with the node ids of a new session
+	if (IsInGameThread())
+	{
+		FUnrealLandscapeTranslator::ResetStreamedHeightfields();
+		FHoudiniParameterTranslator::ResetCachedNodeParameters();
+	}
+	else
+	{
+		AsyncTask(ENamedThreads::GameThread, []()
+		{
+			FUnrealLandscapeTranslator::ResetStreamedHeightfields();
+			FHoudiniParameterTranslator::ResetCachedNodeParameters();
+		});
+	}
+}
+
 void 
 FHoudiniEngineManager::StopHoudiniTicking()
 {
+	// PDG events can't be processed without ticking, stop fetching them
+	PDGManager.DetachPDGEventPumpSession();
+
 	if (TickerHandle.IsValid() && GEditor)
 	{
 		if (IsInGameThread())
@@ -506,6 +551,13 @@ FHoudiniEngineManager::ProcessComponent(UHoudiniAssetComponent* HAC)
 		return;
 	}
 
+	// Drop output prefetches that were left behind when the HAC's state was changed externally
+	if (AssetStateToProcess != EHoudiniAssetState::PostCook && PendingOutputPrefetches.Num() > 0)
+		PendingOutputPrefetches.Remove(HAC);
+
+	// Attribute the work done for this HAC to it in the cook stats
+	FHoudiniCookStatsAssetScope CookStatsScope(HAC->GetPathName());
+
 	switch (AssetStateToProcess)
 	{
 		case EHoudiniAssetState::NeedInstantiation:
@@ -604,7 +656,8 @@ FHoudiniEngineManager::ProcessComponent(UHoudiniAssetComponent* HAC)
 				FGuid TaskGuid;
 				FString HapiAssetName;
 				UHoudiniAsset* HoudiniAsset = HAC->GetHoudiniAsset();
-				if (StartTaskAssetInstantiation(HoudiniAsset, HAC->GetDisplayName(), TaskGuid, HapiAssetName))
+				AssignSchedulerAffinity(HAC);
+				if (StartTaskAssetInstantiation(HoudiniAsset, HAC->GetDisplayName(), TaskGuid, HapiAssetName, HAC->GetSchedulerAffinity()))
 				{
 					// Update the HAC's state
 					HAC->SetAssetState(EHoudiniAssetState::Instantiating);
@@ -651,6 +704,8 @@ FHoudiniEngineManager::ProcessComponent(UHoudiniAssetComponent* HAC)
 			if (HAC->NeedsToWaitForInputHoudiniAssets())
 				break;
 
+			FHoudiniEngineCookStats::BeginCook(HAC->GetPathName(), HAC->GetDisplayName());
+
 			HAC->OnPrePreCook();
 			// Update all the HAPI nodes, parameters, inputs etc...
 			PreCook(HAC);
@@ -666,18 +721,22 @@ FHoudiniEngineManager::ProcessComponent(UHoudiniAssetComponent* HAC)
 				HAC->SetOutputNodeIds(OutputNodes);
 				
 				FGuid TaskGUID = HAC->GetHapiGUID();
+				RehomeSchedulerAffinityIfNeeded(HAC);
 				if ( StartTaskAssetCooking(
 					HAC->GetAssetId(),
 					OutputNodes,
 					HAC->GetDisplayName(),
 					HAC->bUseOutputNodes,
 					HAC->bOutputTemplateGeos,
-					TaskGUID) )
+					TaskGUID,
+					HAC->GetSchedulerAffinity()) )
 				{
 					// Updates the HAC's state
 					HAC->SetAssetState(EHoudiniAssetState::Cooking);
 					HAC->HapiGUID = TaskGUID;
 					bCookStarted = true;
+
+					FHoudiniEngineCookStats::BeginHapiCook(HAC->GetPathName());
 				}
 			}
 			
@@ -716,12 +775,21 @@ FHoudiniEngineManager::ProcessComponent(UHoudiniAssetComponent* HAC)
 		{
 			TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniEngineManager::ProcessComponent-PostCook);
 			// Handle PostCook
+			// Wait for the output data to be read on a worker thread, other HACs keep being processed meanwhile
+			TSharedPtr<FHoudiniOutputPrefetchCache> PrefetchCache;
+			if (!UpdateOutputPrefetch(HAC, PrefetchCache))
+				break;
+
 			EHoudiniAssetState NewState = EHoudiniAssetState::None;
 			bool bSuccess = HAC->bLastCookSuccess;
 			HAC->HandleOnPreOutputProcessing();
 			HAC->OnPreOutputProcessing();
-			
-			if (PostCook(HAC, bSuccess, HAC->GetAssetId()))
+
+			FHoudiniOutputPrefetchCache::SetActive(PrefetchCache);
+			const bool bPostCookSuccess = PostCook(HAC, bSuccess, HAC->GetAssetId());
+			FHoudiniOutputPrefetchCache::SetActive(nullptr);
+
+			if (bPostCookSuccess)
 			{
 				// Cook was successful, process the results
 				NewState = EHoudiniAssetState::PreProcess;
@@ -858,9 +926,10 @@ FHoudiniEngineManager::ProcessComponent(UHoudiniAssetComponent* HAC)
 			{
 				// Do not delete nodes for NodeSync components!
 				FGuid HapiDeletionGUID;
-				StartTaskAssetDelete(HAC->GetAssetId(), HapiDeletionGUID, true);
+				StartTaskAssetDelete(HAC->GetAssetId(), HapiDeletionGUID, true, HAC->GetSchedulerAffinity());
 				//HAC->AssetId = -1;
 			}
+			ReleaseSchedulerAffinity(HAC);
 
 			// Update the HAC's state
 			HAC->SetAssetState(EHoudiniAssetState::Deleting);
@@ -881,7 +950,12 @@ FHoudiniEngineManager::ProcessComponent(UHoudiniAssetComponent* HAC)
 
 
 bool 
-FHoudiniEngineManager::StartTaskAssetInstantiation(UHoudiniAsset* HoudiniAsset, const FString& DisplayName, FGuid& OutTaskGUID, FString& OutHAPIAssetName)
+FHoudiniEngineManager::StartTaskAssetInstantiation(
+	UHoudiniAsset* HoudiniAsset,
+	const FString& DisplayName,
+	FGuid& OutTaskGUID,
+	FString& OutHAPIAssetName,
+	const int32& InSchedulerAffinity)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniEngineManager::StartTaskAssetInstantiation);
 
@@ -944,6 +1018,7 @@ FHoudiniEngineManager::StartTaskAssetInstantiation(UHoudiniAsset* HoudiniAsset,
 	//Task.bLoadedComponent = bLocalLoadedComponent;
 	Task.AssetLibraryId = AssetLibraryId;
 	Task.AssetHapiName = PickedAssetName;
+	Task.SchedulerAffinity = InSchedulerAffinity;
 
 	FHoudiniEngineString(PickedAssetName).ToFString(OutHAPIAssetName);
 
@@ -1126,7 +1201,8 @@ FHoudiniEngineManager::StartTaskAssetCooking(
 	const FString& DisplayName,
 	bool bUseOutputNodes,
 	bool bOutputTemplateGeos,
-	FGuid& OutTaskGUID)
+	FGuid& OutTaskGUID,
+	const int32& InSchedulerAffinity)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniEngineManager::StartTaskAssetCooking);
 
@@ -1155,6 +1231,7 @@ FHoudiniEngineManager::StartTaskAssetCooking(
 
 	Task.bUseOutputNodes = bUseOutputNodes;
 	Task.bOutputTemplateGeos = bOutputTemplateGeos;
+	Task.SchedulerAffinity = InSchedulerAffinity;
 
 	FHoudiniEngine::Get().AddTask(Task);
 
@@ -1182,6 +1259,7 @@ FHoudiniEngineManager::UpdateCooking(UHoudiniAssetComponent* HAC, EHoudiniAssetS
 	{
 		// Couldnt get a valid task info
 		HOUDINI_LOG_ERROR(TEXT("    %s Failed to cook - invalid task"), *DisplayName);
+		FHoudiniEngineCookStats::EndHapiCook(HAC->GetPathName());
 		NewState = EHoudiniAssetState::None;
 		bUpdateState = true;
 		return bUpdateState;
@@ -1229,6 +1307,8 @@ FHoudiniEngineManager::UpdateCooking(UHoudiniAssetComponent* HAC, EHoudiniAssetS
 	// If the task is still in progress, return now
 	if (!bUpdateState)
 		return false;
+
+	FHoudiniEngineCookStats::EndHapiCook(HAC->GetPathName());
 	   
 	// Handle PostCook
 	NewState = EHoudiniAssetState::PostCook;
@@ -1311,14 +1391,18 @@ FHoudiniEngineManager::PreCook(UHoudiniAssetComponent* HAC)
 		// TODO: Restore parameter preset data
 	}
 
-	// Try to upload changed parameters
-	FHoudiniParameterTranslator::UploadChangedParameters(HAC);
+	{
+		H_SCOPED_COOK_STAT(EHoudiniCookStage::InputUpload);
 
-	// Try to upload changed inputs
-	FHoudiniInputTranslator::UploadChangedInputs(HAC);
+		// Try to upload changed parameters
+		FHoudiniParameterTranslator::UploadChangedParameters(HAC);
 
-	// Try to upload changed editable nodes
-	FHoudiniOutputTranslator::UploadChangedEditableOutput(HAC, false);
+		// Try to upload changed inputs
+		FHoudiniInputTranslator::UploadChangedInputs(HAC);
+
+		// Try to upload changed editable nodes
+		FHoudiniOutputTranslator::UploadChangedEditableOutput(HAC, false);
+	}
 
 	// Upload the asset's transform if needed
 	if (HAC->bHasComponentTransformChanged && HAC->bUploadTransformsToHoudiniEngine)
@@ -1329,6 +1413,55 @@ FHoudiniEngineManager::PreCook(UHoudiniAssetComponent* HAC)
 	return true;
 }
 
+bool
+FHoudiniEngineManager::UpdateOutputPrefetch(UHoudiniAssetComponent* HAC, TSharedPtr<FHoudiniOutputPrefetchCache>& OutCache)
+{
+	OutCache.Reset();
+
+	// Forget about the prefetches of destroyed HACs
+	for (auto It = PendingOutputPrefetches.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+			It.RemoveCurrent();
+	}
+
+	TFuture<TSharedPtr<FHoudiniOutputPrefetchCache>>* PendingPrefetch = PendingOutputPrefetches.Find(HAC);
+	if (!PendingPrefetch)
+	{
+		if (CVarHoudiniEngineAsyncOutputFetch.GetValueOnGameThread() <= 0)
+			return true;
+
+		if (!HAC->bLastCookSuccess || HAC->bOutputless)
+			return true;
+
+		const TArray<HAPI_NodeId> OutputNodeIds = HAC->GetOutputNodeIds();
+		if (OutputNodeIds.Num() <= 0)
+			return true;
+
+		const int64 MaxBytes = (int64)FMath::Max(CVarHoudiniEngineAsyncOutputFetchMaxMB.GetValueOnGameThread(), 0) * 1024 * 1024;
+		PendingOutputPrefetches.Add(HAC, Async(EAsyncExecution::ThreadPool, [OutputNodeIds, MaxBytes]()
+		{
+			return FHoudiniOutputPrefetchCache::Fetch(OutputNodeIds, MaxBytes);
+		}));
+
+		return false;
+	}
+
+	if (!PendingPrefetch->IsReady())
+		return false;
+
+	OutCache = PendingPrefetch->Get();
+	PendingOutputPrefetches.Remove(HAC);
+
+	if (OutCache.IsValid())
+	{
+		const HAPI_Session* Session = FHoudiniEngine::Get().GetSession();
+		FHoudiniEngineCookStats::AddDataFetch(HAC->GetPathName(), Session ? Session->id : 0, OutCache->GetNumBytes());
+	}
+
+	return true;
+}
+
 bool
 FHoudiniEngineManager::PostCook(UHoudiniAssetComponent* HAC, const bool& bSuccess, const HAPI_NodeId& TaskAssetId)
 {
@@ -1501,7 +1634,11 @@ FHoudiniEngineManager::StartTaskAssetRebuild(const HAPI_NodeId& InAssetId, FGuid
 }
 
 bool
-FHoudiniEngineManager::StartTaskAssetDelete(const HAPI_NodeId& InNodeId, FGuid& OutTaskGUID, bool bShouldDeleteParent)
+FHoudiniEngineManager::StartTaskAssetDelete(
+	const HAPI_NodeId& InNodeId,
+	FGuid& OutTaskGUID,
+	bool bShouldDeleteParent,
+	const int32& InSchedulerAffinity)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniEngineManager::StartTaskAssetDelete);
 
@@ -1531,11 +1668,103 @@ FHoudiniEngineManager::StartTaskAssetDelete(const HAPI_NodeId& InNodeId, FGuid&
 	// Create asset deletion task object and submit it for processing.
 	FHoudiniEngineTask Task(EHoudiniEngineTaskType::AssetDeletion, OutTaskGUID);
 	Task.AssetId = OBJNodeToDelete;
+	Task.SchedulerAffinity = InSchedulerAffinity;
 	FHoudiniEngine::Get().AddTask(Task);
 
 	return true;
 }
 
+int32
+FHoudiniEngineManager::GetSchedulerAffinity(UHoudiniAssetComponent* HAC)
+{
+	if (!IsValid(HAC))
+		return INDEX_NONE;
+
+	if (!FHoudiniEngine::IsMultiSessionSchedulingEnabled())
+		return INDEX_NONE;
+
+	// Gather all the HACs connected to this one through asset inputs, upstream and downstream, so that their tasks
+	// are processed in order by the same worker. All sessions share the same nodes, this only affects ordering.
+	// The tree is identified by its lowest unique ID.
+	TSet<UHoudiniAssetComponent*> VisitedHACs;
+	TArray<UHoudiniAssetComponent*> HACsToVisit;
+	HACsToVisit.Add(HAC);
+	uint32 TreeId = HAC->GetUniqueID();
+	while (HACsToVisit.Num() > 0)
+	{
+		UHoudiniAssetComponent* CurrentHAC = HACsToVisit.Pop(EAllowShrinking::No);
+		if (!IsValid(CurrentHAC) || VisitedHACs.Contains(CurrentHAC))
+			continue;
+
+		VisitedHACs.Add(CurrentHAC);
+		TreeId = FMath::Min(TreeId, CurrentHAC->GetUniqueID());
+
+		for (UHoudiniInput* CurrentInput : CurrentHAC->GetInputs())
+		{
+			if (!IsValid(CurrentInput) || !CurrentInput->IsAssetInput())
+				continue;
+
+			TArray<TObjectPtr<UHoudiniInputObject>>* ObjectArray = CurrentInput->GetHoudiniInputObjectArray(CurrentInput->GetInputType());
+			if (!ObjectArray)
+				continue;
+
+			for (auto& CurrentInputObject : *ObjectArray)
+			{
+				UHoudiniAssetComponent* InputHAC = CurrentInputObject
+					? Cast<UHoudiniAssetComponent>(CurrentInputObject->GetObject())
+					: nullptr;
+
+				if (IsValid(InputHAC))
+					HACsToVisit.Add(InputHAC);
+			}
+		}
+
+		for (const auto& DownstreamHAC : CurrentHAC->GetDownstreamHoudiniAssets())
+			HACsToVisit.Add(DownstreamHAC);
+	}
+
+	return static_cast<int32>(TreeId);
+}
+
+void
+FHoudiniEngineManager::AssignSchedulerAffinity(UHoudiniAssetComponent* HAC)
+{
+	if (!IsValid(HAC))
+		return;
+
+	const int32 SchedulerAffinity = GetSchedulerAffinity(HAC);
+	FHoudiniEngine::Get().AcquireSchedulerAffinity(SchedulerAffinity);
+	FHoudiniEngine::Get().ReleaseSchedulerAffinity(HAC->GetSchedulerAffinity());
+	HAC->SetSchedulerAffinity(SchedulerAffinity);
+}
+
+void
+FHoudiniEngineManager::RehomeSchedulerAffinityIfNeeded(UHoudiniAssetComponent* HAC)
+{
+	if (!IsValid(HAC))
+		return;
+
+	// Connecting or disconnecting asset inputs changes the node tree. Tasks of the previous tree may still be
+	// queued on its worker, wait for them to be processed before sending this HAC's tasks to another one.
+	if (GetSchedulerAffinity(HAC) == HAC->GetSchedulerAffinity())
+		return;
+
+	if (!FHoudiniEngine::Get().IsSchedulerAffinityIdle(HAC->GetSchedulerAffinity()))
+		return;
+
+	AssignSchedulerAffinity(HAC);
+}
+
+void
+FHoudiniEngineManager::ReleaseSchedulerAffinity(UHoudiniAssetComponent* HAC)
+{
+	if (!IsValid(HAC))
+		return;
+
+	FHoudiniEngine::Get().ReleaseSchedulerAffinity(HAC->GetSchedulerAffinity());
+	HAC->SetSchedulerAffinity(INDEX_NONE);
+}
+
 bool
 FHoudiniEngineManager::UpdateTaskStatus(FGuid& OutTaskGUID, FHoudiniEngineTaskInfo& OutTaskInfo)
 {
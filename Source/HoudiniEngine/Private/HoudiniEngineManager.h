@@ -29,6 +29,7 @@
 #include "HAPI/HAPI_Common.h"
 #include "TimerManager.h"
 #include "Containers/Ticker.h"
+#include "Async/Future.h"
 
 //#include "HAL/Runnable.h"
 //#include "HAL/RunnableThread.h"
@@ -38,6 +39,7 @@
 
 class UHoudiniAsset;
 class UHoudiniAssetComponent;
+class FHoudiniOutputPrefetchCache;
 
 struct FHoudiniEngineTaskInfo;
 struct FGuid;
@@ -83,6 +85,11 @@ public:
 	}
 
 	EHoudiniBGEOCommandletStatus GetPDGCommandletStatus() { return PDGManager.UpdateAndGetBGEOCommandletStatus(); }
+
+	// Must be called before the session is closed or the engine's sessions are reset,
+	// so the PDG event thread stops using the session and the state tied to its nodes is dropped.
+	// Can be called from any thread.
+	void OnSessionTeardown();
 	
 	
 protected:
@@ -99,7 +106,8 @@ protected:
 		UHoudiniAsset* HoudiniAsset,
 		const FString& DisplayName,
 		FGuid& OutTaskGUID,
-		FString& OutHAPIAssetName);
+		FString& OutHAPIAssetName,
+		const int32& InSchedulerAffinity = INDEX_NONE);
 
 	// Updates progress of the instantiation task
 	// Returns true if a state change should be made
@@ -115,7 +123,8 @@ protected:
 		const FString& DisplayName,
 		bool bUseOutputNodes,
 		bool bOutputTemplateGeos,
-		FGuid& OutTaskGUID);
+		FGuid& OutTaskGUID,
+		const int32& InSchedulerAffinity = INDEX_NONE);
 
 	// Updates progress of the cooking task
 	// Returns true if a state change should be made
@@ -135,6 +144,13 @@ protected:
 		const bool& bSuccess,
 		const HAPI_NodeId& TaskAssetId);
 
+	// Prefetches the HAC's output data on a worker thread after a successful cook.
+	// Returns false while the prefetch is still running, true once the outputs can be processed.
+	// OutCache is only valid if the prefetch succeeded.
+	bool UpdateOutputPrefetch(
+		UHoudiniAssetComponent* HAC,
+		TSharedPtr<FHoudiniOutputPrefetchCache>& OutCache);
+
 	bool StartTaskAssetProcess(UHoudiniAssetComponent* HAC);
 
 	bool UpdateProcess(UHoudiniAssetComponent* HAC);
@@ -150,7 +166,24 @@ protected:
 	bool StartTaskAssetDelete(
 		const HAPI_NodeId& InAssetId,
 		FGuid& OutTaskGUID,
-		bool bShouldDeleteParent);
+		bool bShouldDeleteParent,
+		const int32& InSchedulerAffinity = INDEX_NONE);
+
+	// Returns the scheduler affinity of a HAC's current node tree: the lowest unique ID of the HACs connected to it
+	// through asset inputs. HACs feeding each other share the same affinity and have their tasks processed by the same
+	// scheduler/session, while unrelated HACs can be instantiated and cooked concurrently.
+	static int32 GetSchedulerAffinity(UHoudiniAssetComponent* HAC);
+
+	// Assigns the scheduler affinity of its current node tree to the HAC, releasing the one it had.
+	// Called on instantiation, the HAC's cook and delete tasks then keep using that affinity.
+	static void AssignSchedulerAffinity(UHoudiniAssetComponent* HAC);
+
+	// Moves the HAC to the scheduler affinity of its current node tree if its asset inputs were rewired.
+	// This is only done once all the tasks of its previous tree have been processed, so they stay in order.
+	static void RehomeSchedulerAffinityIfNeeded(UHoudiniAssetComponent* HAC);
+
+	// Releases the HAC's scheduler affinity, after its deletion task has been started.
+	static void ReleaseSchedulerAffinity(UHoudiniAssetComponent* HAC);
 
 	bool IsCookingEnabledForHoudiniAsset(UHoudiniAssetComponent* HAC);
 
@@ -206,4 +239,7 @@ private:
 
 	// Indicates which HACs disable auto-saving
 	TSet<TWeakObjectPtr<const UHoudiniAssetComponent>> DisableAutoSavingHACs;
+
+	// Output prefetches running for HACs in the PostCook state
+	TMap<TWeakObjectPtr<UHoudiniAssetComponent>, TFuture<TSharedPtr<FHoudiniOutputPrefetchCache>>> PendingOutputPrefetches;
 };
\ No newline at end of file
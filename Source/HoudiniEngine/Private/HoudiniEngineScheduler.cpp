@@ -30,6 +30,7 @@
 #include "HoudiniEngineString.h"
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngine.h"
+#include "HoudiniEngineSessionPool.h"
 
 const uint32
 FHoudiniEngineScheduler::InitialTaskSize = 256u;
@@ -38,12 +39,13 @@ FHoudiniEngineScheduler::InitialTaskSize = 256u;
 const float
 FHoudiniEngineScheduler::UpdateFrequency = 0.1f;
 
-FHoudiniEngineScheduler::FHoudiniEngineScheduler()
+FHoudiniEngineScheduler::FHoudiniEngineScheduler(const int32 InSessionIndex)
 	: WakeUpEvent(FEventRef(EEventMode::AutoReset))
 	, Tasks(nullptr)
 	, PositionWrite(0u)
 	, PositionRead(0u)
 	, bStopping(false)
+	, SessionIndex(InSessionIndex)
 {
 	//  Make sure size is power of two.
 	TaskCount = FPlatformMath::RoundUpToPowerOfTwo(FHoudiniEngineScheduler::InitialTaskSize);
@@ -70,6 +72,16 @@ FHoudiniEngineScheduler::~FHoudiniEngineScheduler()
 	}
 }
 
+const HAPI_Session*
+FHoudiniEngineScheduler::GetSchedulerSession() const
+{
+	const HAPI_Session* Session = FHoudiniEngine::Get().GetSession(SessionIndex);
+	if (!Session)
+		Session = FHoudiniEngine::Get().GetSession();
+
+	return Session;
+}
+
 void
 FHoudiniEngineScheduler::TaskDescription(
 	FHoudiniEngineTaskInfo & TaskInfo,
@@ -169,7 +181,7 @@ FHoudiniEngineScheduler::TaskInstantiateAsset(const FHoudiniEngineTask & Task)
 
 	// We instantiate without cooking.
 	Result = FHoudiniApi::CreateNode(
-		FHoudiniEngine::Get().GetSession(), -1, &AssetNameString[0], nullptr, false, &AssetId);
+		GetSchedulerSession(), -1, &AssetNameString[0], nullptr, false, &AssetId);
 	if (Result != HAPI_RESULT_SUCCESS)
 	{
 		AddResponseMessageTaskInfo(
@@ -196,7 +208,7 @@ FHoudiniEngineScheduler::TaskInstantiateAsset(const FHoudiniEngineTask & Task)
 	{
 		int Status = HAPI_STATE_STARTING_COOK;
 		HOUDINI_CHECK_ERROR_GET(&Result, FHoudiniApi::GetStatus(
-			FHoudiniEngine::Get().GetSession(), HAPI_STATUS_COOK_STATE, &Status));
+			GetSchedulerSession(), HAPI_STATUS_COOK_STATE, &Status));
 
 		if (Status == HAPI_STATE_READY)
 		{
@@ -212,9 +224,9 @@ FHoudiniEngineScheduler::TaskInstantiateAsset(const FHoudiniEngineTask & Task)
 		else if (Status == HAPI_STATE_READY_WITH_FATAL_ERRORS || Status == HAPI_STATE_READY_WITH_COOK_ERRORS)
 		{
 			// There was an error while instantiating.
-			FString CookResultString = FHoudiniEngineUtils::GetCookResult();
+			FString CookResultString = FHoudiniEngineUtils::GetCookResult(GetSchedulerSession());
 			int32 CookResult = static_cast<int32>(HAPI_RESULT_SUCCESS);
-			FHoudiniApi::GetStatus(FHoudiniEngine::Get().GetSession(), HAPI_STATUS_COOK_RESULT, &CookResult);
+			FHoudiniApi::GetStatus(GetSchedulerSession(), HAPI_STATUS_COOK_RESULT, &CookResult);
 
 			EHoudiniEngineTaskState TaskStateResult = EHoudiniEngineTaskState::FinishedWithFatalError;
 			if (Status == HAPI_STATE_READY_WITH_COOK_ERRORS)
@@ -253,7 +265,7 @@ FHoudiniEngineScheduler::TaskInstantiateAsset(const FHoudiniEngineTask & Task)
 		{
 			// Reset update time.
 			LastUpdateTime = FPlatformTime::Seconds();
-			const FString& CookStateMessage = FHoudiniEngineUtils::GetCookState();
+			const FString& CookStateMessage = FHoudiniEngineUtils::GetCookState(GetSchedulerSession());
 
 			AddResponseMessageTaskInfo(
 				HAPI_RESULT_SUCCESS,
@@ -325,7 +337,7 @@ FHoudiniEngineScheduler::TaskCookAsset(const FHoudiniEngineTask & Task)
 	EHoudiniEngineTaskState GlobalTaskResult = EHoudiniEngineTaskState::Success;
 	for (auto& CurrentNodeId : NodesToCook)
 	{
-		Result = FHoudiniApi::CookNode(FHoudiniEngine::Get().GetSession(), CurrentNodeId, &CookOptions);
+		Result = FHoudiniApi::CookNode(GetSchedulerSession(), CurrentNodeId, &CookOptions);
 		if (Result != HAPI_RESULT_SUCCESS)
 		{
 			AddResponseMessageTaskInfo(
@@ -354,7 +366,7 @@ FHoudiniEngineScheduler::TaskCookAsset(const FHoudiniEngineTask & Task)
 		{
 			int32 Status = HAPI_STATE_STARTING_COOK;
 			HOUDINI_CHECK_ERROR_GET(&Result, FHoudiniApi::GetStatus(
-				FHoudiniEngine::Get().GetSession(), HAPI_STATUS_COOK_STATE, &Status));
+				GetSchedulerSession(), HAPI_STATUS_COOK_STATE, &Status));
 
 			if (Status == HAPI_STATE_READY)
 			{
@@ -398,7 +410,7 @@ FHoudiniEngineScheduler::TaskCookAsset(const FHoudiniEngineTask & Task)
 				LastUpdateTime = FPlatformTime::Seconds();
 
 				// Retrieve status string.
-				const FString & CookStateMessage = FHoudiniEngineUtils::GetCookState();
+				const FString & CookStateMessage = FHoudiniEngineUtils::GetCookState(GetSchedulerSession());
 
 				AddResponseMessageTaskInfo(
 					HAPI_RESULT_SUCCESS,
@@ -526,6 +538,11 @@ FHoudiniEngineScheduler::ProcessQueuedTasks()
 
 			bool bTaskProcessed = true;
 
+			// Sessions other than the main one are shared with the session pool, which skips them while we hold their lock
+			FCriticalSection* SessionLock = SessionIndex > 0 ? &FHoudiniEngineSessionPool::GetSessionLock(SessionIndex) : nullptr;
+			if (SessionLock)
+				SessionLock->Lock();
+
 			switch (Task.TaskType)
 			{
 				case EHoudiniEngineTaskType::AssetInstantiation:
@@ -559,6 +576,12 @@ FHoudiniEngineScheduler::ProcessQueuedTasks()
 				}
 			}
 
+			if (SessionLock)
+				SessionLock->Unlock();
+
+			// Lets the engine know the task's node tree has one less task pending
+			FHoudiniEngine::Get().OnSchedulerTaskProcessed(Task);
+
 			if (!bTaskProcessed)
 				break;
 		}
@@ -634,6 +657,12 @@ bool FHoudiniEngineScheduler::HasPendingTasks()
 	return (PositionWrite != PositionRead);
 }
 
+uint32 FHoudiniEngineScheduler::GetNumPendingTasks()
+{
+	FScopeLock ScopeLock(&CriticalSection);
+	return (PositionWrite - PositionRead) & (TaskCount - 1);
+}
+
 void
 FHoudiniEngineScheduler::AddTask(const FHoudiniEngineTask & Task)
 {
@@ -37,7 +37,7 @@ class FHoudiniEngineScheduler : public FRunnable, FSingleThreadRunnable
 {
 public:
 
-	FHoudiniEngineScheduler();
+	FHoudiniEngineScheduler(const int32 InSessionIndex = 0);
 	virtual ~FHoudiniEngineScheduler();
 
 	// FRunnable methods.
@@ -50,6 +50,12 @@ public:
 
 	bool HasPendingTasks();
 
+	// Returns the number of tasks waiting in the queue.
+	uint32 GetNumPendingTasks();
+
+	// Returns the index of the session used by this scheduler to process its tasks.
+	int32 GetSessionIndex() const { return SessionIndex; };
+
 	// Adds a task.
 	void AddTask(const FHoudiniEngineTask & Task);
 
@@ -71,6 +77,10 @@ public:
 
 protected:
 
+	// Returns the session used by this scheduler, falls back to the main session
+	// if our session is not available anymore.
+	const HAPI_Session* GetSchedulerSession() const;
+
 	// Process queued tasks. 
 	void ProcessQueuedTasks();
 
@@ -120,4 +130,7 @@ private:
 
 	// Stopping flag. 
 	bool bStopping;
+
+	// Index of the HAPI session this scheduler's tasks are run on.
+	int32 SessionIndex;
 };
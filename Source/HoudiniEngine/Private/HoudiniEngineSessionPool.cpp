@@ -0,0 +1,229 @@
+/*
+* Copyright (c) <2024> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniEngineSessionPool.h"
+
+#include "HoudiniEngine.h"
+#include "HoudiniEnginePrivatePCH.h"
+#include "HoudiniEngineTimers.h"
+
+#include "Async/AsyncWork.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+#include <atomic>
+
+FCriticalSection FHoudiniEngineSessionPool::StatsLock;
+TArray<FHoudiniSessionPoolStats> FHoudiniEngineSessionPool::Stats;
+FCriticalSection FHoudiniEngineSessionPool::SessionLocksLock;
+TArray<TUniquePtr<FCriticalSection>> FHoudiniEngineSessionPool::SessionLocks;
+
+static FAutoConsoleCommand CCmdHoudiniSessionPoolStats(
+	TEXT("HoudiniEngine.SessionPoolStats"),
+	TEXT("Prints the amount of data transferred and the throughput of each Houdini Engine session. Use \"reset\" to clear the counters."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		FHoudiniEngineSessionPool::LogStats();
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+			FHoudiniEngineSessionPool::ResetStats();
+	}));
+
+// Shared state of a single ExecuteChunks call.
+struct FHoudiniSessionPoolContext
+{
+	FHoudiniSessionPoolContext(FHoudiniEngineSessionPool::FChunkWork InWork, int32 InNumChunks, int64 InBytesPerChunk)
+		: Work(InWork)
+		, NumChunks(InNumChunks)
+		, BytesPerChunk(InBytesPerChunk)
+		, NextChunk(0)
+		, bFailed(false)
+	{}
+
+	FHoudiniEngineSessionPool::FChunkWork Work;
+	int32 NumChunks;
+	int64 BytesPerChunk;
+
+	// Index of the next chunk to process, shared by all workers.
+	std::atomic<int32> NextChunk;
+
+	// Set as soon as one chunk fails, the remaining chunks are then skipped.
+	std::atomic<bool> bFailed;
+};
+
+struct FHoudiniSessionPoolWorker : public FNonAbandonableTask
+{
+	FHoudiniSessionPoolContext* Context = nullptr;
+	const HAPI_Session* Session = nullptr;
+	int32 SessionIndex = 0;
+
+	void DoWork();
+
+	TStatId GetStatId() const { RETURN_QUICK_DECLARE_CYCLE_STAT(FHoudiniSessionPoolWorker, STATGROUP_ThreadPoolAsyncTasks); }
+};
+
+void
+FHoudiniSessionPoolWorker::DoWork()
+{
+	H_SCOPED_FUNCTION_TIMER();
+
+	// The session is busy with a scheduler task, leave its chunks to the other sessions
+	FCriticalSection* SessionLock = SessionIndex > 0 ? &FHoudiniEngineSessionPool::GetSessionLock(SessionIndex) : nullptr;
+	if (SessionLock && !SessionLock->TryLock())
+		return;
+
+	while (!Context->bFailed)
+	{
+		const int32 ChunkIndex = Context->NextChunk.fetch_add(1);
+		if (ChunkIndex >= Context->NumChunks)
+			break;
+
+		const double StartTime = FPlatformTime::Seconds();
+		const bool bSuccess = Context->Work(Session, ChunkIndex);
+		FHoudiniEngineSessionPool::RecordChunk(SessionIndex, Context->BytesPerChunk, FPlatformTime::Seconds() - StartTime, bSuccess);
+
+		if (!bSuccess)
+			Context->bFailed = true;
+	}
+
+	if (SessionLock)
+		SessionLock->Unlock();
+}
+
+bool
+FHoudiniEngineSessionPool::ExecuteChunks(int32 NumChunks, int32 NumSessions, int64 TotalBytes, FChunkWork Work)
+{
+	if (NumChunks <= 0)
+		return true;
+
+	// No sessions.
+	const int32 NumAvailableSessions = FHoudiniEngine::Get().GetNumSessions();
+	if (NumAvailableSessions <= 0 || !FHoudiniEngine::Get().GetSession())
+		return false;
+
+	NumSessions = FMath::Clamp(NumSessions, 1, FMath::Min(NumAvailableSessions, NumChunks));
+
+	FHoudiniSessionPoolContext Context(Work, NumChunks, TotalBytes / NumChunks);
+
+	// Start one worker per additional session, a session can only be used by one worker (or its scheduler) at a time.
+	TArray<FAsyncTask<FHoudiniSessionPoolWorker>> Workers;
+	Workers.SetNum(NumSessions);
+	for (int32 SessionIndex = 1; SessionIndex < NumSessions; SessionIndex++)
+	{
+		const HAPI_Session* Session = FHoudiniEngine::Get().GetSession(SessionIndex);
+		if (!Session)
+			continue;
+
+		FHoudiniSessionPoolWorker& Worker = Workers[SessionIndex].GetTask();
+		Worker.Context = &Context;
+		Worker.Session = Session;
+		Worker.SessionIndex = SessionIndex;
+		Workers[SessionIndex].StartBackgroundTask();
+	}
+
+	// The calling thread processes chunks on the main session.
+	FHoudiniSessionPoolWorker& MainWorker = Workers[0].GetTask();
+	MainWorker.Context = &Context;
+	MainWorker.Session = FHoudiniEngine::Get().GetSession();
+	MainWorker.SessionIndex = 0;
+	Workers[0].StartSynchronousTask();
+
+	// Wait for the other sessions to finish their current chunk.
+	for (int32 SessionIndex = 1; SessionIndex < NumSessions; SessionIndex++)
+	{
+		if (Workers[SessionIndex].GetTask().Context)
+			Workers[SessionIndex].EnsureCompletion();
+	}
+
+	return !Context.bFailed;
+}
+
+FCriticalSection&
+FHoudiniEngineSessionPool::GetSessionLock(int32 SessionIndex)
+{
+	check(SessionIndex > 0);
+
+	FScopeLock ScopeLock(&SessionLocksLock);
+
+	if (!SessionLocks.IsValidIndex(SessionIndex))
+		SessionLocks.SetNum(SessionIndex + 1);
+
+	if (!SessionLocks[SessionIndex].IsValid())
+		SessionLocks[SessionIndex] = MakeUnique<FCriticalSection>();
+
+	return *SessionLocks[SessionIndex];
+}
+
+void
+FHoudiniEngineSessionPool::RecordChunk(int32 SessionIndex, int64 NumBytes, double Seconds, bool bSuccess)
+{
+	FScopeLock ScopeLock(&StatsLock);
+
+	if (!Stats.IsValidIndex(SessionIndex))
+		Stats.SetNum(SessionIndex + 1);
+
+	FHoudiniSessionPoolStats& SessionStats = Stats[SessionIndex];
+	SessionStats.NumChunks++;
+	SessionStats.NumBytes += NumBytes;
+	SessionStats.Seconds += Seconds;
+	if (!bSuccess)
+		SessionStats.NumFailures++;
+}
+
+TArray<FHoudiniSessionPoolStats>
+FHoudiniEngineSessionPool::GetStats()
+{
+	FScopeLock ScopeLock(&StatsLock);
+	return Stats;
+}
+
+void
+FHoudiniEngineSessionPool::ResetStats()
+{
+	FScopeLock ScopeLock(&StatsLock);
+	Stats.Empty();
+}
+
+void
+FHoudiniEngineSessionPool::LogStats()
+{
+	const TArray<FHoudiniSessionPoolStats> CurrentStats = GetStats();
+	if (CurrentStats.Num() <= 0)
+	{
+		HOUDINI_LOG_MESSAGE(TEXT("Session Pool: no data transferred."));
+		return;
+	}
+
+	for (int32 SessionIndex = 0; SessionIndex < CurrentStats.Num(); SessionIndex++)
+	{
+		const FHoudiniSessionPoolStats& SessionStats = CurrentStats[SessionIndex];
+		const double MegaBytes = static_cast<double>(SessionStats.NumBytes) / (1024.0 * 1024.0);
+		const double Throughput = SessionStats.Seconds > 0.0 ? MegaBytes / SessionStats.Seconds : 0.0;
+
+		HOUDINI_LOG_MESSAGE(
+			TEXT("Session Pool: session %d - %lld chunks (%lld failed), %.2f MB in %.3fs (%.2f MB/s)"),
+			SessionIndex, SessionStats.NumChunks, SessionStats.NumFailures, MegaBytes, SessionStats.Seconds, Throughput);
+	}
+}
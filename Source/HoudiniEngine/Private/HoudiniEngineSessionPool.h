@@ -0,0 +1,93 @@
+/*
+* Copyright (c) <2024> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAPI/HAPI_Common.h"
+#include "Templates/Function.h"
+
+// Throughput counters for a single HAPI session used by the session pool.
+struct HOUDINIENGINE_API FHoudiniSessionPoolStats
+{
+	// Number of chunks processed on this session.
+	int64 NumChunks = 0;
+	// Number of bytes transferred on this session.
+	int64 NumBytes = 0;
+	// Time spent processing chunks on this session, in seconds.
+	double Seconds = 0.0;
+	// Number of chunks that failed.
+	int64 NumFailures = 0;
+};
+
+// Executes chunked HAPI work across all the available sessions.
+//
+// One worker is started per session, and each worker claims the next chunk from a shared queue until none are left,
+// so sessions that finish early take over the remaining chunks of slower ones. The calling thread processes chunks
+// on the main session, then blocks on the workers' completion events.
+//
+// With multi-session scheduling, the other sessions are also used by their scheduler threads. Each of these sessions
+// has a lock that its scheduler holds while processing a task: the pool's workers skip the sessions that are locked
+// instead of waiting for them, and their chunks are processed by the other sessions.
+class HOUDINIENGINE_API FHoudiniEngineSessionPool
+{
+public:
+
+	// Processes the chunk at ChunkIndex using the given session. Returns true on success.
+	using FChunkWork = TFunctionRef<bool(const HAPI_Session* Session, int32 ChunkIndex)>;
+
+	// Runs NumChunks chunks of work on up to NumSessions sessions.
+	// TotalBytes is the amount of data transferred by all the chunks, used for the throughput counters.
+	// Returns true if all chunks succeeded.
+	static bool ExecuteChunks(int32 NumChunks, int32 NumSessions, int64 TotalBytes, FChunkWork Work);
+
+	// Returns a copy of the throughput counters, indexed by session.
+	static TArray<FHoudiniSessionPoolStats> GetStats();
+
+	// Resets all the throughput counters.
+	static void ResetStats();
+
+	// Prints the throughput counters of all sessions to the log.
+	static void LogStats();
+
+	// Returns the lock giving exclusive use of a session other than the main one, between the pool and its scheduler.
+	static FCriticalSection& GetSessionLock(int32 SessionIndex);
+
+private:
+
+	friend struct FHoudiniSessionPoolWorker;
+
+	static void RecordChunk(int32 SessionIndex, int64 NumBytes, double Seconds, bool bSuccess);
+
+	static FCriticalSection StatsLock;
+
+	static TArray<FHoudiniSessionPoolStats> Stats;
+
+	static FCriticalSection SessionLocksLock;
+
+	// Indexed by session, allocated individually as references to them are handed out.
+	static TArray<TUniquePtr<FCriticalSection>> SessionLocks;
+};
@@ -36,6 +36,7 @@ FHoudiniEngineTask::FHoudiniEngineTask()
 	, bOutputTemplateGeos(false)
 	, AssetLibraryId(-1)
 	, AssetHapiName(-1)
+	, SchedulerAffinity(INDEX_NONE)
 {
 	HapiGUID.Invalidate();
 	OtherNodeIds.Empty();
@@ -50,6 +51,7 @@ FHoudiniEngineTask::FHoudiniEngineTask(EHoudiniEngineTaskType InTaskType, FGuid
 	, bOutputTemplateGeos(false)
 	, AssetLibraryId(-1)
 	, AssetHapiName(-1)
+	, SchedulerAffinity(INDEX_NONE)
 {
 	OtherNodeIds.Empty();
 }
@@ -104,6 +104,11 @@ struct HOUDINIENGINE_API FHoudiniEngineTask
 	// HAPI name of the asset.
 	int32 AssetHapiName;
 
+	// Identifies the HAC node tree this task belongs to.
+	// Tasks sharing the same affinity are always processed, in order, by the same scheduler worker/session.
+	// INDEX_NONE sends the task to the main scheduler.
+	int32 SchedulerAffinity;
+
 	// Is set to true if component has been loaded.
 	//bool bLoadedComponent;
 };
@@ -264,9 +264,9 @@ FHoudiniEngineUtils::GetErrorDescription(HAPI_Result Result)
 }
 
 const FString
-FHoudiniEngineUtils::GetStatusString(HAPI_StatusType status_type, HAPI_StatusVerbosity verbosity)
+FHoudiniEngineUtils::GetStatusString(HAPI_StatusType status_type, HAPI_StatusVerbosity verbosity, const HAPI_Session* InSession)
 {
-	const HAPI_Session* SessionPtr = FHoudiniEngine::Get().GetSession();
+	const HAPI_Session* SessionPtr = InSession ? InSession : FHoudiniEngine::Get().GetSession();
 	if (!SessionPtr)
 	{
 		// No valid session
@@ -323,15 +323,15 @@ FHoudiniEngineUtils::HapiGetString(int32 StringHandle)
 
 
 const FString
-FHoudiniEngineUtils::GetCookResult()
+FHoudiniEngineUtils::GetCookResult(const HAPI_Session* InSession)
 {
-	return FHoudiniEngineUtils::GetStatusString(HAPI_STATUS_COOK_RESULT, HAPI_STATUSVERBOSITY_MESSAGES);
+	return FHoudiniEngineUtils::GetStatusString(HAPI_STATUS_COOK_RESULT, HAPI_STATUSVERBOSITY_MESSAGES, InSession);
 }
 
 const FString
-FHoudiniEngineUtils::GetCookState()
+FHoudiniEngineUtils::GetCookState(const HAPI_Session* InSession)
 {
-	return FHoudiniEngineUtils::GetStatusString(HAPI_STATUS_COOK_STATE, HAPI_STATUSVERBOSITY_ERRORS);
+	return FHoudiniEngineUtils::GetStatusString(HAPI_STATUS_COOK_STATE, HAPI_STATUSVERBOSITY_ERRORS, InSession);
 }
 
 const FString
@@ -4464,42 +4464,41 @@ FHoudiniEngineUtils::HapiSetHeightFieldData(
 	const HAPI_PartId& InPartId,
 	const TArray<float>& InFloatValues,
 	const FString& InHeightfieldName)
+{
+	return HapiSetHeightFieldData(InNodeId, InPartId, InFloatValues.GetData(), 0, InFloatValues.Num(), InHeightfieldName);
+}
+
+HAPI_Result
+FHoudiniEngineUtils::HapiSetHeightFieldData(
+	const HAPI_NodeId& InNodeId,
+	const HAPI_PartId& InPartId,
+	const float* InFloatValues,
+	int32 InStart,
+	int32 InCount,
+	const FString& InHeightfieldName)
 {
     H_SCOPED_FUNCTION_TIMER();
 
-	int32 NumValues = InFloatValues.Num();
-	if (NumValues < 1)
+	if (InCount < 1 || !InFloatValues)
 		return HAPI_RESULT_INVALID_ARGUMENT;
 
 	// Get the volume name as std::string
 	std::string NameStr;
 	FHoudiniEngineUtils::ConvertUnrealString(InHeightfieldName, NameStr);
 
-	// Get the Heighfield float data
-	const float* HeightData = InFloatValues.GetData();
-
+	// Send the heightfield data in chunks if too large for thrift
 	int32 ChunkSize = THRIFT_MAX_CHUNKSIZE;
 	HAPI_Result Result = HAPI_RESULT_FAILURE;
-	if (NumValues > ChunkSize)
+	for (int32 ChunkStart = 0; ChunkStart < InCount; ChunkStart += ChunkSize)
 	{
-		// Send the heightfield data in chunks
-		for (int32 ChunkStart = 0; ChunkStart < NumValues; ChunkStart += ChunkSize)
-		{
-			int32 CurCount = NumValues - ChunkStart > ChunkSize ? ChunkSize : NumValues - ChunkStart;
-			
-			Result = FHoudiniApi::SetHeightFieldData(
-				FHoudiniEngine::Get().GetSession(),
-				InNodeId, InPartId, NameStr.c_str(), &HeightData[ChunkStart], ChunkStart, CurCount);
+		int32 CurCount = InCount - ChunkStart > ChunkSize ? ChunkSize : InCount - ChunkStart;
 
-			if (Result != HAPI_RESULT_SUCCESS)
-				break;
-		}
-	}
-	else
-	{
 		Result = FHoudiniApi::SetHeightFieldData(
 			FHoudiniEngine::Get().GetSession(),
-			InNodeId, InPartId, NameStr.c_str(), HeightData, 0, InFloatValues.Num());
+			InNodeId, InPartId, NameStr.c_str(), &InFloatValues[ChunkStart], InStart + ChunkStart, CurCount);
+
+		if (Result != HAPI_RESULT_SUCCESS)
+			break;
 	}
 
 	return Result;
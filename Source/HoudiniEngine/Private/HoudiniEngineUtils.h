@@ -102,16 +102,17 @@ struct HOUDINIENGINE_API FHoudiniEngineUtils
 		static HAPI_Result HapiCommitGeo(const HAPI_NodeId& InNodeId);
 
 		// Return a specified HAPI status string.
-		static const FString GetStatusString(HAPI_StatusType status_type, HAPI_StatusVerbosity verbosity);
+		// Uses the main session if InSession is null.
+		static const FString GetStatusString(HAPI_StatusType status_type, HAPI_StatusVerbosity verbosity, const HAPI_Session* InSession = nullptr);
 
 		// HAPI : Return the string that corresponds to the given string handle.
 		static FString HapiGetString(int32 StringHandle);
 
 		// Return a string representing cooking result.
-		static const FString GetCookResult();
+		static const FString GetCookResult(const HAPI_Session* InSession = nullptr);
 
 		// Return a string indicating cook state.
-		static const FString GetCookState();
+		static const FString GetCookState(const HAPI_Session* InSession = nullptr);
 
 		// Return a string error description.
 		static const FString GetErrorDescription();
@@ -708,6 +709,15 @@ struct HOUDINIENGINE_API FHoudiniEngineUtils
 			const TArray<float>& InFloatValues,
 			const FString& InHeightfieldName);
 
+		// Same as above, for Count values written at Start in the volume, so that a heightfield can be sent in parts.
+		static HAPI_Result HapiSetHeightFieldData(
+			const HAPI_NodeId& InNodeId,
+			const HAPI_PartId& InPartId,
+			const float* InFloatValues,
+			int32 InStart,
+			int32 InCount,
+			const FString& InHeightfieldName);
+
 		static bool HapiGetParameterDataAsString(
 			const HAPI_NodeId& NodeId,
 			const std::string& ParmName,
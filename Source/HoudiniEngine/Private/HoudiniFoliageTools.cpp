@@ -34,6 +34,7 @@
 #include "HoudiniAssetComponent.h"
 #include "Editor/UnrealEdEngine.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "Components/BrushComponent.h"
 #include "Components/ModelComponent.h"
 #include "LandscapeHeightfieldCollisionComponent.h"
@@ -43,6 +44,7 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Spatial/PointHashGrid3.h"
 #include "Curves/RichCurve.h"
+#include "Hash/CityHash.h"
 
 #if WITH_EDITOR
 #include "EditorModeManager.h"
@@ -212,9 +214,9 @@ TArray<AInstancedFoliageActor*> FHoudiniFoliageTools::SpawnFoliageInstances(UWor
 		for(int InstanceIndex = 0; InstanceIndex < PlacedLevelInstances.Value.Num(); InstanceIndex++)
 		{
 			FFoliageInstance Instance = InstancesToPlace[PlacedLevelInstances.Value[InstanceIndex]];
-			if (AttachmentInfo.Num() > 0)
+			if (AttachmentInfo.IsValidIndex(PlacedLevelInstances.Value[InstanceIndex]))
 			{
-				SetInstanceAttachment(IFA, Info, FoliageSettings, Instance, AttachmentInfo[InstanceIndex]);
+				SetInstanceAttachment(IFA, Info, FoliageSettings, Instance, AttachmentInfo[PlacedLevelInstances.Value[InstanceIndex]]);
 			}
 			Info->AddInstance(FoliageSettings, Instance);
 		}
@@ -234,6 +236,122 @@ TArray<AInstancedFoliageActor*> FHoudiniFoliageTools::SpawnFoliageInstances(UWor
 	return FoliageActors.Array();
 }
 
+uint64
+FHoudiniFoliageTools::GetFoliageInstanceId(const FFoliageInstance& Instance)
+{
+	// Quantize the transform so that values going through a save/load or a float conversion still match
+	const int64 Quantized[9] =
+	{
+		FMath::RoundToInt64(Instance.Location.X * 100.0),
+		FMath::RoundToInt64(Instance.Location.Y * 100.0),
+		FMath::RoundToInt64(Instance.Location.Z * 100.0),
+		FMath::RoundToInt64(Instance.Rotation.Pitch * 100.0),
+		FMath::RoundToInt64(Instance.Rotation.Yaw * 100.0),
+		FMath::RoundToInt64(Instance.Rotation.Roll * 100.0),
+		FMath::RoundToInt64(Instance.DrawScale3D.X * 10000.0),
+		FMath::RoundToInt64(Instance.DrawScale3D.Y * 10000.0),
+		FMath::RoundToInt64(Instance.DrawScale3D.Z * 10000.0)
+	};
+
+	return CityHash64(reinterpret_cast<const char*>(Quantized), sizeof(Quantized));
+}
+
+int32
+FHoudiniFoliageTools::UpdateFoliageInstances(UWorld* InWorld, UFoliageType* Settings, const TArray<FFoliageInstance>& InstancesToPlace, const TArray<FFoliageAttachmentInfo>& AttachmentInfos)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniFoliageTools::UpdateFoliageInstances);
+
+	// Instances that are attached are always respawned, as their final location depends on what is below them.
+	auto CanKeepInstance = [&AttachmentInfos](int32 Index)
+	{
+		return !AttachmentInfos.IsValidIndex(Index) || AttachmentInfos[Index].Type == EFoliageAttachmentType::None;
+	};
+
+	TArray<uint64> NewIds;
+	NewIds.SetNumUninitialized(InstancesToPlace.Num());
+	ParallelFor(InstancesToPlace.Num(), [&](int32 Index)
+	{
+		NewIds[Index] = GetFoliageInstanceId(InstancesToPlace[Index]);
+	});
+
+	// Number of new instances for each id that existing instances can be matched to
+	TMap<uint64, int32> AvailableIds;
+	AvailableIds.Reserve(InstancesToPlace.Num());
+	for (int32 Index = 0; Index < NewIds.Num(); Index++)
+	{
+		if (CanKeepInstance(Index))
+			AvailableIds.FindOrAdd(NewIds[Index])++;
+	}
+
+	// Compute the ids of the existing instances, each FFoliageInfo belongs to a different foliage actor
+	TArray<FFoliageInfo*> FoliageInfos = FHoudiniFoliageTools::GetAllFoliageInfo(InWorld, Settings);
+	TArray<TArray<uint64>> ExistingIds;
+	ExistingIds.SetNum(FoliageInfos.Num());
+	ParallelFor(FoliageInfos.Num(), [&](int32 InfoIndex)
+	{
+		if (FoliageInfos[InfoIndex] == nullptr)
+			return;
+
+		const TArray<FFoliageInstance>& Instances = FoliageInfos[InfoIndex]->Instances;
+		ExistingIds[InfoIndex].SetNumUninitialized(Instances.Num());
+		for (int32 Index = 0; Index < Instances.Num(); Index++)
+			ExistingIds[InfoIndex][Index] = GetFoliageInstanceId(Instances[Index]);
+	});
+
+	// Keep the existing instances that are still wanted, remove the others
+	TMap<uint64, int32> KeptIds;
+	for (int32 InfoIndex = 0; InfoIndex < FoliageInfos.Num(); InfoIndex++)
+	{
+		FFoliageInfo* FoliageInfo = FoliageInfos[InfoIndex];
+		if (FoliageInfo == nullptr)
+			continue;
+
+		TArray<int32> InstancesToRemove;
+		for (int32 Index = 0; Index < ExistingIds[InfoIndex].Num(); Index++)
+		{
+			const uint64 Id = ExistingIds[InfoIndex][Index];
+			int32* AvailableCount = AvailableIds.Find(Id);
+			if (AvailableCount && *AvailableCount > 0)
+			{
+				(*AvailableCount)--;
+				KeptIds.FindOrAdd(Id)++;
+			}
+			else
+			{
+				InstancesToRemove.Add(Index);
+			}
+		}
+
+		if (InstancesToRemove.Num() > 0)
+			FoliageInfo->RemoveInstances(InstancesToRemove, true);
+	}
+
+	// Only spawn the instances that were not matched
+	TArray<FFoliageInstance> InstancesToSpawn;
+	TArray<FFoliageAttachmentInfo> AttachmentsToSpawn;
+	for (int32 Index = 0; Index < InstancesToPlace.Num(); Index++)
+	{
+		if (CanKeepInstance(Index))
+		{
+			int32* KeptCount = KeptIds.Find(NewIds[Index]);
+			if (KeptCount && *KeptCount > 0)
+			{
+				(*KeptCount)--;
+				continue;
+			}
+		}
+
+		InstancesToSpawn.Add(InstancesToPlace[Index]);
+		if (AttachmentInfos.IsValidIndex(Index))
+			AttachmentsToSpawn.Add(AttachmentInfos[Index]);
+	}
+
+	if (InstancesToSpawn.Num() > 0)
+		SpawnFoliageInstances(InWorld, Settings, InstancesToSpawn, AttachmentsToSpawn);
+
+	return InstancesToSpawn.Num();
+}
+
 void
 FHoudiniFoliageTools::RemoveInstancesFromWorld(UWorld* World, UFoliageType* FoliageType)
 {
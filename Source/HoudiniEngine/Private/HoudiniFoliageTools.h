@@ -70,6 +70,14 @@ public:
 	// Spawn the Foliage Instances into the given World/Foliage Type.
 	static TArray<AInstancedFoliageActor*> SpawnFoliageInstances(UWorld* InWorld, UFoliageType* Settings, const TArray<FFoliageInstance>& InstancesToPlace, const TArray<FFoliageAttachmentInfo> & AttachementInfos);
 
+	// Updates the Foliage Instances of the Foliage Type in the given World so they match InstancesToPlace.
+	// Instances already in the world are kept, the others are removed, and only the missing ones are spawned.
+	// Returns the number of spawned instances.
+	static int32 UpdateFoliageInstances(UWorld* InWorld, UFoliageType* Settings, const TArray<FFoliageInstance>& InstancesToPlace, const TArray<FFoliageAttachmentInfo>& AttachmentInfos);
+
+	// Returns an id identifying a Foliage Instance by its transform, used to match instances between cooks.
+	static uint64 GetFoliageInstanceId(const FFoliageInstance& Instance);
+
 	// Returns Foliage Instances used in the given World by the Foliage Type.
 	static TArray<FFoliageInstance> GetAllFoliageInstances(UWorld* InWorld, UFoliageType* Settings);
 
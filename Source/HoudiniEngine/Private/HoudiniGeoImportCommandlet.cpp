@@ -46,6 +46,8 @@
 #include "Rendering/SlateRenderer.h"
 #include "Framework/Application/SlateApplication.h"
 #include "HAL/ThreadManager.h"
+#include "HAL/FileManager.h"
+#include "Async/ParallelFor.h"
 
 #include "HoudiniPackageParams.h"
 #include "HoudiniGeoImporter.h"
@@ -55,6 +57,30 @@
 #include "HoudiniPDGImporterMessages.h"
 #include "HoudiniEngineRuntimeUtils.h"
 
+static TAutoConsoleVariable<float> CVarHoudiniEngineGeoImportWatchSettleTime(
+	TEXT("HoudiniEngine.GeoImportWatchSettleTime"),
+	1.0f,
+	TEXT("In -watch mode, time (in seconds) a discovered file's size must remain unchanged before it is imported.\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineGeoImportWatchBatchSize(
+	TEXT("HoudiniEngine.GeoImportWatchBatchSize"),
+	16,
+	TEXT("In -watch mode, maximum number of files imported per batch. The packages of a batch are saved and unloaded together.\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineGeoImportWatchBatchMaxMB(
+	TEXT("HoudiniEngine.GeoImportWatchBatchMaxMB"),
+	512,
+	TEXT("In -watch mode, maximum total size (in MB) of the files imported per batch. A batch always contains at least one file.\n")
+);
+
+// Number of times the import of a discovered file is attempted
+static const uint32 HoudiniMaxImportAttempts = 3;
+
+// Interval (in seconds) between two checks of the discovered files' sizes
+static const double HoudiniDiscoveredFilesCheckInterval = 0.1;
+
 
 UHoudiniGeoImportCommandlet::UHoudiniGeoImportCommandlet()
 {
@@ -105,6 +131,7 @@ UHoudiniGeoImportCommandlet::UHoudiniGeoImportCommandlet()
 
 	Mode = EHoudiniGeoImportCommandletMode::None;
 	bBakeOutputs = false;
+	NextDiscoveredFilesCheckTime = 0.0;
 }
 
 void UHoudiniGeoImportCommandlet::PrintUsage() const
@@ -153,30 +180,135 @@ void UHoudiniGeoImportCommandlet::PopulatePackageParams(const FString &InBGEOFil
 
 void UHoudiniGeoImportCommandlet::TickDiscoveredFiles()
 {
-	for (auto &FileDataEntry : DiscoveredFiles)
+	const double Now = FPlatformTime::Seconds();
+	if (Now < NextDiscoveredFilesCheckTime)
+		return;
+	NextDiscoveredFilesCheckTime = Now + HoudiniDiscoveredFilesCheckInterval;
+
+	TArray<FDiscoveredFileData*> PendingFiles;
+	for (auto& FileDataEntry : DiscoveredFiles)
 	{
-		FDiscoveredFileData &FileData = FileDataEntry.Value;
+		FDiscoveredFileData& FileData = FileDataEntry.Value;
 		if (FileData.bImportNextTick && !FileData.bImported)
+			PendingFiles.Add(&FileData);
+	}
+
+	if (PendingFiles.Num() <= 0)
+		return;
+
+	// Get the sizes of the pending files in parallel, as the watched directory is often on a network share
+	TArray<int64> FileSizes;
+	FileSizes.SetNumUninitialized(PendingFiles.Num());
+	ParallelFor(PendingFiles.Num(), [&PendingFiles, &FileSizes](int32 Index)
+	{
+		FileSizes[Index] = IFileManager::Get().FileSize(*PendingFiles[Index]->FileName);
+	});
+
+	// Only import the files whose size hasn't changed during the settle time: they are likely fully written
+	const double SettleTime = FMath::Max(CVarHoudiniEngineGeoImportWatchSettleTime.GetValueOnGameThread(), 0.0f);
+	TArray<FDiscoveredFileData*> ReadyFiles;
+	for (int32 Index = 0; Index < PendingFiles.Num(); Index++)
+	{
+		FDiscoveredFileData& FileData = *PendingFiles[Index];
+		if (FileSizes[Index] != FileData.FileSize)
 		{
-			FileData.bImportNextTick = false;
-			FileData.ImportAttempts++;
-			
-			FHoudiniPackageParams PackageParams;
-			PopulatePackageParams(FileData.FileName, PackageParams);
-			TArray<TObjectPtr<UHoudiniOutput>> Outputs;
-			int32 Error = ImportBGEO(FileData.FileName, PackageParams, Outputs);
-			if (Error == 0)
+			FileData.FileSize = FileSizes[Index];
+			FileData.LastChangeTime = Now;
+			continue;
+		}
+
+		// Files that disappeared are removed when the watcher notifies us
+		if (FileData.FileSize <= 0 || Now - FileData.LastChangeTime < SettleTime)
+			continue;
+
+		ReadyFiles.Add(&FileData);
+	}
+
+	if (ReadyFiles.Num() <= 0)
+		return;
+
+	// Import the oldest files first, so files keep being imported in order under a steady inflow
+	ReadyFiles.Sort([](const FDiscoveredFileData& A, const FDiscoveredFileData& B)
+	{
+		return A.LastChangeTime < B.LastChangeTime;
+	});
+
+	// Limit the batch size, as the outputs of the whole batch are kept in memory until its packages are saved
+	const int32 MaxBatchSize = FMath::Max(CVarHoudiniEngineGeoImportWatchBatchSize.GetValueOnGameThread(), 1);
+	const int64 MaxBatchBytes = (int64)FMath::Max(CVarHoudiniEngineGeoImportWatchBatchMaxMB.GetValueOnGameThread(), 0) * 1024 * 1024;
+	TArray<FString> Batch;
+	int64 BatchBytes = 0;
+	for (FDiscoveredFileData* FileData : ReadyFiles)
+	{
+		if (Batch.Num() >= MaxBatchSize)
+			break;
+
+		if (Batch.Num() > 0 && BatchBytes + FileData->FileSize > MaxBatchBytes)
+			continue;
+
+		Batch.Add(FileData->FileName);
+		BatchBytes += FileData->FileSize;
+	}
+
+	HOUDINI_LOG_DISPLAY(TEXT("Importing a batch of %d files (%d ready, %d pending)..."), Batch.Num(), ReadyFiles.Num(), PendingFiles.Num());
+	ImportDiscoveredFiles(Batch);
+}
+
+void UHoudiniGeoImportCommandlet::ImportDiscoveredFiles(const TArray<FString>& InFileNames)
+{
+	TArray<TObjectPtr<UHoudiniOutput>> BatchOutputs;
+	TArray<UPackage*> PackagesToSave;
+	for (const FString& FileName : InFileNames)
+	{
+		FDiscoveredFileData* FileData = DiscoveredFiles.Find(FileName);
+		if (!FileData)
+			continue;
+
+		FileData->bImportNextTick = false;
+		FileData->ImportAttempts++;
+
+		FHoudiniPackageParams PackageParams;
+		PopulatePackageParams(FileName, PackageParams);
+		TArray<TObjectPtr<UHoudiniOutput>> Outputs;
+		int32 Error = ImportBGEO(FileName, PackageParams, Outputs, nullptr, nullptr, nullptr, nullptr, &PackagesToSave);
+		BatchOutputs.Append(Outputs);
+
+		// Look the entry up again, as the map can change while importing
+		FileData = DiscoveredFiles.Find(FileName);
+		if (!FileData)
+			continue;
+
+		if (Error == 0)
+		{
+			FileData->bImported = true;
+			HOUDINI_LOG_DISPLAY(TEXT("Importing %s... Done"), *FileData->FileName);
+		}
+		else
+		{
+			FileData->bImported = false;
+			HOUDINI_LOG_DISPLAY(TEXT("Importing %s... Failed (%d)"), *FileData->FileName, Error);
+
+			// Try again once the settle time has elapsed
+			if (FileData->ImportAttempts < HoudiniMaxImportAttempts)
 			{
-				FileData.bImported = true;
-				HOUDINI_LOG_DISPLAY(TEXT("Importing %s... Done"), *FileData.FileName);
+				FileData->bImportNextTick = true;
+				FileData->LastChangeTime = FPlatformTime::Seconds();
 			}
 			else
 			{
-				FileData.bImported = false;
-				HOUDINI_LOG_DISPLAY(TEXT("Importing %s... Failed (%d)"), *FileData.FileName, Error);
+				HOUDINI_LOG_WARNING(TEXT("Not importing %s, max attempts exceeded %d"), *FileData->FileName, FileData->ImportAttempts);
 			}
 		}
 	}
+
+	if (PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	}
+
+	// Release the batch's objects before importing the next one
+	ReleaseOutputs(BatchOutputs);
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
 }
 
 int32 UHoudiniGeoImportCommandlet::MainLoop()
@@ -374,13 +506,23 @@ UHoudiniGeoImportCommandlet::HandleImportBGEOMessage(
 	{
 		HOUDINI_LOG_WARNING(TEXT("BGEO import failed."));
 		FHoudiniPDGImportBGEOResultMessage* Reply = new FHoudiniPDGImportBGEOResultMessage();
+		// Identify the import, so the manager can release the work result and balance its pool
+		(*Reply) = InMessage;
 		Reply->ImportResult = EHoudiniPDGImportBGEOResult::HPIBR_Failed;
 		PDGEndpoint->Send(Reply, InContext->GetSender());
 	}
 
 	// Cleanup the outputs (remove from root)
+	ReleaseOutputs(Outputs);
+	OutputObjectAttributes.Empty();
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+void UHoudiniGeoImportCommandlet::ReleaseOutputs(TArray<TObjectPtr<UHoudiniOutput>>& InOutputs)
+{
 	TArray<UPackage*> PackagesToUnload;
-	for (UHoudiniOutput *CurOutput : Outputs)
+	for (UHoudiniOutput *CurOutput : InOutputs)
 	{
 		if (!IsValid(CurOutput))
 			continue;
@@ -392,7 +534,7 @@ UHoudiniGeoImportCommandlet::HandleImportBGEOMessage(
 				UPackage *Outermost = Entry.Value.OutputObject->GetOutermost();
 				if (IsValid(Outermost))
 				{
-					PackagesToUnload.Add(Outermost);
+					PackagesToUnload.AddUnique(Outermost);
 				}
 				
 				Entry.Value.OutputObject->RemoveFromRoot();
@@ -401,8 +543,7 @@ UHoudiniGeoImportCommandlet::HandleImportBGEOMessage(
 
 		CurOutput->RemoveFromRoot();
 	}
-	Outputs.Empty();
-	OutputObjectAttributes.Empty();
+	InOutputs.Empty();
 
 	if (PackagesToUnload.Num() > 0)
 	{
@@ -416,10 +557,7 @@ UHoudiniGeoImportCommandlet::HandleImportBGEOMessage(
 		{
 			HOUDINI_LOG_DISPLAY(TEXT("Unloading %d packages ... Success"), PackagesToUnload.Num());
 		}
-		PackagesToUnload.Empty();
 	}
-
-	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
 }
 
 bool UHoudiniGeoImportCommandlet::StartHoudiniEngineSession()
@@ -427,9 +565,13 @@ bool UHoudiniGeoImportCommandlet::StartHoudiniEngineSession()
 	// Start Houdini Engine session
 	HOUDINI_LOG_DISPLAY(TEXT("Starting Houdini Engine session..."));
 	FHoudiniEngine& HoudiniEngine = FHoudiniEngine::Get();
+	// The PDG manager can run several commandlets at once, each needs its own pipe
+	const FString PipeName = Guid.IsValid()
+		? FString::Printf(TEXT("hapi_bgeo_cmdlet_%s"), *Guid.ToString(EGuidFormats::Short))
+		: FString(TEXT("hapi_bgeo_cmdlet"));
 	if (!HoudiniEngine.CreateSession(
 		EHoudiniRuntimeSettingsSessionType::HRSST_NamedPipe,
-		"hapi_bgeo_cmdlet"))
+		FName(*PipeName)))
 	{
 		HOUDINI_LOG_ERROR(TEXT("Failed to start Houdini Engine session."));
 		return false;
@@ -445,7 +587,8 @@ int32 UHoudiniGeoImportCommandlet::ImportBGEO(
 	const FHoudiniStaticMeshGenerationProperties* InStaticMeshGenerationProperties,
 	const FMeshBuildSettings* InMeshBuildSettings,
 	TMap<FHoudiniOutputObjectIdentifier, TArray<FHoudiniGenericAttribute>>* OutGenericAttributes,
-	TMap<FHoudiniOutputObjectIdentifier, FHoudiniInstancedOutputPartData>* OutInstancedOutputPartData)
+	TMap<FHoudiniOutputObjectIdentifier, FHoudiniInstancedOutputPartData>* OutInstancedOutputPartData,
+	TArray<UPackage*>* OutPackagesToSave)
 {
 	if (!IsHoudiniEngineSessionRunning() && !StartHoudiniEngineSession())
 	{
@@ -609,7 +752,13 @@ int32 UHoudiniGeoImportCommandlet::ImportBGEO(
 		}
 	}
 
-	if (PackagesToSave.Num() > 0)
+	// Let the caller save the packages of a whole batch at once
+	if (OutPackagesToSave)
+	{
+		for (UPackage* Package : PackagesToSave)
+			OutPackagesToSave->AddUnique(Package);
+	}
+	else if (PackagesToSave.Num() > 0)
 	{
 		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
 	}
@@ -632,7 +781,7 @@ void UHoudiniGeoImportCommandlet::HandleDirectoryChanged(const TArray<FFileChang
 		if (BGEOMatcher.FindNext() && BGEOMatcher.GetCaptureGroup(2).StartsWith(TEXT("bgeo")))
 		{
 			HOUDINI_LOG_DISPLAY(TEXT("Updating entry for %s..."), *FileChangeData.Filename);
-			const uint32 MaxImportAttempts = 3;
+			// Events are only recorded here, the files are imported in batches by TickDiscoveredFiles once they are fully written
 			switch(FileChangeData.Action)
 			{
 				case FFileChangeData::FCA_Added:
@@ -640,9 +789,10 @@ void UHoudiniGeoImportCommandlet::HandleDirectoryChanged(const TArray<FFileChang
 					if (DiscoveredFiles.Contains(FileChangeData.Filename))
 					{
 						FDiscoveredFileData &FileData = DiscoveredFiles[FileChangeData.Filename];
-						if (!FileData.bImported && FileData.ImportAttempts < MaxImportAttempts)
+						FileData.LastChangeTime = FPlatformTime::Seconds();
+						if (!FileData.bImported && FileData.ImportAttempts < HoudiniMaxImportAttempts)
 							FileData.bImportNextTick = true;
-						else if (FileData.ImportAttempts >= MaxImportAttempts)
+						else if (FileData.ImportAttempts >= HoudiniMaxImportAttempts)
 							HOUDINI_LOG_WARNING(TEXT("Not importing %s, max attempts exceeded %d"), *FileData.FileName, FileData.ImportAttempts);
 					}
 					else
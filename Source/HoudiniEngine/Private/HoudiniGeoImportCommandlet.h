@@ -42,6 +42,7 @@ class FSocket;
 
 class UHoudiniGeoImporter;
 class UHoudiniOutput;
+class UPackage;
 
 struct FHoudiniPackageParams;
 
@@ -60,16 +61,16 @@ enum class EHoudiniGeoImportCommandletMode : uint8
 struct FDiscoveredFileData
 {
 public:
-	FDiscoveredFileData() : FileName(), bImportNextTick(false), ImportAttempts(0), bImported(false) {}
+	FDiscoveredFileData() : FileName(), bImportNextTick(false), ImportAttempts(0), bImported(false), FileSize(-1), LastChangeTime(0.0) {}
 
-	FDiscoveredFileData(const FString& InFileName, bool bInImportNextTick=false) : FileName(InFileName), bImportNextTick(bInImportNextTick), ImportAttempts(0), bImported(false) {}
+	FDiscoveredFileData(const FString& InFileName, bool bInImportNextTick=false) : FileName(InFileName), bImportNextTick(bInImportNextTick), ImportAttempts(0), bImported(false), FileSize(-1), LastChangeTime(FPlatformTime::Seconds()) {}
 
-	FDiscoveredFileData(FString&& InFileName, bool bInImportNextTick=false) : FileName(InFileName), bImportNextTick(bInImportNextTick), ImportAttempts(0), bImported(false) {}
+	FDiscoveredFileData(FString&& InFileName, bool bInImportNextTick=false) : FileName(InFileName), bImportNextTick(bInImportNextTick), ImportAttempts(0), bImported(false), FileSize(-1), LastChangeTime(FPlatformTime::Seconds()) {}
 	
 	// Full/absolute file path
 	FString FileName;
 
-	// Try to import this file on the next tick
+	// Import this file once it is fully written
 	bool bImportNextTick;
 
 	// Number of attempts at importing this file
@@ -77,6 +78,12 @@ public:
 
 	// The file has been imported successfully
 	bool bImported;
+
+	// Size of the file when it was last checked, -1 if unknown
+	int64 FileSize;
+
+	// Time of the last change event or size change. The file is imported once its size has been stable for a while.
+	double LastChangeTime;
 };
 
 UCLASS()
@@ -120,10 +127,18 @@ protected:
 		const FHoudiniStaticMeshGenerationProperties* InStaticMeshGenerationProperties=nullptr,
 		const FMeshBuildSettings* InMeshBuildSettings=nullptr,
 		TMap<FHoudiniOutputObjectIdentifier, TArray<FHoudiniGenericAttribute>>* OutGenericAttributes=nullptr,
-		TMap<FHoudiniOutputObjectIdentifier, FHoudiniInstancedOutputPartData>* OutInstancedOutputPartData=nullptr);
+		TMap<FHoudiniOutputObjectIdentifier, FHoudiniInstancedOutputPartData>* OutInstancedOutputPartData=nullptr,
+		TArray<UPackage*>* OutPackagesToSave=nullptr);
 
+	// Removes the outputs and their objects from the root set and unloads their packages
+	void ReleaseOutputs(TArray<TObjectPtr<UHoudiniOutput>>& InOutputs);
+
+	// Imports the next batch of discovered files that are fully written
 	void TickDiscoveredFiles();
 
+	// Imports a batch of discovered files, saves their packages at once and releases them
+	void ImportDiscoveredFiles(const TArray<FString>& InFileNames);
+
 private:
 
 	// Messaging end point for receiving messages from PDG manager
@@ -146,6 +161,8 @@ private:
 
 	// Keep track of files discovered by the watcher, and their state
 	TMap<FString, FDiscoveredFileData> DiscoveredFiles;
+	// Time at which the sizes of the discovered files are checked next
+	double NextDiscoveredFilesCheckTime;
 
 	// Mode in which commandlet is running
 	EHoudiniGeoImportCommandletMode Mode;
@@ -44,6 +44,7 @@
 #include "HoudiniGeometryCollectionTranslator.h"
 #include "HoudiniSplineComponent.h"
 #include "HoudiniEngineRuntimeUtils.h"
+#include "HoudiniOutputPrefetchCache.h"
 
 #include "CoreMinimal.h"
 #include "Misc/Paths.h"
@@ -55,6 +56,63 @@
 
 #include "Materials/MaterialInterface.h"
 #include "Materials/Material.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/ScopeExit.h"
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineGeoImportDirectIngestion(
+	TEXT("HoudiniEngine.GeoImportDirectIngestion"),
+	1,
+	TEXT("How the BGEO importer loads files and reads their geometry.\n")
+	TEXT("0: Load the file with the File SOP and read the attributes while creating the objects\n")
+	TEXT("1: Prefetch the attributes before creating the objects. With an in-process session, the file is memory mapped and loaded from memory (default)\n")
+	TEXT("2: Same as 1, but always load the file from memory, even though it has to be copied to out-of-process sessions\n")
+);
+
+// Returns true if geo files should be memory mapped and loaded from memory rather than by the File SOP.
+// Out-of-process sessions read the file themselves, which is cheaper than sending its content through the session.
+static bool
+HoudiniShouldLoadGeoFromMemory()
+{
+	const int32 Mode = CVarHoudiniEngineGeoImportDirectIngestion.GetValueOnAnyThread();
+	if (Mode <= 0)
+		return false;
+
+	if (Mode >= 2)
+		return true;
+
+	const HAPI_Session* Session = FHoudiniEngine::Get().GetSession();
+	return Session && Session->type == HAPI_SESSION_INPROCESS;
+}
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineGeoImportPrefetchMaxMB(
+	TEXT("HoudiniEngine.GeoImportPrefetchMaxMB"),
+	2048,
+	TEXT("Maximum amount of attribute data (in MB) prefetched per imported file. Remaining data is read while creating the objects.\n")
+);
+
+// Returns the format HAPI expects when loading a geo file from memory ("bgeo", "bgeo.sc"...), or an empty string
+// if the file's extension isn't a known geo format. Only the end of the name is matched, as PDG outputs are usually
+// named like "geo.0001.bgeo.sc".
+static FString
+HoudiniGetGeoFileFormat(const FString& InFilePath)
+{
+	// Longest suffixes first, so compressed formats are matched before their uncompressed counterpart
+	static const TCHAR* const KnownFormats[] = {
+		TEXT("bgeo.sc"), TEXT("bgeo.gz"), TEXT("bgeo.lzma"), TEXT("bgeo.bz2"),
+		TEXT("geo.sc"), TEXT("geo.gz"),
+		TEXT("bgeo"), TEXT("geo")
+	};
+
+	const FString CleanFilename = FPaths::GetCleanFilename(InFilePath);
+	for (const TCHAR* const Format : KnownFormats)
+	{
+		if (CleanFilename.EndsWith(FString(TEXT(".")) + Format, ESearchCase::IgnoreCase))
+			return Format;
+	}
+
+	return FString();
+}
 
 
 UHoudiniGeoImporter::UHoudiniGeoImporter(const FObjectInitializer & ObjectInitializer)
@@ -152,8 +210,32 @@ UHoudiniGeoImporter::BuildOutputsForNode(
 	FString Notification = TEXT("BGEO Importer: Getting output geos...");
 	FHoudiniEngine::Get().UpdateTaskSlateNotification(FText::FromString(Notification));
 
+	// Read the attributes of the node's parts in one go, the translators will then read them from the cache
+	// instead of querying the session for every attribute. The cache is kept until the objects are created.
+	OutputPrefetchCache.Reset();
+	if (CVarHoudiniEngineGeoImportDirectIngestion.GetValueOnAnyThread() > 0)
+	{
+		TArray<HAPI_NodeId> OutputNodes;
+		FHoudiniEngineUtils::GatherAllAssetOutputs(InNodeId, bInUseOutputNodes, false, true, OutputNodes);
+
+		const int64 MaxBytes = (int64)FMath::Max(CVarHoudiniEngineGeoImportPrefetchMaxMB.GetValueOnAnyThread(), 0) * 1024 * 1024;
+		OutputPrefetchCache = FHoudiniOutputPrefetchCache::Fetch(OutputNodes, MaxBytes);
+	}
+
+	FHoudiniOutputPrefetchCache::SetActive(OutputPrefetchCache);
+	ON_SCOPE_EXIT
+	{
+		FHoudiniOutputPrefetchCache::SetActive(nullptr);
+	};
+
 	const bool bInAddOutputsToRootSet = true;
-	return BuildAllOutputsForNode(InNodeId, this, InOldOutputs, OutNewOutputs, bInAddOutputsToRootSet, bInUseOutputNodes);
+	if (!BuildAllOutputsForNode(InNodeId, this, InOldOutputs, OutNewOutputs, bInAddOutputsToRootSet, bInUseOutputNodes))
+	{
+		OutputPrefetchCache.Reset();
+		return false;
+	}
+
+	return true;
 }
 
 bool UHoudiniGeoImporter::CreateObjectsFromOutputs(
@@ -163,6 +245,14 @@ bool UHoudiniGeoImporter::CreateObjectsFromOutputs(
 	const FMeshBuildSettings& InMeshBuildSettings,
 	TMap<FHoudiniOutputObjectIdentifier, FHoudiniInstancedOutputPartData>* OutInstancedOutputPartData)
 {
+	// Use the attributes prefetched by BuildOutputsForNode, if any. They are released once the objects are created.
+	FHoudiniOutputPrefetchCache::SetActive(OutputPrefetchCache);
+	ON_SCOPE_EXIT
+	{
+		FHoudiniOutputPrefetchCache::SetActive(nullptr);
+		OutputPrefetchCache.Reset();
+	};
+
 	//
 	// This isn't ideal but the reason we do this is because previously each 
 	// method we call (i.e. CreateCurves) would filter the outputs we pass in.
@@ -981,13 +1071,53 @@ UHoudiniGeoImporter::OpenBGEOFile(const FString& InBGEOFile, HAPI_NodeId& OutNod
 		FHoudiniEngine::Get().GetSession(), OutNodeId, ConvertedString.c_str(), ParmId, 0), false);
 	*/
 
-	// Simply use LoadGeoFrom file
+	// Load the file from memory if possible, or simply use LoadGeoFromFile
+	if (HoudiniShouldLoadGeoFromMemory() && LoadGeoFromMappedFile(OutNodeId, AbsoluteFilePath))
+		return true;
+
 	std::string ConvertedString = TCHAR_TO_UTF8(*AbsoluteFilePath);
 	FHoudiniApi::LoadGeoFromFile(FHoudiniEngine::Get().GetSession(), OutNodeId, ConvertedString.c_str());
 
 	return true;
 }
 
+bool
+UHoudiniGeoImporter::LoadGeoFromMappedFile(const HAPI_NodeId& InNodeId, const FString& InFilePath)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UHoudiniGeoImporter::LoadGeoFromMappedFile);
+
+	if (InNodeId < 0 || InFilePath.IsEmpty())
+		return false;
+
+	const FString FileFormat = HoudiniGetGeoFileFormat(InFilePath);
+	if (FileFormat.IsEmpty())
+		return false;
+
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*InFilePath));
+	if (!MappedFile.IsValid())
+		return false;
+
+	// HAPI takes the buffer length as an int, bigger files have to be loaded by the File SOP
+	const int64 FileSize = MappedFile->GetFileSize();
+	if (FileSize <= 0 || FileSize > MAX_int32)
+		return false;
+
+	TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion(0, FileSize, true));
+	if (!MappedRegion.IsValid())
+		return false;
+
+	const std::string Format = TCHAR_TO_UTF8(*FileFormat);
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::LoadGeoFromMemory(
+		FHoudiniEngine::Get().GetSession(), InNodeId, Format.c_str(),
+		reinterpret_cast<const char*>(MappedRegion->GetMappedPtr()), (int)MappedRegion->GetMappedSize()))
+	{
+		HOUDINI_LOG_MESSAGE(TEXT("Houdini GEO Importer: could not load %s from memory: %s"), *InFilePath, *FHoudiniEngineUtils::GetErrorDescription());
+		return false;
+	}
+
+	return true;
+}
+
 bool
 UHoudiniGeoImporter::MergeGeoFromNode(const FString& InNodePath, HAPI_NodeId& OutNodeId)
 {
@@ -1084,6 +1214,16 @@ UHoudiniGeoImporter::LoadBGEOFileInHAPI(HAPI_NodeId& NodeId)
 		FHoudiniEngine::Get().GetSession(), NodeId, ConvertedString.c_str(), ParmId, 0), false);
 	*/
 
+	// Load the file from memory if possible, which avoids going through the File SOP and polling its cook
+	if (HoudiniShouldLoadGeoFromMemory() && LoadGeoFromMappedFile(NodeId, AbsoluteFilePath))
+	{
+		HAPI_CookOptions CookOptions = FHoudiniEngine::GetDefaultCookOptions();
+		if (FHoudiniEngineUtils::HapiCookNode(NodeId, &CookOptions, true))
+			return true;
+
+		HOUDINI_LOG_MESSAGE(TEXT("Houdini GEO Importer: failed to cook %s loaded from memory, loading it from file."), *AbsoluteFilePath);
+	}
+
 	// Simply use LoadGeoFrom file
 	std::string ConvertedString = TCHAR_TO_UTF8(*AbsoluteFilePath);
 	FHoudiniApi::LoadGeoFromFile(FHoudiniEngine::Get().GetSession(), NodeId, ConvertedString.c_str());
@@ -31,6 +31,7 @@
 #include "HoudiniGeoImporter.generated.h"
 
 class UHoudiniOutput;
+class FHoudiniOutputPrefetchCache;
 
 struct FHoudiniPackageParams;
 struct FHoudiniStaticMeshGenerationProperties;
@@ -92,6 +93,10 @@ public:
 	// 3. Creates a new file node and loads the bgeo file in HAPI
 	bool LoadBGEOFileInHAPI(HAPI_NodeId& NodeId);
 
+	// 3.1 (alternative) Loads a memory mapped geo file on an existing node, without going through the File SOP.
+	// Returns false if the file couldn't be mapped or loaded, in which case LoadGeoFromFile should be used.
+	static bool LoadGeoFromMappedFile(const HAPI_NodeId& InNodeId, const FString& InFilePath);
+
 	// 3.2 (alternative) Uses an object merge node to load the geo data in HAPI (used for node sync fetch)
 	bool MergeGeoFromNode(const FString& InNodePath, HAPI_NodeId& OutNodeId);
 
@@ -179,4 +184,7 @@ private:
 
 	// Output Objects
 	TArray<UObject*> OutputObjects;
+
+	// Attributes of the outputs, read by BuildOutputsForNode and released by CreateObjectsFromOutputs
+	TSharedPtr<FHoudiniOutputPrefetchCache> OutputPrefetchCache;
 };
@@ -30,6 +30,7 @@
 #include "HoudiniEngineRuntimeUtils.h"
 #include "HoudiniEngineString.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniEngineCookStats.h"
 #include "HoudiniEnginePrivatePCH.h"
 #include "HoudiniGenericAttribute.h"
 #include "HoudiniInstancedActorComponent.h"
@@ -50,12 +51,15 @@
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "InstancedFoliageActor.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
 	#include "GeometryCollection/GeometryCollectionComponent.h"
 #else
 	#include "GeometryCollectionEngine/Public/GeometryCollection/GeometryCollectionComponent.h"
 #endif
 #include "FoliageEditUtility.h"
+#include "EngineUtils.h"
 #include "LevelInstance/LevelInstanceActor.h"
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1
 #include "LevelInstance/LevelInstanceComponent.h"
@@ -76,6 +80,22 @@
 
 #define LOCTEXT_NAMESPACE HOUDINI_LOCTEXT_NAMESPACE
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineInstancerDeltaUpdates(
+	TEXT("HoudiniEngine.InstancerDeltaUpdates"),
+	1,
+	TEXT("Controls how the instances of existing instanced static mesh components are updated after a cook.\n")
+	TEXT("0: Clear and re-add all instances when the instance count changes\n")
+	TEXT("1: Only update the instances whose transform changed, and add/remove the extra instances (default)\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineIncrementalFoliage(
+	TEXT("HoudiniEngine.IncrementalFoliage"),
+	1,
+	TEXT("Controls how foliage outputs are updated after a cook.\n")
+	TEXT("0: Remove all the foliage instances of the output and spawn them again\n")
+	TEXT("1: Keep the foliage instances that did not change, only remove/spawn the others (default)\n")
+);
+
 // Fastrand is a faster alternative to std::rand()
 // and doesn't oscillate when looking for 2 values like Unreal's.
 inline int fastrand(int& nSeed)
@@ -217,6 +237,11 @@ FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutputs(
 	if (!ParentComponent)
 		return false;
 
+	// When updating foliage incrementally, the previous foliage types are kept in the world until we know whether
+	// they are reused by the new outputs, their instances are then updated in CreateOrUpdateFoliageInstances().
+	const bool bIncrementalFoliage = CVarHoudiniEngineIncrementalFoliage.GetValueOnGameThread() > 0;
+	TMap<UFoliageType*, UWorld*> PreviousFoliageTypes;
+
     int InstanceCount = 0;
 	for (auto Output : OutputsToUpdate)
 	{
@@ -231,7 +256,12 @@ FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutputs(
 
 			for(auto & OutputComponent : OutputObject.Value.OutputComponents)
 			{
-				if (OutputComponent)
+				if (!OutputComponent)
+					continue;
+
+				if (bIncrementalFoliage)
+					PreviousFoliageTypes.Add(OutputObject.Value.FoliageType, OutputComponent->GetWorld());
+				else
 					FHoudiniFoliageUtils::RemoveFoliageTypeFromWorld(OutputComponent->GetWorld(), OutputObject.Value.FoliageType);
 			}
 		}
@@ -249,6 +279,22 @@ FHoudiniInstanceTranslator::CreateAllInstancersFromHoudiniOutputs(
 			++InstanceCount;
 	}
 
+	// Remove the previous foliage types that are not used anymore
+	if (PreviousFoliageTypes.Num() > 0)
+	{
+		for (auto Output : OutputsToUpdate)
+		{
+			if (Output->GetType() != EHoudiniOutputType::Instancer)
+				continue;
+
+			for (const auto& OutputObject : Output->GetOutputObjects())
+				PreviousFoliageTypes.Remove(OutputObject.Value.FoliageType);
+		}
+
+		for (const auto& PreviousFoliageType : PreviousFoliageTypes)
+			FHoudiniFoliageUtils::RemoveFoliageTypeFromWorld(PreviousFoliageType.Value, PreviousFoliageType.Key);
+	}
+
 	if (FoliageTypeCount > 0)
 	{
 		FHoudiniEngineUtils::RepopulateFoliageTypeListInUI();
@@ -1215,6 +1261,10 @@ FHoudiniInstanceTranslator::UpdateInstanceVariationObjects(
 			if (CurInstancedOutput.TransformVariationIndices.Num() != CurInstancedOutput.OriginalTransforms.Num())
 				UpdateVariationAssignements(CurInstancedOutput);
 
+			// Get the transforms assigned to each variation
+			TArray<TArray<FTransform>> VariationTransforms;
+			ProcessInstanceTransforms(CurInstancedOutput, VariationTransforms);
+
 			// Assign variations and their transforms
 			for (int32 VarIdx = 0; VarIdx < CurInstancedOutput.VariationObjects.Num(); VarIdx++)
 			{
@@ -1222,13 +1272,10 @@ FHoudiniInstanceTranslator::UpdateInstanceVariationObjects(
 				if (!IsValid(CurrentVariationObject))
 					continue;
 
-				// Get the transforms assigned to that variation
-				TArray<FTransform> ProcessedTransforms;
-				ProcessInstanceTransforms(CurInstancedOutput, VarIdx, ProcessedTransforms);
-				if (ProcessedTransforms.Num() > 0)
+				if (VariationTransforms[VarIdx].Num() > 0)
 				{
 					OutVariationsInstancedObjects.Add(CurrentVariationObject);
-					OutVariationsInstancedTransforms.Add(ProcessedTransforms);
+					OutVariationsInstancedTransforms.Add(MoveTemp(VariationTransforms[VarIdx]));
 					OutVariationOriginalObjectIdx.Add(InstObjIdx);
 					OutVariationIndices.Add(VarIdx);
 				}
@@ -1260,54 +1307,71 @@ FHoudiniInstanceTranslator::UpdateVariationAssignements(FHoudiniInstancedOutput&
 
 void
 FHoudiniInstanceTranslator::ProcessInstanceTransforms(
-	FHoudiniInstancedOutput& InstancedOutput, const int32& VariationIdx, TArray<FTransform>& OutProcessedTransforms)
+	const FHoudiniInstancedOutput& InstancedOutput, TArray<TArray<FTransform>>& OutVariationTransforms)
 {
-	if (!InstancedOutput.VariationObjects.IsValidIndex(VariationIdx))
-		return;
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniInstanceTranslator::ProcessInstanceTransforms);
 
-	if (!InstancedOutput.VariationTransformOffsets.IsValidIndex(VariationIdx))
+	const int32 VariationCount = InstancedOutput.VariationObjects.Num();
+	OutVariationTransforms.SetNum(VariationCount);
+	if (VariationCount <= 0)
 		return;
 
-	bool bHasVariations = InstancedOutput.VariationObjects.Num() > 1;
-	bool bHasTransformOffset = InstancedOutput.VariationTransformOffsets.IsValidIndex(VariationIdx)
-		? !InstancedOutput.VariationTransformOffsets[VariationIdx].Equals(FTransform::Identity)
-		: false;
-
-	if (!bHasVariations && !bHasTransformOffset)
+	const TArray<FTransform>& OriginalTransforms = InstancedOutput.OriginalTransforms;
+	if (VariationCount == 1)
 	{
-		// We dont have variations or transform offset, so we can reuse the original transforms as is
-		OutProcessedTransforms = InstancedOutput.OriginalTransforms;
-		return;
+		// We dont have variations, so we can reuse the original transforms as is
+		OutVariationTransforms[0] = OriginalTransforms;
 	}
-
-	if (bHasVariations)
+	else
 	{
-		// We simply need to extract the transforms for this variation		
-		for (int32 TransformIndex = 0; TransformIndex < InstancedOutput.TransformVariationIndices.Num(); TransformIndex++)
+		// Bucket the transforms by variation in a single pass over the original transforms:
+		// count the transforms of each variation first so every bucket is allocated only once.
+		const TArray<int32>& TransformVariationIndices = InstancedOutput.TransformVariationIndices;
+		const int32 TransformCount = FMath::Min(TransformVariationIndices.Num(), OriginalTransforms.Num());
+
+		TArray<int32> VariationTransformCounts;
+		VariationTransformCounts.SetNumZeroed(VariationCount);
+		for (int32 TransformIndex = 0; TransformIndex < TransformCount; TransformIndex++)
 		{
-			if (InstancedOutput.TransformVariationIndices[TransformIndex] != VariationIdx)
-				continue;
+			const int32 VariationIdx = TransformVariationIndices[TransformIndex];
+			if (VariationTransformCounts.IsValidIndex(VariationIdx))
+				VariationTransformCounts[VariationIdx]++;
+		}
+
+		for (int32 VariationIdx = 0; VariationIdx < VariationCount; VariationIdx++)
+			OutVariationTransforms[VariationIdx].Reset(VariationTransformCounts[VariationIdx]);
 
-			OutProcessedTransforms.Add(InstancedOutput.OriginalTransforms[TransformIndex]);
+		for (int32 TransformIndex = 0; TransformIndex < TransformCount; TransformIndex++)
+		{
+			const int32 VariationIdx = TransformVariationIndices[TransformIndex];
+			if (OutVariationTransforms.IsValidIndex(VariationIdx))
+				OutVariationTransforms[VariationIdx].Add(OriginalTransforms[TransformIndex]);
 		}
 	}
-	else
-	{
-		// No variations, we can reuse the original transforms
-		OutProcessedTransforms = InstancedOutput.OriginalTransforms;
-	}
 
-	if (bHasTransformOffset)
+	// Apply the transform offsets, variations are independent so they are processed in parallel
+	ParallelFor(VariationCount, [&InstancedOutput, &OutVariationTransforms](int32 VariationIdx)
 	{
+		TArray<FTransform>& ProcessedTransforms = OutVariationTransforms[VariationIdx];
+		if (!InstancedOutput.VariationTransformOffsets.IsValidIndex(VariationIdx))
+		{
+			ProcessedTransforms.Empty();
+			return;
+		}
+
+		const FTransform& TransformOffset = InstancedOutput.VariationTransformOffsets[VariationIdx];
+		if (TransformOffset.Equals(FTransform::Identity))
+			return;
+
 		// Get the transform offset for this variation
-		FVector PositionOffset = InstancedOutput.VariationTransformOffsets[VariationIdx].GetLocation();
-		FQuat RotationOffset = InstancedOutput.VariationTransformOffsets[VariationIdx].GetRotation();
-		FVector ScaleOffset = InstancedOutput.VariationTransformOffsets[VariationIdx].GetScale3D();
+		FVector PositionOffset = TransformOffset.GetLocation();
+		FQuat RotationOffset = TransformOffset.GetRotation();
+		FVector ScaleOffset = TransformOffset.GetScale3D();
 
 		FTransform CurrentTransform = FTransform::Identity;
-		for (int32 TransformIndex = 0; TransformIndex < OutProcessedTransforms.Num(); TransformIndex++)
+		for (int32 TransformIndex = 0; TransformIndex < ProcessedTransforms.Num(); TransformIndex++)
 		{
-			CurrentTransform = OutProcessedTransforms[TransformIndex];
+			CurrentTransform = ProcessedTransforms[TransformIndex];
 
 			// Compute new rotation and scale.
 			FVector Position = CurrentTransform.GetLocation() + PositionOffset;
@@ -1331,9 +1395,9 @@ FHoudiniInstanceTranslator::ProcessInstanceTransforms(
 			CurrentTransform.SetScale3D(TransformScale3D);
 
 			if (CurrentTransform.IsValid())
-				OutProcessedTransforms[TransformIndex] = CurrentTransform;
+				ProcessedTransforms[TransformIndex] = CurrentTransform;
 		}
-	}
+	}, VariationCount <= 1);
 }
 
 bool
@@ -2129,6 +2193,8 @@ FHoudiniInstanceTranslator::CreateOrUpdateInstancer(
 	bool bForceHISM,
 	bool bForceInstancer)
 {
+	H_SCOPED_COOK_STAT(EHoudiniCookStage::Components);
+
 	// See if we can reuse the old component
 	InstancerComponentType OldType = GetComponentsType(OldComponents);
 
@@ -2434,7 +2500,12 @@ FHoudiniInstanceTranslator::CreateOrUpdateInstancedStaticMeshComponent(
 
 	int32 NumOldInstances = InstancedStaticMeshComponent->GetInstanceCount();
 	int32 NumNewInstances = InstancedObjectTransforms.Num();
-	if (NumOldInstances == NumNewInstances)
+	if (NumOldInstances > 0 && CVarHoudiniEngineInstancerDeltaUpdates.GetValueOnGameThread() > 0)
+	{
+		// Only send the instances that actually changed
+		UpdateInstancedStaticMeshComponentInstances(InstancedStaticMeshComponent, InstancedObjectTransforms);
+	}
+	else if (NumOldInstances == NumNewInstances)
 	{
 		// For efficiency, try to reuse the existing buffer.
 		InstancedStaticMeshComponent->BatchUpdateInstancesTransforms(0, InstancedObjectTransforms, false, true);
@@ -2456,6 +2527,72 @@ FHoudiniInstanceTranslator::CreateOrUpdateInstancedStaticMeshComponent(
 	return true;
 }
 
+void
+FHoudiniInstanceTranslator::UpdateInstancedStaticMeshComponentInstances(
+	UInstancedStaticMeshComponent* InISMC,
+	const TArray<FTransform>& InTransforms)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniInstanceTranslator::UpdateInstancedStaticMeshComponentInstances);
+
+	// Instances are kept in the same order as the instancer's points, since the per-instance custom data
+	// and property attributes are applied by index. Instances are matched by index, only the ones whose
+	// transform changed are updated, then instances are appended or removed at the end of the buffer.
+	const int32 NumOldInstances = InISMC->GetInstanceCount();
+	const int32 NumNewInstances = InTransforms.Num();
+	const int32 NumCommonInstances = FMath::Min(NumOldInstances, NumNewInstances);
+
+	bool bModified = false;
+	TArray<FTransform> ChangedTransforms;
+	int32 InstanceIndex = 0;
+	while (InstanceIndex < NumCommonInstances)
+	{
+		FTransform OldTransform;
+		if (InISMC->GetInstanceTransform(InstanceIndex, OldTransform, false)
+			&& OldTransform.Equals(InTransforms[InstanceIndex], KINDA_SMALL_NUMBER))
+		{
+			InstanceIndex++;
+			continue;
+		}
+
+		// Gather the run of consecutive changed instances and send it as a single batch
+		const int32 RunStart = InstanceIndex;
+		ChangedTransforms.Reset();
+		do
+		{
+			ChangedTransforms.Add(InTransforms[InstanceIndex]);
+			InstanceIndex++;
+		}
+		while (InstanceIndex < NumCommonInstances
+			&& (!InISMC->GetInstanceTransform(InstanceIndex, OldTransform, false)
+				|| !OldTransform.Equals(InTransforms[InstanceIndex], KINDA_SMALL_NUMBER)));
+
+		InISMC->BatchUpdateInstancesTransforms(RunStart, ChangedTransforms, false, false);
+		bModified = true;
+	}
+
+	if (NumNewInstances > NumOldInstances)
+	{
+		ChangedTransforms.Reset(NumNewInstances - NumOldInstances);
+		ChangedTransforms.Append(InTransforms.GetData() + NumOldInstances, NumNewInstances - NumOldInstances);
+		InISMC->AddInstances(ChangedTransforms, false);
+		bModified = true;
+	}
+	else if (NumNewInstances < NumOldInstances)
+	{
+		// Remove from the end so no instance is moved or swapped
+		TArray<int32> InstancesToRemove;
+		InstancesToRemove.Reserve(NumOldInstances - NumNewInstances);
+		for (int32 Index = NumOldInstances - 1; Index >= NumNewInstances; Index--)
+			InstancesToRemove.Add(Index);
+
+		InISMC->RemoveInstances(InstancesToRemove);
+		bModified = true;
+	}
+
+	if (bModified)
+		InISMC->MarkRenderStateDirty();
+}
+
 bool
 FHoudiniInstanceTranslator::CreateOrUpdateInstancedActorComponent(
 	UObject* InstancedObject,
@@ -2995,7 +3132,24 @@ FHoudiniInstanceTranslator::CreateOrUpdateFoliageInstances(
 	TArray<FFoliageAttachmentInfo> AttachmentTypes = 
 		FHoudiniFoliageTools::GetAttachmentInfo(InstancerGeoPartObject.GeoId, InstancerGeoPartObject.PartId, FoliageInstances.Num());
 
-	FHoudiniFoliageTools::SpawnFoliageInstances(WorldUsed, CookedFoliageType, FoliageInstances, AttachmentTypes);
+	// The cooked foliage type is recreated in place, so instances of the previous cook can still be in the world
+	// when updating foliage incrementally. Only update the instances that changed in that case.
+	bool bHasPreviousInstances = false;
+	for (TActorIterator<AInstancedFoliageActor> ActorIt(WorldUsed); ActorIt; ++ActorIt)
+	{
+		AInstancedFoliageActor* IFA = *ActorIt;
+		if (!IsValid(IFA) || !IFA->FindInfo(CookedFoliageType))
+			continue;
+
+		// Let the foliage components pick up the new foliage type settings
+		IFA->NotifyFoliageTypeChanged(CookedFoliageType, true);
+		bHasPreviousInstances = true;
+	}
+
+	if (bHasPreviousInstances)
+		FHoudiniFoliageTools::UpdateFoliageInstances(WorldUsed, CookedFoliageType, FoliageInstances, AttachmentTypes);
+	else
+		FHoudiniFoliageTools::SpawnFoliageInstances(WorldUsed, CookedFoliageType, FoliageInstances, AttachmentTypes);
 
 	// Clear the returned component. This should be set, but doesn't make in world partition.
 	// In future, this should be an array of components.
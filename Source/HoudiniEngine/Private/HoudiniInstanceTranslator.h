@@ -35,6 +35,7 @@
 #include "HoudiniInstanceTranslator.generated.h"
 
 class UStaticMesh;
+class UInstancedStaticMeshComponent;
 class UFoliageType;
 class UHoudiniStaticMesh;
 class UHoudiniInstancedActorComponent;
@@ -328,11 +329,11 @@ struct HOUDINIENGINE_API FHoudiniInstanceTranslator
 		static void UpdateVariationAssignements(
 			FHoudiniInstancedOutput& InstancedOutput);
 
-		// Extracts the final transforms (with the transform offset applied) for a given variation
+		// Extracts the final transforms (with the transform offset applied) of all variations,
+		// in a single pass over the original transforms
 		static void ProcessInstanceTransforms(
-			FHoudiniInstancedOutput& InstancedOutput,
-			const int32& VariationIdx,
-			TArray<FTransform>& OutProcessedTransforms);
+			const FHoudiniInstancedOutput& InstancedOutput,
+			TArray<TArray<FTransform>>& OutVariationTransforms);
 
 		// Creates a new component or updates the previous one if possible
 		static bool CreateOrUpdateInstancer(
@@ -368,6 +369,11 @@ struct HOUDINIENGINE_API FHoudiniInstanceTranslator
 			const bool& bForceHISM = false,
 			const int32& InstancerObjectIdx = 0);
 
+		// Updates the instances of an existing ISMC / HISMC, only sending the ones that changed
+		static void UpdateInstancedStaticMeshComponentInstances(
+			UInstancedStaticMeshComponent* InISMC,
+			const TArray<FTransform>& InTransforms);
+
 		// Create or update an IAC
 		static bool CreateOrUpdateInstancedActorComponent(
 			UObject* InstancedObject,
@@ -57,6 +57,7 @@
 #include "Engine/AssetManager.h"
 #include "HoudiniLandscapeRuntimeUtils.h"
 #include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
 #if WITH_EDITOR
 	#include "EditorLevelUtils.h"
 #endif
@@ -67,6 +68,140 @@ typedef FHoudiniEngineUtils FHUtils;
 
 HOUDINI_LANDSCAPE_DEFINE_LOG_CATEGORY();
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineLandscapeDirtyRegions(
+	TEXT("HoudiniEngine.LandscapeDirtyRegions"),
+	1,
+	TEXT("When enabled, landscape layers only write the landscape components whose data changed since the previous cook.\n")
+	TEXT("0: Always write the full extents of the height field\n")
+	TEXT("1: Only write the changed landscape components (default)\n")
+);
+
+// Floor division, as landscape coordinates can be negative.
+static int32
+HoudiniLandscapeFloorDiv(int32 Value, int32 Divisor)
+{
+	return Value >= 0 ? Value / Divisor : (Value - Divisor + 1) / Divisor;
+}
+
+// Returns the region of Extents covered by the landscape component at TileX, TileY, in the component grid starting at FirstTile.
+static FHoudiniExtents
+HoudiniLandscapeGetTileExtents(const FHoudiniExtents& Extents, const FIntPoint& FirstTile, int32 TileX, int32 TileY, int32 ComponentSize)
+{
+	FHoudiniExtents Tile;
+	Tile.Min.X = FMath::Max(Extents.Min.X, (FirstTile.X + TileX) * ComponentSize);
+	Tile.Min.Y = FMath::Max(Extents.Min.Y, (FirstTile.Y + TileY) * ComponentSize);
+	Tile.Max.X = FMath::Min(Extents.Max.X, (FirstTile.X + TileX + 1) * ComponentSize - 1);
+	Tile.Max.Y = FMath::Min(Extents.Max.Y, (FirstTile.Y + TileY + 1) * ComponentSize - 1);
+	return Tile;
+}
+
+// Hashes the layer data covered by each landscape component. Data is laid out as the Extents rectangle.
+template<typename DataType>
+static TArray<uint64>
+HoudiniLandscapeHashComponentData(const TArray<DataType>& Data, const FHoudiniExtents& Extents, int32 ComponentSize)
+{
+	H_SCOPED_FUNCTION_TIMER();
+
+	const FIntPoint FirstTile(HoudiniLandscapeFloorDiv(Extents.Min.X, ComponentSize), HoudiniLandscapeFloorDiv(Extents.Min.Y, ComponentSize));
+	const int32 NumTilesX = HoudiniLandscapeFloorDiv(Extents.Max.X, ComponentSize) - FirstTile.X + 1;
+	const int32 NumTilesY = HoudiniLandscapeFloorDiv(Extents.Max.Y, ComponentSize) - FirstTile.Y + 1;
+	const int32 Width = Extents.Max.X - Extents.Min.X + 1;
+
+	TArray<uint64> Hashes;
+	Hashes.SetNumZeroed(NumTilesX * NumTilesY);
+	ParallelFor(Hashes.Num(), [&](int32 TileIndex)
+	{
+		const FHoudiniExtents Tile = HoudiniLandscapeGetTileExtents(Extents, FirstTile, TileIndex % NumTilesX, TileIndex / NumTilesX, ComponentSize);
+		const int32 RowSize = (Tile.Max.X - Tile.Min.X + 1) * sizeof(DataType);
+
+		uint64 Hash = 0;
+		for (int32 Y = Tile.Min.Y; Y <= Tile.Max.Y; Y++)
+		{
+			const DataType* Row = Data.GetData() + static_cast<int64>(Y - Extents.Min.Y) * Width + (Tile.Min.X - Extents.Min.X);
+			Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Row), RowSize, Hash);
+		}
+		Hashes[TileIndex] = Hash;
+	});
+
+	return Hashes;
+}
+
+// Returns the regions covering the landscape components whose new hash differs from the hash of their current data.
+// Consecutive dirty components are merged into rectangles to limit the number of writes. If there are no current
+// hashes, the whole extents are dirty.
+static TArray<FHoudiniExtents>
+HoudiniLandscapeGetDirtyRegions(const TArray<uint64>& Hashes, const TArray<uint64>* CurrentHashes, const FHoudiniExtents& Extents, int32 ComponentSize)
+{
+	TArray<FHoudiniExtents> Regions;
+	if (!CurrentHashes || CurrentHashes->Num() != Hashes.Num())
+	{
+		Regions.Add(Extents);
+		return Regions;
+	}
+
+	const FIntPoint FirstTile(HoudiniLandscapeFloorDiv(Extents.Min.X, ComponentSize), HoudiniLandscapeFloorDiv(Extents.Min.Y, ComponentSize));
+	const int32 NumTilesX = HoudiniLandscapeFloorDiv(Extents.Max.X, ComponentSize) - FirstTile.X + 1;
+	const int32 NumTilesY = Hashes.Num() / NumTilesX;
+
+	for (int32 TileY = 0; TileY < NumTilesY; TileY++)
+	{
+		int32 TileX = 0;
+		while (TileX < NumTilesX)
+		{
+			if (Hashes[TileY * NumTilesX + TileX] == (*CurrentHashes)[TileY * NumTilesX + TileX])
+			{
+				TileX++;
+				continue;
+			}
+
+			// Extend the run of dirty components on this row
+			const int32 RunStart = TileX;
+			while (TileX < NumTilesX && Hashes[TileY * NumTilesX + TileX] != (*CurrentHashes)[TileY * NumTilesX + TileX])
+				TileX++;
+
+			FHoudiniExtents Region = HoudiniLandscapeGetTileExtents(Extents, FirstTile, RunStart, TileY, ComponentSize);
+			Region.Max = HoudiniLandscapeGetTileExtents(Extents, FirstTile, TileX - 1, TileY, ComponentSize).Max;
+
+			// Merge with the previous row's run if it spans the same columns.
+			FHoudiniExtents* Above = Regions.Num() > 0 ? &Regions.Last() : nullptr;
+			if (Above && Above->Min.X == Region.Min.X && Above->Max.X == Region.Max.X && Above->Max.Y + 1 == Region.Min.Y)
+				Above->Max.Y = Region.Max.Y;
+			else
+				Regions.Add(Region);
+		}
+	}
+
+	return Regions;
+}
+
+// Calls Write(Region, RegionData) for each dirty region, with the region's data copied out of the Extents sized Data.
+template<typename DataType, typename WriteFunc>
+static void
+HoudiniLandscapeWriteRegions(const TArray<DataType>& Data, const FHoudiniExtents& Extents, const TArray<FHoudiniExtents>& Regions, WriteFunc&& Write)
+{
+	const int32 Width = Extents.Max.X - Extents.Min.X + 1;
+
+	TArray<DataType> RegionData;
+	for (const FHoudiniExtents& Region : Regions)
+	{
+		if (Region.Min == Extents.Min && Region.Max == Extents.Max)
+		{
+			Write(Region, Data.GetData());
+			continue;
+		}
+
+		const int32 RegionWidth = Region.Max.X - Region.Min.X + 1;
+		const int32 RegionHeight = Region.Max.Y - Region.Min.Y + 1;
+		RegionData.SetNumUninitialized(RegionWidth * RegionHeight);
+		for (int32 Row = 0; Row < RegionHeight; Row++)
+		{
+			const int64 SrcIndex = static_cast<int64>(Region.Min.Y - Extents.Min.Y + Row) * Width + (Region.Min.X - Extents.Min.X);
+			FMemory::Memcpy(RegionData.GetData() + Row * RegionWidth, Data.GetData() + SrcIndex, RegionWidth * sizeof(DataType));
+		}
+		Write(Region, RegionData.GetData());
+	}
+}
+
 bool
 FHoudiniLandscapeTranslator::ProcessLandscapeOutput(
 	UHoudiniOutput* InOutput,
@@ -88,6 +223,32 @@ FHoudiniLandscapeTranslator::ProcessLandscapeOutput(
 
 	TArray<FHoudiniHeightFieldPartData> Parts = GetPartsToTranslate(InOutput);
 
+	//------------------------------------------------------------------------------------------------------------------------------
+	// Remember which layers the last cook wrote, so their unchanged landscape components are not written again. Temporary
+	// cooked edit layers and created landscapes are deleted below, so they are always fully rewritten.
+	//------------------------------------------------------------------------------------------------------------------------------
+
+	TMap<FHoudiniOutputObjectIdentifier, FHoudiniLandscapeCookedLayer> PreviousLayers;
+	if (CVarHoudiniEngineLandscapeDirtyRegions.GetValueOnGameThread() > 0)
+	{
+		for (auto& OutputObjectPair : InOutput->GetOutputObjects())
+		{
+			UHoudiniLandscapeTargetLayerOutput* OldLayer = Cast<UHoudiniLandscapeTargetLayerOutput>(OutputObjectPair.Value.OutputObject);
+			if (!IsValid(OldLayer) || !IsValid(OldLayer->Landscape) || OldLayer->ComponentDataHashes.IsEmpty())
+				continue;
+
+			if (OldLayer->bCreatedLandscape || OldLayer->BakedEditLayer != OldLayer->CookedEditLayer)
+				continue;
+
+			FHoudiniLandscapeCookedLayer& PreviousLayer = PreviousLayers.Add(OutputObjectPair.Key);
+			PreviousLayer.Landscape = OldLayer->Landscape.Get();
+			PreviousLayer.EditLayer = OldLayer->CookedEditLayer;
+			PreviousLayer.TargetLayer = OldLayer->TargetLayer;
+			PreviousLayer.Extents = OldLayer->Extents;
+			PreviousLayer.ComponentDataHashes = OldLayer->ComponentDataHashes;
+		}
+	}
+
 	//------------------------------------------------------------------------------------------------------------------------------
 	// Remove any layers from last cook.
 	//------------------------------------------------------------------------------------------------------------------------------
@@ -124,14 +285,16 @@ FHoudiniLandscapeTranslator::ProcessLandscapeOutput(
 			continue;
 		}
 
+		FHoudiniOutputObjectIdentifier OutputObjectIdentifier(Part.HeightField->ObjectId, Part.HeightField->GeoId, Part.HeightField->PartId, "EditableLayer");
+
 		int Index = LandscapeMapping.HoudiniLayerToUnrealLandscape[&Part];
 		FHoudiniUnrealLandscapeTarget& Landscape = LandscapeMapping.TargetLandscapes[Index];
-		UHoudiniLandscapeTargetLayerOutput* Result = TranslateHeightFieldPart(InOutput, Landscape, Part, *HAC, ClearedLayers, InPackageParams);
+		UHoudiniLandscapeTargetLayerOutput* Result = TranslateHeightFieldPart(
+			InOutput, Landscape, Part, *HAC, ClearedLayers, InPackageParams, PreviousLayers.Find(OutputObjectIdentifier));
 		if (!Result)
 			continue;
 		AllOutputs.Add(Result);
 
-		FHoudiniOutputObjectIdentifier OutputObjectIdentifier(Part.HeightField->ObjectId, Part.HeightField->GeoId, Part.HeightField->PartId, "EditableLayer");
 		FHoudiniOutputObject& OutputObj = InOutput->GetOutputObjects().FindOrAdd(OutputObjectIdentifier);
 		OutputObj.OutputObject = Result;
 
@@ -533,7 +696,8 @@ FHoudiniLandscapeTranslator::TranslateHeightFieldPart(
 		FHoudiniHeightFieldPartData& Part,
 		UHoudiniAssetComponent& HAC,
 		FHoudiniClearedEditLayers& ClearedLayers,
-		const FHoudiniPackageParams& InPackageParams)
+		const FHoudiniPackageParams& InPackageParams,
+		const FHoudiniLandscapeCookedLayer* PreviousLayer)
 {
 	H_SCOPED_FUNCTION_TIMER();
 
@@ -697,23 +861,47 @@ FHoudiniLandscapeTranslator::TranslateHeightFieldPart(
 
 	const bool bFetchData = !Landscape.bWasCreated || LayerType != TargetLayerType::Height;
 	
+	// The values are kept in Houdini order, they are transposed (and resized) when converted to landscape data below.
 	FHoudiniHeightFieldData HeightFieldData = FHoudiniLandscapeUtils::FetchVolumeInUnrealSpace(
 			*Part.HeightField, 
 			Part.SizeInfo.UnrealGridDimensions,
-			bFetchData);
+			bFetchData,
+			false);
 
 	// The transform we get from Houdini should be relative to the HDA:
 	HeightFieldData.Transform = HeightFieldData.Transform * HAC.GetComponentTransform();
 
 	// If a new landscape was created, resize the layer to match the created landscape size. (We resize the landscape if it does
 	// not fit one of Unreal's predetermined sizes. Only do this for non-tiles.
+	FIntPoint LayerDimensions = HeightFieldData.Dimensions;
 	if (Landscape.bWasCreated && !Part.TileInfo.IsSet() && bFetchData)
 	{
-		if (Landscape.Dimensions != HeightFieldData.Dimensions)
-			HeightFieldData = FHoudiniLandscapeUtils::ReDimensionLandscape(HeightFieldData, Landscape.Dimensions);
+		LayerDimensions = Landscape.Dimensions;
 	}
 
-	auto Extents = FHoudiniLandscapeUtils::GetExtents(OutputLandscape, HeightFieldData);
+	auto Extents = FHoudiniLandscapeUtils::GetExtents(OutputLandscape, HeightFieldData.Transform, LayerDimensions);
+
+	// ------------------------------------------------------------------------------------------------------------------
+	// Dirty regions: if the last cook wrote the same region of the same layer, and the layer wasn't cleared since, only
+	// the landscape components whose data changed need to be written. The landscape may have been edited since the last
+	// cook, so the new data is compared with the landscape's current data rather than with what the last cook wrote.
+	// ------------------------------------------------------------------------------------------------------------------
+
+	const int32 ComponentSize = FMath::Max(OutputLandscape->ComponentSizeQuads, 1);
+	bool bCanSkipComponents = false;
+	if (PreviousLayer 
+		&& !PreviousLayer->ComponentDataHashes.IsEmpty()
+		&& PreviousLayer->Landscape.Get() == OutputLandscape
+		&& PreviousLayer->EditLayer == CookedLayerName
+		&& PreviousLayer->TargetLayer == Part.TargetLayerName
+		&& PreviousLayer->Extents.Min == Extents.Min
+		&& PreviousLayer->Extents.Max == Extents.Max
+		&& !ClearedLayers.Contains(CookedLayerName, Part.TargetLayerName))
+	{
+		bCanSkipComponents = true;
+	}
+
+	TArray<uint64> ComponentDataHashes;
 
 	// ------------------------------------------------------------------------------------------------------------------
 	// Is a paint layer or visibility layer
@@ -726,38 +914,45 @@ FHoudiniLandscapeTranslator::TranslateHeightFieldPart(
 		if (OutputLandscape->bCanHaveLayersContent)
 			LayerGUID = UnrealEditLayer->Guid;
 
-		bool bExceededRange = FHoudiniLandscapeUtils::NormalizePaintLayers(HeightFieldData.Values, Part.bNormalizePaintLayers);
+		bool bExceededRange = false;
+		TArray<uint8> Values = FHoudiniLandscapeUtils::ConvertPaintLayerData(
+			HeightFieldData, LayerDimensions, Part.bNormalizePaintLayers, bExceededRange);
 
 		if (bExceededRange)
 			HOUDINI_LOG_WARNING(TEXT("Target layer %s contains values outside the range 0 to 1."), *Part.TargetLayerName);
 
+		ULandscapeLayerInfoObject* WrittenLayerInfo = LayerType == TargetLayerType::Visibility ? ALandscapeProxy::VisibilityLayer : TargetLayerInfo;
 
-		TArray<uint8> Values;
-		Values.SetNum(HeightFieldData.Values.Num());
+		ComponentDataHashes = HoudiniLandscapeHashComponentData(Values, Extents, ComponentSize);
+		TArray<uint64> CurrentHashes;
+		if (bCanSkipComponents)
+		{
+			TArray<uint8> CurrentValues;
+			CurrentValues.SetNumZeroed(Values.Num());
+			{
+				FScopedSetLandscapeEditingLayer Scope(OutputLandscape, LayerGUID, [&] {});
+				FLandscapeEditDataInterface LandscapeEdit(TargetLandscapeInfo);
+				LandscapeEdit.SetShouldDirtyPackage(false);
+				LandscapeEdit.GetWeightDataFast(WrittenLayerInfo, Extents.Min.X, Extents.Min.Y, Extents.Max.X, Extents.Max.Y, CurrentValues.GetData(), 0);
+			}
+			CurrentHashes = HoudiniLandscapeHashComponentData(CurrentValues, Extents, ComponentSize);
+		}
 
-		ParallelFor(Values.Num(), [&](int Index)
+		TArray<FHoudiniExtents> DirtyRegions = HoudiniLandscapeGetDirtyRegions(
+			ComponentDataHashes, bCanSkipComponents ? &CurrentHashes : nullptr, Extents, ComponentSize);
+		if (!DirtyRegions.IsEmpty())
 		{
-			float Value = HeightFieldData.Values[Index];
-			Values[Index] = static_cast<uint8>(Value * 255);
-		});
+			FScopedSetLandscapeEditingLayer Scope(OutputLandscape, LayerGUID, [&] { OutputLandscape->RequestLayersContentUpdate(ELandscapeLayerUpdateMode::Update_All); });
 
-		FScopedSetLandscapeEditingLayer Scope(OutputLandscape, LayerGUID, [&] { OutputLandscape->RequestLayersContentUpdate(ELandscapeLayerUpdateMode::Update_All); });
+			FAlphamapAccessor<false, false> AlphaAccessor(OutputLandscape->GetLandscapeInfo(), WrittenLayerInfo);
 
-		if (LayerType == TargetLayerType::Visibility)
-		{
-			FAlphamapAccessor<false, false> AlphaAccessor(OutputLandscape->GetLandscapeInfo(), ALandscapeProxy::VisibilityLayer);
-			AlphaAccessor.SetData(
-				Extents.Min.X, Extents.Min.Y, Extents.Max.X, Extents.Max.Y,
-				Values.GetData(),
-				ELandscapeLayerPaintingRestriction::None);
-		}
-		else
-		{
-			FAlphamapAccessor<false, false> AlphaAccessor(OutputLandscape->GetLandscapeInfo(), TargetLayerInfo);
-			AlphaAccessor.SetData(
-				Extents.Min.X, Extents.Min.Y, Extents.Max.X, Extents.Max.Y,
-				Values.GetData(),
-				ELandscapeLayerPaintingRestriction::None);
+			HoudiniLandscapeWriteRegions(Values, Extents, DirtyRegions, [&](const FHoudiniExtents& Region, const uint8* RegionData)
+			{
+				AlphaAccessor.SetData(
+					Region.Min.X, Region.Min.Y, Region.Max.X, Region.Max.Y,
+					RegionData,
+					ELandscapeLayerPaintingRestriction::None);
+			});
 		}
 	}
 
@@ -768,16 +963,31 @@ FHoudiniLandscapeTranslator::TranslateHeightFieldPart(
 	if (LayerType == TargetLayerType::Height && !Landscape.bWasCreated)
 	{
 
-		TArray<uint16> QuantizedData = FHoudiniLandscapeUtils::ConvertHeightFieldData(OutputLandscape, HeightFieldData.Values);
+		TArray<uint16> QuantizedData = FHoudiniLandscapeUtils::ConvertHeightFieldData(OutputLandscape, HeightFieldData, LayerDimensions);
 
-		FScopedSetLandscapeEditingLayer Scope(OutputLandscape, UnrealEditLayer->Guid, [&] { OutputLandscape->ForceUpdateLayersContent(); });
+		ComponentDataHashes = HoudiniLandscapeHashComponentData(QuantizedData, Extents, ComponentSize);
+		TArray<uint64> CurrentHashes;
+		if (bCanSkipComponents)
+		{
+			TArray<uint16> CurrentData = FHoudiniLandscapeUtils::GetHeightData(OutputLandscape, Extents, UnrealEditLayer);
+			CurrentHashes = HoudiniLandscapeHashComponentData(CurrentData, Extents, ComponentSize);
+		}
 
-		FLandscapeEditDataInterface LandscapeEdit(TargetLandscapeInfo);
-		FHeightmapAccessor<false> HeightMapAccessor(TargetLandscapeInfo);
-		HeightMapAccessor.SetData(
-			Extents.Min.X, Extents.Min.Y, Extents.Max.X, Extents.Max.Y,
-			QuantizedData.GetData());
+		TArray<FHoudiniExtents> DirtyRegions = HoudiniLandscapeGetDirtyRegions(
+			ComponentDataHashes, bCanSkipComponents ? &CurrentHashes : nullptr, Extents, ComponentSize);
+		if (!DirtyRegions.IsEmpty())
+		{
+			FScopedSetLandscapeEditingLayer Scope(OutputLandscape, UnrealEditLayer->Guid, [&] { OutputLandscape->ForceUpdateLayersContent(); });
 
+			FLandscapeEditDataInterface LandscapeEdit(TargetLandscapeInfo);
+			FHeightmapAccessor<false> HeightMapAccessor(TargetLandscapeInfo);
+			HoudiniLandscapeWriteRegions(QuantizedData, Extents, DirtyRegions, [&](const FHoudiniExtents& Region, const uint16* RegionData)
+			{
+				HeightMapAccessor.SetData(
+					Region.Min.X, Region.Min.Y, Region.Max.X, Region.Max.Y,
+					RegionData);
+			});
+		}
 	}
 
 	if (bWasLocked && UnrealEditLayer)
@@ -810,6 +1020,7 @@ FHoudiniLandscapeTranslator::TranslateHeightFieldPart(
 	Obj->bWriteLockedLayers = Part.bWriteLockedLayers;
 	Obj->bLockLayer = Part.bLockLayer;
 	Obj->PropertyAttributes = Part.PropertyAttributes;
+	Obj->ComponentDataHashes = MoveTemp(ComponentDataHashes);
 	return Obj;
 
 
@@ -51,6 +51,16 @@ struct FHoudiniLandscapeCreationInfo
 	bool Validate();
 };
 
+// What the previous cook wrote to a landscape target layer, see UHoudiniLandscapeTargetLayerOutput.
+struct FHoudiniLandscapeCookedLayer
+{
+	TWeakObjectPtr<ALandscape> Landscape;
+	FString EditLayer;
+	FString TargetLayer;
+	FHoudiniExtents Extents;
+	TArray<uint64> ComponentDataHashes;
+};
+
 struct HOUDINIENGINE_API FHoudiniLandscapeTranslator
 {
 	static TArray<FHoudiniHeightFieldPartData> GetPartsToTranslate(UHoudiniOutput* InOutput);
@@ -85,7 +95,8 @@ private:
 			FHoudiniHeightFieldPartData& Part,
 			UHoudiniAssetComponent& HAC,
 			FHoudiniClearedEditLayers& ClearedLayers,
-			const FHoudiniPackageParams& InPackageParams);
+			const FHoudiniPackageParams& InPackageParams,
+			const FHoudiniLandscapeCookedLayer* PreviousLayer);
 };
 
 
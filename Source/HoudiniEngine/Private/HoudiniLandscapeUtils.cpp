@@ -52,6 +52,211 @@
 	#include "LandscapeEditLayer.h"
 #endif
 
+#include <atomic>
+
+// Size (in samples) of the square tiles processed by the fused height field conversion.
+static constexpr int32 HoudiniHeightFieldTileSize = 64;
+
+// Number of values reduced per task when scanning height field values.
+static constexpr int32 HoudiniHeightFieldScanChunkSize = 64 * 1024;
+
+// Writes Out[i] = (OutType)(Clamp(In[i] * Scale + Offset, 0, 1) * MaxOutput), four values at a time.
+// Returns true if any value had to be clamped.
+template<typename OutType>
+static FORCEINLINE bool
+HoudiniQuantizeHeightFieldRow(const float* In, OutType* Out, int32 Num, float Scale, float Offset, float MaxOutput)
+{
+	const VectorRegister4Float VScale = VectorSetFloat1(Scale);
+	const VectorRegister4Float VOffset = VectorSetFloat1(Offset);
+	const VectorRegister4Float VMaxOutput = VectorSetFloat1(MaxOutput);
+	const VectorRegister4Float VZero = VectorZeroFloat();
+	const VectorRegister4Float VOne = VectorOneFloat();
+
+	bool bClamped = false;
+	alignas(16) int32 Quantized[4];
+
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		VectorRegister4Float Value = VectorMultiplyAdd(VectorLoad(In + Index), VScale, VOffset);
+		bClamped |= (VectorAnyGreaterThan(Value, VOne) || VectorAnyGreaterThan(VZero, Value));
+
+		Value = VectorMultiply(VectorMin(VectorMax(Value, VZero), VOne), VMaxOutput);
+		VectorIntStoreAligned(VectorFloatToInt(Value), Quantized);
+
+		Out[Index + 0] = static_cast<OutType>(Quantized[0]);
+		Out[Index + 1] = static_cast<OutType>(Quantized[1]);
+		Out[Index + 2] = static_cast<OutType>(Quantized[2]);
+		Out[Index + 3] = static_cast<OutType>(Quantized[3]);
+	}
+
+	for (; Index < Num; Index++)
+	{
+		const float Value = In[Index] * Scale + Offset;
+		bClamped |= (Value < 0.0f || Value > 1.0f);
+		Out[Index] = static_cast<OutType>(FMath::Clamp(Value, 0.0f, 1.0f) * MaxOutput);
+	}
+
+	return bClamped;
+}
+
+// Fused height field conversion: fetches each landscape sample from the volume values (transposing them from
+// Houdini order and bilinearly resampling them to OutDimensions on the fly), then realigns, clamps and
+// quantizes it. The work is done per tile so the source reads stay in cache, and the output is the only
+// full size buffer. Returns true if any value had to be clamped.
+template<typename OutType>
+static bool
+HoudiniConvertHeightFieldValues(
+	const float* Values,
+	const FIntPoint& InDimensions,
+	bool bHoudiniOrder,
+	const FIntPoint& OutDimensions,
+	float Scale,
+	float Offset,
+	float MaxOutput,
+	TArray<OutType>& OutValues)
+{
+	constexpr int32 TileSize = HoudiniHeightFieldTileSize;
+
+	const int64 NumOutValues = static_cast<int64>(OutDimensions.X) * OutDimensions.Y;
+	if (!Values || InDimensions.X <= 0 || InDimensions.Y <= 0)
+	{
+		OutValues.SetNumZeroed(NumOutValues);
+		return false;
+	}
+
+	OutValues.SetNumUninitialized(NumOutValues);
+
+	// Distance between two consecutive source values along Unreal's X and Y axis.
+	const int64 XStride = bHoudiniOrder ? InDimensions.Y : 1;
+	const int64 YStride = bHoudiniOrder ? 1 : InDimensions.X;
+
+	const bool bResample = InDimensions != OutDimensions;
+	const float XScale = OutDimensions.X > 1 ? (float)(InDimensions.X - 1) / (OutDimensions.X - 1) : 0.0f;
+	const float YScale = OutDimensions.Y > 1 ? (float)(InDimensions.Y - 1) / (OutDimensions.Y - 1) : 0.0f;
+
+	const int32 NumTilesX = FMath::DivideAndRoundUp(OutDimensions.X, TileSize);
+	const int32 NumTilesY = FMath::DivideAndRoundUp(OutDimensions.Y, TileSize);
+
+	std::atomic<bool> bClamped(false);
+	ParallelFor(NumTilesX * NumTilesY, [&](int32 TileIndex)
+	{
+		const int32 TileX = (TileIndex % NumTilesX) * TileSize;
+		const int32 TileY = (TileIndex / NumTilesX) * TileSize;
+		const int32 TileWidth = FMath::Min(TileSize, OutDimensions.X - TileX);
+		const int32 TileHeight = FMath::Min(TileSize, OutDimensions.Y - TileY);
+
+		// Source columns and lerp factors are shared by all the rows of the tile
+		int64 SrcX0[TileSize];
+		int64 SrcX1[TileSize];
+		float FracX[TileSize];
+		if (bResample)
+		{
+			for (int32 Column = 0; Column < TileWidth; Column++)
+			{
+				const float OldX = (TileX + Column) * XScale;
+				const int32 X0 = FMath::FloorToInt(OldX);
+				SrcX0[Column] = X0 * XStride;
+				SrcX1[Column] = FMath::Min(X0 + 1, InDimensions.X - 1) * XStride;
+				FracX[Column] = FMath::Fractional(OldX);
+			}
+		}
+
+		alignas(16) float RowValues[TileSize];
+		bool bTileClamped = false;
+		for (int32 Row = 0; Row < TileHeight; Row++)
+		{
+			const int32 Y = TileY + Row;
+			const float* InRow = RowValues;
+			if (bResample)
+			{
+				const float OldY = Y * YScale;
+				const int32 Y0 = FMath::FloorToInt(OldY);
+				const int32 Y1 = FMath::Min(Y0 + 1, InDimensions.Y - 1);
+				const float FracY = FMath::Fractional(OldY);
+				const float* SrcRow0 = Values + Y0 * YStride;
+				const float* SrcRow1 = Values + Y1 * YStride;
+				for (int32 Column = 0; Column < TileWidth; Column++)
+				{
+					RowValues[Column] = FMath::BiLerp(
+						SrcRow0[SrcX0[Column]], SrcRow0[SrcX1[Column]],
+						SrcRow1[SrcX0[Column]], SrcRow1[SrcX1[Column]],
+						FracX[Column], FracY);
+				}
+			}
+			else if (bHoudiniOrder)
+			{
+				const float* SrcRow = Values + Y * YStride + TileX * XStride;
+				for (int32 Column = 0; Column < TileWidth; Column++)
+				{
+					RowValues[Column] = SrcRow[Column * XStride];
+				}
+			}
+			else
+			{
+				// Already in Unreal order, read the source row directly.
+				InRow = Values + Y * YStride + TileX;
+			}
+
+			OutType* OutRow = OutValues.GetData() + static_cast<int64>(Y) * OutDimensions.X + TileX;
+			bTileClamped |= HoudiniQuantizeHeightFieldRow(InRow, OutRow, TileWidth, Scale, Offset, MaxOutput);
+		}
+
+		if (bTileClamped)
+			bClamped = true;
+	});
+
+	return bClamped;
+}
+
+// Returns the max of the values, scanned in parallel chunks.
+static float
+HoudiniGetHeightFieldMaxValue(const TArray<float>& Values)
+{
+	if (Values.Num() == 0)
+		return 0.0f;
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Values.Num(), HoudiniHeightFieldScanChunkSize);
+	TArray<float> ChunkMax;
+	ChunkMax.SetNumUninitialized(NumChunks);
+
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const float* Data = Values.GetData();
+		const int32 Start = ChunkIndex * HoudiniHeightFieldScanChunkSize;
+		const int32 End = FMath::Min(Start + HoudiniHeightFieldScanChunkSize, Values.Num());
+
+		float MaxValue = Data[Start];
+		int32 Index = Start;
+		if (End - Start >= 4)
+		{
+			VectorRegister4Float VMax = VectorLoad(Data + Index);
+			for (Index += 4; Index + 4 <= End; Index += 4)
+			{
+				VMax = VectorMax(VMax, VectorLoad(Data + Index));
+			}
+
+			alignas(16) float Lanes[4];
+			VectorStoreAligned(VMax, Lanes);
+			MaxValue = FMath::Max(FMath::Max(Lanes[0], Lanes[1]), FMath::Max(Lanes[2], Lanes[3]));
+		}
+
+		for (; Index < End; Index++)
+		{
+			MaxValue = FMath::Max(MaxValue, Data[Index]);
+		}
+
+		ChunkMax[ChunkIndex] = MaxValue;
+	});
+
+	float MaxValue = ChunkMax[0];
+	for (float Value : ChunkMax)
+	{
+		MaxValue = FMath::Max(MaxValue, Value);
+	}
+	return MaxValue;
+}
+
 TSet<UHoudiniLandscapeTargetLayerOutput *>
 FHoudiniLandscapeUtils::GetEditLayers(UHoudiniOutput& Output)
 {
@@ -612,14 +817,14 @@ FHoudiniLandscapeUtils::ResolveLandscapes(
 		// Fetch the data for the height field and use to create the landscape.
 		//---------------------------------------------------------------------------------------------------------------------------------
 
+		// The values are kept in Houdini order: the conversion transposes and resizes them while quantizing.
 		FHoudiniHeightFieldData HeightFieldData = FHoudiniLandscapeUtils::FetchVolumeInUnrealSpace(
-			*HeightPart->HeightField, HeightPart->SizeInfo.UnrealGridDimensions, true);
-
-		HeightFieldData = FHoudiniLandscapeUtils::ReDimensionLandscape(HeightFieldData, HeightPart->SizeInfo.UnrealGridDimensions);
+			*HeightPart->HeightField, HeightPart->SizeInfo.UnrealGridDimensions, true, false);
 
 		FHoudiniLandscapeUtils::AdjustLandscapeTransformToLayerHeight(*LandscapeActor, *HeightPart, HeightFieldData);
 
-		TArray<uint16> QuantizedData = FHoudiniLandscapeUtils::ConvertHeightFieldData(LandscapeActor, HeightFieldData.Values);
+		TArray<uint16> QuantizedData = FHoudiniLandscapeUtils::ConvertHeightFieldData(
+			LandscapeActor, HeightFieldData, HeightPart->SizeInfo.UnrealGridDimensions);
 
 
 		ImportLandscape(LandscapeActor, HeightPart->SizeInfo, QuantizedData);
@@ -1062,6 +1267,15 @@ FHoudiniExtents
 FHoudiniLandscapeUtils::GetExtents(
 	const ALandscape* TargetLandscape,
 	const FHoudiniHeightFieldData& HeightFieldData)
+{
+	return GetExtents(TargetLandscape, HeightFieldData.Transform, HeightFieldData.Dimensions);
+}
+
+FHoudiniExtents
+FHoudiniLandscapeUtils::GetExtents(
+	const ALandscape* TargetLandscape,
+	const FTransform& HeightFieldTransform,
+	const FIntPoint& Dimensions)
 {
 	FHoudiniExtents Extents;
 
@@ -1070,7 +1284,7 @@ FHoudiniLandscapeUtils::GetExtents(
 	FTransform UnscaledLandscapeTransform = TargetLandscapeTransform;
 	UnscaledLandscapeTransform.SetScale3D(FVector::OneVector);
 
-	const FTransform RelativeTileTransform = HeightFieldData.Transform * UnscaledLandscapeTransform.Inverse();
+	const FTransform RelativeTileTransform = HeightFieldTransform * UnscaledLandscapeTransform.Inverse();
 
 	FVector LandscapeScale = TargetLandscapeTransform.GetScale3D();
 	const FVector RelativeTileCoordinate = RelativeTileTransform.GetLocation() / LandscapeScale;
@@ -1085,8 +1299,8 @@ FHoudiniLandscapeUtils::GetExtents(
 
 	Extents.Min.X = TargetTileLoc.X;
 	Extents.Min.Y = TargetTileLoc.Y;
-	Extents.Max.X = TargetTileLoc.X + HeightFieldData.Dimensions.X - 1;
-	Extents.Max.Y = TargetTileLoc.Y + HeightFieldData.Dimensions.Y - 1;
+	Extents.Max.X = TargetTileLoc.X + Dimensions.X - 1;
+	Extents.Max.Y = TargetTileLoc.Y + Dimensions.Y - 1;
 
 	return Extents;
 }
@@ -1123,7 +1337,8 @@ void FHoudiniLandscapeUtils::TransposeValues(TArray<float> & Values, const FIntP
 FHoudiniHeightFieldData FHoudiniLandscapeUtils::FetchVolumeInUnrealSpace(
 	const FHoudiniGeoPartObject& HeightField, 
 	const FIntPoint& UnrealLandscapeDimensions,
-	bool bFetchData)
+	bool bFetchData,
+	bool bTransposeValues)
 {
 	H_SCOPED_FUNCTION_TIMER();
 
@@ -1138,7 +1353,11 @@ FHoudiniHeightFieldData FHoudiniLandscapeUtils::FetchVolumeInUnrealSpace(
 
 		HOUDINI_CHECK_RETURN(bSuccess == true, Result);
 
-		TransposeValues(Result.Values, Result.Dimensions);
+		// The fused conversions (ConvertHeightFieldData / ConvertPaintLayerData) can read Houdini order directly.
+		if (bTransposeValues)
+			TransposeValues(Result.Values, Result.Dimensions);
+		else
+			Result.bHoudiniOrder = true;
 	}
 
 	return Result;
@@ -1586,17 +1805,68 @@ TArray<uint16> FHoudiniLandscapeUtils::ConvertHeightFieldData(const ALandscape*
 	float Scale = 100.0f; // Scale from Meters to CM.
 	Scale /= Range; // Remap to -1.0f to 1.0 Range
 
-	TArray<float> AlignedValues = Values;
-	FHoudiniLandscapeUtils::RealignHeightFieldData(AlignedValues, 0.5f, Scale * 0.5f);
+	// The values are already in Unreal order, convert them as a single row.
+	const FIntPoint Dimensions(Values.Num(), 1);
+	TArray<uint16> QuantizedData;
+	bool bClamped = HoudiniConvertHeightFieldValues(
+		Values.GetData(), Dimensions, false, Dimensions, Scale * 0.5f, 0.5f, 65535.0f, QuantizedData);
+	if (bClamped)
+	{
+		HOUDINI_BAKING_WARNING(TEXT("Landscape layer exceeded max heights so was clamped."));
+	}
+
+	return QuantizedData;
+}
+
+TArray<uint16>
+FHoudiniLandscapeUtils::ConvertHeightFieldData(const ALandscape* LandscapeActor, const FHoudiniHeightFieldData& HeightField, const FIntPoint& OutDimensions)
+{
+	bool bClamped = false;
+	TArray<uint16> QuantizedData = ConvertHeightFieldData(
+		HeightField, OutDimensions, FHoudiniLandscapeUtils::GetLandscapeHeightRangeInCM(*LandscapeActor), bClamped);
 
-	// Explicitly clamp the values, and report if clamped.
-	bool bClamped = FHoudiniLandscapeUtils::ClampHeightFieldData(AlignedValues, 0.0, 1.0f);
+	// Explicitly report if clamped.
 	if (bClamped)
 	{
 		HOUDINI_BAKING_WARNING(TEXT("Landscape layer exceeded max heights so was clamped."));
 	}
 
-	// Quantized to 16-bit and set the data.
-	auto QuantizedData = FHoudiniLandscapeUtils::QuantizeNormalizedDataTo16Bit(AlignedValues);
 	return QuantizedData;
 }
+
+TArray<uint16>
+FHoudiniLandscapeUtils::ConvertHeightFieldData(const FHoudiniHeightFieldData& HeightField, const FIntPoint& OutDimensions, float HeightRangeInCM, bool& bOutClamped)
+{
+	H_SCOPED_FUNCTION_TIMER();
+
+	float Scale = 100.0f; // Scale from Meters to CM.
+	Scale /= HeightRangeInCM; // Remap to -1.0f to 1.0 Range
+
+	// Realign to 0..1, clamp and quantize to 16-bit in one pass.
+	TArray<uint16> QuantizedData;
+	bOutClamped = HoudiniConvertHeightFieldValues(
+		HeightField.Values.GetData(), HeightField.Dimensions, HeightField.bHoudiniOrder, OutDimensions,
+		Scale * 0.5f, 0.5f, 65535.0f, QuantizedData);
+
+	return QuantizedData;
+}
+
+TArray<uint8>
+FHoudiniLandscapeUtils::ConvertPaintLayerData(const FHoudiniHeightFieldData& HeightField, const FIntPoint& OutDimensions, bool bNormalize, bool& bOutExceededRange)
+{
+	H_SCOPED_FUNCTION_TIMER();
+
+	// Same rules as NormalizePaintLayers: if any value exceeds 1.0, either normalize by the max value or clamp.
+	// Resampling can't exceed the source range, so the source values are scanned.
+	const float MaxValue = HoudiniGetHeightFieldMaxValue(HeightField.Values);
+	bOutExceededRange = MaxValue > 1.0f;
+
+	const float Scale = (bOutExceededRange && bNormalize) ? 1.0f / MaxValue : 1.0f;
+
+	TArray<uint8> Values;
+	HoudiniConvertHeightFieldValues(
+		HeightField.Values.GetData(), HeightField.Dimensions, HeightField.bHoudiniOrder, OutDimensions,
+		Scale, 0.0f, 255.0f, Values);
+
+	return Values;
+}
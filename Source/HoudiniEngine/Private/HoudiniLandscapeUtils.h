@@ -84,6 +84,9 @@ struct FHoudiniHeightFieldData
     FTransform Transform;
     TArray<float> Values;
 
+    // True if Values are still in Houdini's (transposed) order, ie. the value at (X, Y) is at Values[Y + X * Dimensions.Y].
+    bool bHoudiniOrder = false;
+
     int GetNumPoints() const { return Dimensions.X * Dimensions.Y; }
 
 };
@@ -298,10 +301,13 @@ struct HOUDINIENGINE_API FHoudiniLandscapeUtils
 
     static FHoudiniExtents GetExtents(const ALandscape* TargetLandscape, const FHoudiniHeightFieldData& HeightFieldData);
 
+    static FHoudiniExtents GetExtents(const ALandscape* TargetLandscape, const FTransform& HeightFieldTransform, const FIntPoint& Dimensions);
+
 	static FHoudiniHeightFieldData FetchVolumeInUnrealSpace(
 			const FHoudiniGeoPartObject& HeightField, 
             const FIntPoint & UnrealLandscapeDimensions,
-            bool bFetchData);
+            bool bFetchData,
+            bool bTransposeValues = true);
 
     static FIntPoint GetVolumeDimensionsInUnrealSpace(const FHoudiniGeoPartObject& HeightField);
 
@@ -350,4 +356,15 @@ struct HOUDINIENGINE_API FHoudiniLandscapeUtils
 
     static TArray<uint16> ConvertHeightFieldData(const ALandscape* LandscapeActor, const TArray<float>& Values);
 
+    // Converts the height field to 16-bit landscape heights in a single pass, resampling to OutDimensions if needed.
+    // The values can be in Houdini or Unreal order. Replaces ReDimensionLandscape + ConvertHeightFieldData.
+    static TArray<uint16> ConvertHeightFieldData(const ALandscape* LandscapeActor, const FHoudiniHeightFieldData& HeightField, const FIntPoint& OutDimensions);
+
+    // Same as above, for a landscape with the given height range (see GetLandscapeHeightRangeInCM). bOutClamped is set if a value was clamped.
+    static TArray<uint16> ConvertHeightFieldData(const FHoudiniHeightFieldData& HeightField, const FIntPoint& OutDimensions, float HeightRangeInCM, bool& bOutClamped);
+
+    // Converts the height field to 8-bit paint layer weights in a single pass, resampling to OutDimensions if needed.
+    // Replaces ReDimensionLandscape + NormalizePaintLayers + quantization. bOutExceededRange is set if a value was above 1.0.
+    static TArray<uint8> ConvertPaintLayerData(const FHoudiniHeightFieldData& HeightField, const FIntPoint& OutDimensions, bool bNormalize, bool& bOutExceededRange);
+
 };
@@ -29,12 +29,14 @@
 #include "HoudiniApi.h"
 #include "HoudiniEngine.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniEngineCookStats.h"
 #include "HoudiniEngineString.h"
 #include "HoudiniEnginePrivatePCH.h"
 #include "HoudiniGenericAttribute.h"
 #include "HoudiniOutput.h"
 #include "HoudiniPackageParams.h"
 #include "HoudiniMeshTranslator.h"
+#include "HoudiniEngineSessionPool.h"
 
 #include "MaterialTypes.h"
 #include "Materials/Material.h"
@@ -61,12 +63,55 @@
 #include "Engine/Texture2D.h"
 #include "Factories/MaterialFactoryNew.h"
 #include "Serialization/BufferWriter.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "HAL/IConsoleManager.h"
 
 #if WITH_EDITOR
 	#include "Factories/MaterialFactoryNew.h"
 	#include "Factories/MaterialInstanceConstantFactoryNew.h"
 #endif
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineParallelTextureExtraction(
+	TEXT("HoudiniEngine.ParallelTextureExtraction"),
+	1,
+	TEXT("When enabled, the textures of the materials that need to be created are extracted ahead of time, one material per session.\n")
+	TEXT("0: Extract the textures one by one on the main session\n")
+	TEXT("1: Extract the textures of different materials in parallel when multiple sessions are available (default)\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineTextureContentHash(
+	TEXT("HoudiniEngine.TextureContentHash"),
+	1,
+	TEXT("When enabled, generated textures whose pixels and settings did not change since the previous cook are not rebuilt.\n")
+	TEXT("0: Always rebuild the textures of changed materials\n")
+	TEXT("1: Compare the extracted images against the hash stored on the existing textures (default)\n")
+);
+
+// Below this number of pixels, the texture conversion is done serially
+static constexpr int64 HoudiniTextureMinParallelPixels = 256 * 256;
+
+// An image extracted ahead of the material creation
+struct FHoudiniPrefetchedImage
+{
+	bool bSuccess = false;
+	HAPI_ImageInfo ImageInfo;
+	TArray<char> Buffer;
+};
+
+// Textures extracted by PrefetchMaterialTextures(), only accessed on the game thread.
+// The images are keyed by material node, texture parameter, plane and packing.
+static TMap<FString, FHoudiniPrefetchedImage> HoudiniPrefetchedImages;
+static TMap<TPair<HAPI_NodeId, HAPI_ParmId>, TArray<FString>> HoudiniPrefetchedImagePlanes;
+static TMap<HAPI_NodeId, HAPI_ImageInfo> HoudiniExtractedImageInfos;
+static bool bHoudiniTexturePrefetchActive = false;
+
+static FString
+GetPrefetchedImageKey(const HAPI_NodeId& InNodeId, const HAPI_ParmId& InParmId, const char* InPlaneType, const HAPI_ImagePacking& InPacking)
+{
+	return FString::Printf(TEXT("%d/%d/%s/%d"), InNodeId, InParmId, ANSI_TO_TCHAR(InPlaneType), (int32)InPacking);
+}
+
 const int32 FHoudiniMaterialTranslator::MaterialExpressionNodeX = -400;
 const int32 FHoudiniMaterialTranslator::MaterialExpressionNodeY = -150;
 const int32 FHoudiniMaterialTranslator::MaterialExpressionNodeStepX = 220;
@@ -285,6 +330,7 @@ FHoudiniMaterialTranslator::CreateHoudiniMaterials(
 	bool bAddDefaultMaterial)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMaterialTranslator::CreateHoudiniMaterials);
+	H_SCOPED_COOK_STAT(EHoudiniCookStage::Materials);
 
 	if (InUniqueMaterialIds.Num() <= 0)
 		return false;
@@ -313,6 +359,33 @@ FHoudiniMaterialTranslator::CreateHoudiniMaterials(
 
 	OutMaterialArray.SetNumZeroed(InUniqueMaterialIds.Num());
 
+	// Extract the textures of the materials that will likely be rebuilt in parallel
+	if (CVarHoudiniEngineParallelTextureExtraction.GetValueOnGameThread() > 0 && FHoudiniEngine::Get().GetNumSessions() > 1)
+	{
+		TArray<HAPI_MaterialInfo> MaterialsToPrefetch;
+		for (const HAPI_MaterialInfo& MaterialInfo : InUniqueMaterialInfos)
+		{
+			if (!MaterialInfo.exists)
+				continue;
+
+			FString MaterialPathName;
+			if (!FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, MaterialInfo, MaterialPathName))
+				continue;
+
+			const FHoudiniMaterialIdentifier MaterialIdentifier(MaterialPathName, true);
+			if (InAllOutputMaterials.Contains(MaterialIdentifier))
+				continue;
+
+			const bool bUpToDate = (bInTreatExistingMaterialsAsUpToDate || !MaterialInfo.hasChanged) && !bForceRecookAll;
+			if (bUpToDate && InMaterials.Contains(MaterialIdentifier))
+				continue;
+
+			MaterialsToPrefetch.Add(MaterialInfo);
+		}
+
+		FHoudiniMaterialTranslator::PrefetchMaterialTextures(MaterialsToPrefetch);
+	}
+
 	for (int32 MaterialIdx = 0; MaterialIdx < InUniqueMaterialIds.Num(); MaterialIdx++)
 	{
 		HAPI_NodeId MaterialId = (HAPI_NodeId)InUniqueMaterialIds[MaterialIdx];
@@ -497,6 +570,8 @@ FHoudiniMaterialTranslator::CreateHoudiniMaterials(
 
 	MaterialFactory->RemoveFromRoot();
 
+	FHoudiniMaterialTranslator::ResetPrefetchedTextures();
+
 	return true;
 }
 
@@ -511,6 +586,8 @@ FHoudiniMaterialTranslator::CreateMaterialInstances(
 	TMap<FHoudiniMaterialIdentifier, TObjectPtr<UMaterialInterface>>& OutMaterials,
 	const bool& bForceRecookAll)
 {
+	H_SCOPED_COOK_STAT(EHoudiniCookStage::Materials);
+
 	// Check the node ID is valid
 	if (InHGPO.AssetId < 0)
 		return false;
@@ -981,11 +1058,34 @@ FHoudiniMaterialTranslator::CreateUnrealTexture(
 	const FCreateTexture2DParameters& TextureParameters,
 	const TextureGroup& LODGroup, 
 	const FString& TextureType,
-	const FString& NodePath)
+	const FString& NodePath,
+	bool& bOutTextureUpdated)
 {
+	bOutTextureUpdated = false;
+
 	if (!IsValid(Package))
 		return nullptr;
 
+	// The content hash is stored in the texture package's metadata along with its node path and texture type,
+	// if they all match, the existing texture was created from the same image and can be kept as is.
+	const uint64 ContentHash = FHoudiniMaterialTranslator::GetTextureContentHash(ImageInfo, ImageBuffer, TextureParameters, LODGroup);
+	const FString ContentHashString = FString::Printf(TEXT("%016llx"), ContentHash);
+	if (IsValid(ExistingTexture) && CVarHoudiniEngineTextureContentHash.GetValueOnGameThread() > 0)
+	{
+		UMetaData* MetaData = Package->GetMetaData();
+		if (IsValid(MetaData)
+			&& MetaData->GetValue(ExistingTexture, HAPI_UNREAL_PACKAGE_META_TEXTURE_CONTENT_HASH).Equals(ContentHashString)
+			&& MetaData->GetValue(ExistingTexture, HAPI_UNREAL_PACKAGE_META_NODE_PATH).Equals(NodePath)
+			&& MetaData->GetValue(ExistingTexture, HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_TYPE).Equals(TextureType)
+			&& ExistingTexture->Source.GetSizeX() == ImageInfo.xRes
+			&& ExistingTexture->Source.GetSizeY() == ImageInfo.yRes)
+		{
+			return ExistingTexture;
+		}
+	}
+
+	bOutTextureUpdated = true;
+
 	UTexture2D * Texture = nullptr;
 	if (ExistingTexture)
 	{
@@ -1019,7 +1119,6 @@ FHoudiniMaterialTranslator::CreateUnrealTexture(
 	uint8 * MipData = Texture->Source.LockMip(0);
 
 	// Create base map.
-	uint8* DestPtr = nullptr;
 	uint32 SrcWidth = ImageInfo.xRes;
 	uint32 SrcHeight = ImageInfo.yRes;
 	const char * SrcData = &ImageBuffer[0];
@@ -1087,49 +1186,51 @@ FHoudiniMaterialTranslator::CreateUnrealTexture(
 			break;
 	}
 
-	for (uint32 y = 0; y < SrcHeight; y++)
+	// Convert the rows in parallel, and look for an actual alpha value in the texture at the same time
+	// to see if we can ignore the texture alpha.
+	const bool bCopyAlpha = TextureParameters.bUseAlpha && PackOffset == 4;
+	std::atomic<bool> bFoundAlphaValue(false);
+	const int64 NumPixels = (int64)SrcWidth * (int64)SrcHeight;
+	ParallelFor(SrcHeight, [&](int32 y)
 	{
-		DestPtr = &MipData[(SrcHeight - 1 - y) * SrcWidth * sizeof(FColor)];
+		uint8* DestPtr = &MipData[(SrcHeight - 1 - y) * SrcWidth * sizeof(FColor)];
+		const char* SrcRow = SrcData + (uint64)y * SrcWidth * PackOffset;
 
+		uint8 MinAlpha = 0xFF;
 		for (uint32 x = 0; x < SrcWidth; x++)
 		{
-			uint32 DataOffset = y * SrcWidth * PackOffset + x * PackOffset;
+			const char* SrcPixel = SrcRow + x * PackOffset;
 
-			*DestPtr++ = *(uint8*)(SrcData + DataOffset + OffsetB); // B
-			*DestPtr++ = *(uint8*)(SrcData + DataOffset + OffsetG); // G
-			*DestPtr++ = *(uint8*)(SrcData + DataOffset + OffsetR); // R
+			*DestPtr++ = *(uint8*)(SrcPixel + OffsetB); // B
+			*DestPtr++ = *(uint8*)(SrcPixel + OffsetG); // G
+			*DestPtr++ = *(uint8*)(SrcPixel + OffsetR); // R
 
-			if (TextureParameters.bUseAlpha && PackOffset == 4)
-				*DestPtr++ = *(uint8*)(SrcData + DataOffset + OffsetA); // A
+			if (bCopyAlpha)
+			{
+				const uint8 Alpha = *(uint8*)(SrcPixel + OffsetA);
+				MinAlpha = FMath::Min(MinAlpha, Alpha);
+				*DestPtr++ = Alpha; // A
+			}
 			else
+			{
 				*DestPtr++ = 0xFF;
+			}
 		}
-	}
 
-	bool bHasAlphaValue = false;
-	if (TextureParameters.bUseAlpha)
-	{
-		// See if there is an actual alpha value in the texture or if we can ignore the texture alpha
-		for (uint32 y = 0; y < SrcHeight; y++)
-		{
-			for (uint32 x = 0; x < SrcWidth; x++)
-			{
-				uint32 DataOffset = y * SrcWidth * 4 + x * 4;
-				if (*(uint8*)(SrcData + DataOffset + 3) != 0xFF)
-				{
-					bHasAlphaValue = true;
-					break;
-				}
-			}
+		if (MinAlpha != 0xFF)
+			bFoundAlphaValue = true;
+	}, NumPixels < HoudiniTextureMinParallelPixels ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
 
-			if (bHasAlphaValue)
-				break;
-		}
-	}
+	const bool bHasAlphaValue = bFoundAlphaValue;
 
 	// Unlock the texture.
 	Texture->Source.UnlockMip(0);
 
+	// Use the content hash as the source id, so identical images share their derived data.
+	Texture->Source.SetId(FGuid((uint32)(ContentHash >> 32), (uint32)ContentHash, (uint32)ImageInfo.xRes, (uint32)ImageInfo.yRes), true);
+	FHoudiniEngineUtils::AddHoudiniMetaInformationToPackage(
+		Package, Texture, HAPI_UNREAL_PACKAGE_META_TEXTURE_CONTENT_HASH, ContentHashString);
+
 	// Texture creation parameters.
 	Texture->SRGB = TextureParameters.bSRGB;
 	Texture->CompressionSettings = TextureParameters.CompressionSettings;
@@ -1151,6 +1252,23 @@ FHoudiniMaterialTranslator::CreateUnrealTexture(
 
 
 
+uint64
+FHoudiniMaterialTranslator::GetTextureContentHash(
+	const HAPI_ImageInfo& ImageInfo,
+	const TArray<char>& ImageBuffer,
+	const FCreateTexture2DParameters& TextureParameters,
+	const TextureGroup& LODGroup)
+{
+	// Hash the settings that affect the texture first, and use them as the seed for the pixels
+	const int32 Settings[] = {
+		ImageInfo.xRes, ImageInfo.yRes, (int32)ImageInfo.packing,
+		TextureParameters.bUseAlpha ? 1 : 0, TextureParameters.bSRGB ? 1 : 0,
+		(int32)TextureParameters.CompressionSettings, (int32)LODGroup };
+
+	const uint64 SettingsHash = CityHash64(reinterpret_cast<const char*>(Settings), sizeof(Settings));
+	return CityHash64WithSeed(ImageBuffer.GetData(), ImageBuffer.Num(), SettingsHash);
+}
+
 bool
 FHoudiniMaterialTranslator::HapiExtractImage(
 	const HAPI_ParmId& NodeParmId, 
@@ -1160,26 +1278,64 @@ FHoudiniMaterialTranslator::HapiExtractImage(
 	HAPI_ImagePacking ImagePacking,
 	bool bRenderToImage,
 	TArray<char>& OutImageBuffer )
+{
+	HoudiniExtractedImageInfos.Remove(MaterialInfo.nodeId);
+
+	if (bHoudiniTexturePrefetchActive)
+	{
+		const FString Key = GetPrefetchedImageKey(MaterialInfo.nodeId, NodeParmId, PlaneType, ImagePacking);
+		FHoudiniPrefetchedImage* PrefetchedImage = HoudiniPrefetchedImages.Find(Key);
+		if (PrefetchedImage && ImageDataFormat == HAPI_IMAGE_DATA_INT8)
+		{
+			if (!PrefetchedImage->bSuccess)
+				return false;
+
+			OutImageBuffer = MoveTemp(PrefetchedImage->Buffer);
+			HoudiniExtractedImageInfos.Add(MaterialInfo.nodeId, PrefetchedImage->ImageInfo);
+			HoudiniPrefetchedImages.Remove(Key);
+			return true;
+		}
+
+		// The image planes might have been served from the prefetch, so the image has not been rendered on the main session.
+		bRenderToImage = true;
+	}
+
+	HAPI_ImageInfo ImageInfo;
+	return HapiExtractImageViaSession(
+		FHoudiniEngine::Get().GetSession(), NodeParmId, MaterialInfo.nodeId, PlaneType,
+		ImageDataFormat, ImagePacking, bRenderToImage, OutImageBuffer, ImageInfo);
+}
+
+bool
+FHoudiniMaterialTranslator::HapiExtractImageViaSession(
+	const HAPI_Session* Session,
+	const HAPI_ParmId& NodeParmId,
+	const HAPI_NodeId& MaterialNodeId,
+	const char * PlaneType,
+	const HAPI_ImageDataFormat& ImageDataFormat,
+	HAPI_ImagePacking ImagePacking,
+	bool bRenderToImage,
+	TArray<char>& OutImageBuffer,
+	HAPI_ImageInfo& OutImageInfo)
 {
 	if (bRenderToImage)
 	{
 		HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::RenderTextureToImage(
-			FHoudiniEngine::Get().GetSession(),
-			MaterialInfo.nodeId, NodeParmId), false);
+			Session, MaterialNodeId, NodeParmId), false);
 	}
 
 	// See if we have the images planes we want
 	int NumImagePlanes = 0;
 	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetImagePlaneCount(
-		FHoudiniEngine::Get().GetSession(), MaterialInfo.nodeId, &NumImagePlanes), false);
+		Session, MaterialNodeId, &NumImagePlanes), false);
 
 	TArray<int32> ImagePlanesSHArray;
 	ImagePlanesSHArray.SetNum(NumImagePlanes);
 	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetImagePlanes(
-		FHoudiniEngine::Get().GetSession(), MaterialInfo.nodeId, ImagePlanesSHArray.GetData(), NumImagePlanes), false);
+		Session, MaterialNodeId, ImagePlanesSHArray.GetData(), NumImagePlanes), false);
 
 	TArray<FString> ImagePlanesStringArray;
-	FHoudiniEngineString::SHArrayToFStringArray(ImagePlanesSHArray, ImagePlanesStringArray);
+	FHoudiniEngineString::SHArrayToFStringArray(ImagePlanesSHArray, ImagePlanesStringArray, Session);
 
 	bool bFound = false;
 	bool bCFound = false;
@@ -1213,21 +1369,18 @@ FHoudiniMaterialTranslator::HapiExtractImage(
 	HAPI_ImageInfo ImageInfo;
 	FHoudiniApi::ImageInfo_Init(&ImageInfo);
 	HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetImageInfo(
-		FHoudiniEngine::Get().GetSession(),
-		MaterialInfo.nodeId, &ImageInfo), false);
+		Session, MaterialNodeId, &ImageInfo), false);
 
 	ImageInfo.dataFormat = ImageDataFormat;
 	ImageInfo.interleaved = true;
 	ImageInfo.packing = ImagePacking;
 
 	HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::SetImageInfo(
-		FHoudiniEngine::Get().GetSession(),
-		MaterialInfo.nodeId, &ImageInfo), false);
+		Session, MaterialNodeId, &ImageInfo), false);
 
 	int32 ImageBufferSize = 0;
 	HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::ExtractImageToMemory(
-		FHoudiniEngine::Get().GetSession(),
-		MaterialInfo.nodeId, HAPI_RAW_FORMAT_NAME,
+		Session, MaterialNodeId, HAPI_RAW_FORMAT_NAME,
 		PlaneType, &ImageBufferSize), false);
 
 	if (ImageBufferSize <= 0)
@@ -1236,18 +1389,203 @@ FHoudiniMaterialTranslator::HapiExtractImage(
 	OutImageBuffer.SetNumUninitialized(ImageBufferSize);
 
 	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetImageMemoryBuffer(
-		FHoudiniEngine::Get().GetSession(),
-		MaterialInfo.nodeId, &OutImageBuffer[0],
+		Session, MaterialNodeId, &OutImageBuffer[0],
 		ImageBufferSize), false);
 
+	OutImageInfo = ImageInfo;
+
 	return true;
 }
 
+HAPI_Result
+FHoudiniMaterialTranslator::HapiGetExtractedImageInfo(const HAPI_MaterialInfo& MaterialInfo, HAPI_ImageInfo& OutImageInfo)
+{
+	// Images extracted from the prefetch were rendered on another session, use the info that was read with them
+	if (const HAPI_ImageInfo* ExtractedImageInfo = HoudiniExtractedImageInfos.Find(MaterialInfo.nodeId))
+	{
+		OutImageInfo = *ExtractedImageInfo;
+		return HAPI_RESULT_SUCCESS;
+	}
+
+	return FHoudiniApi::GetImageInfo(FHoudiniEngine::Get().GetSession(), MaterialInfo.nodeId, &OutImageInfo);
+}
+
+void
+FHoudiniMaterialTranslator::PrefetchMaterialTextures(const TArray<HAPI_MaterialInfo>& InMaterialInfos)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMaterialTranslator::PrefetchMaterialTextures);
+
+	ResetPrefetchedTextures();
+
+	// The rendered image is stored on the material node, so the textures of a single material cannot be extracted
+	// in parallel. Only prefetch when multiple materials can be processed at once.
+	if (InMaterialInfos.Num() < 2)
+		return;
+
+	// A texture of a material to extract
+	struct FTextureJob
+	{
+		HAPI_ParmId ParmId = -1;
+		const char* PlaneType = "";
+		HAPI_ImagePacking Packing = HAPI_IMAGE_PACKING_RGBA;
+		// The image planes are needed by the material component to pick the plane type.
+		bool bNeedsImagePlanes = false;
+	};
+
+	// The texture parameters looked up by the material components, in the same order
+	struct FTextureSlot
+	{
+		const char* FirstParmName;
+		const char* FirstUseParmName;
+		bool bFirstByTag;
+		const char* SecondParmName;
+		const char* SecondUseParmName;
+		bool bSecondByTag;
+		const char* PlaneType;
+		bool bNeedsImagePlanes;
+	};
+
+	static const FTextureSlot TextureSlots[] =
+	{
+		{ HAPI_UNREAL_PARAM_MAP_DIFFUSE_OGL, HAPI_UNREAL_PARAM_MAP_DIFFUSE_OGL_ENABLED, true, HAPI_UNREAL_PARAM_MAP_DIFFUSE, HAPI_UNREAL_PARAM_MAP_DIFFUSE_ENABLED, false, HAPI_UNREAL_MATERIAL_TEXTURE_COLOR_ALPHA, true },
+		{ HAPI_UNREAL_PARAM_MAP_OPACITY_OGL, HAPI_UNREAL_PARAM_MAP_OPACITY_OGL_ENABLED, true, HAPI_UNREAL_PARAM_MAP_OPACITY, HAPI_UNREAL_PARAM_MAP_OPACITY_ENABLED, false, HAPI_UNREAL_MATERIAL_TEXTURE_COLOR_ALPHA, true },
+		{ HAPI_UNREAL_PARAM_MAP_EMISSIVE_OGL, HAPI_UNREAL_PARAM_MAP_EMISSIVE_OGL_ENABLED, true, HAPI_UNREAL_PARAM_MAP_EMISSIVE, HAPI_UNREAL_PARAM_MAP_EMISSIVE_ENABLED, false, HAPI_UNREAL_MATERIAL_TEXTURE_COLOR_ALPHA, true },
+		{ HAPI_UNREAL_PARAM_MAP_NORMAL, HAPI_UNREAL_PARAM_MAP_NORMAL_ENABLED, false, HAPI_UNREAL_PARAM_MAP_NORMAL_OGL, "", true, HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, false },
+		{ HAPI_UNREAL_PARAM_MAP_SPECULAR_OGL, HAPI_UNREAL_PARAM_MAP_SPECULAR_OGL_ENABLED, true, HAPI_UNREAL_PARAM_MAP_SPECULAR, HAPI_UNREAL_PARAM_MAP_SPECULAR_ENABLED, false, HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, false },
+		{ HAPI_UNREAL_PARAM_MAP_ROUGHNESS_OGL, HAPI_UNREAL_PARAM_MAP_ROUGHNESS_OGL_ENABLED, true, HAPI_UNREAL_PARAM_MAP_ROUGHNESS, HAPI_UNREAL_PARAM_MAP_ROUGHNESS_ENABLED, false, HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, false },
+		{ HAPI_UNREAL_PARAM_MAP_METALLIC_OGL, HAPI_UNREAL_PARAM_MAP_METALLIC_OGL_ENABLED, true, HAPI_UNREAL_PARAM_MAP_METALLIC, HAPI_UNREAL_PARAM_MAP_METALLIC_ENABLED, false, HAPI_UNREAL_MATERIAL_TEXTURE_COLOR, false },
+	};
+	const int32 DiffuseSlot = 0;
+	const int32 NormalSlot = 3;
+
+	// Look the texture parameters up on the main session
+	TArray<TArray<FTextureJob>> MaterialJobs;
+	MaterialJobs.SetNum(InMaterialInfos.Num());
+	for (int32 MaterialIdx = 0; MaterialIdx < InMaterialInfos.Num(); MaterialIdx++)
+	{
+		const HAPI_NodeId NodeId = InMaterialInfos[MaterialIdx].nodeId;
+		HAPI_ParmId SlotParmIds[UE_ARRAY_COUNT(TextureSlots)];
+		for (int32 SlotIdx = 0; SlotIdx < UE_ARRAY_COUNT(TextureSlots); SlotIdx++)
+		{
+			const FTextureSlot& Slot = TextureSlots[SlotIdx];
+			HAPI_ParmInfo ParmInfo;
+			HAPI_ParmId ParmId = -1;
+			if (!FindTextureParamByNameOrTag(NodeId, Slot.FirstParmName, Slot.FirstUseParmName, Slot.bFirstByTag, ParmId, ParmInfo))
+			{
+				if (!FindTextureParamByNameOrTag(NodeId, Slot.SecondParmName, Slot.SecondUseParmName, Slot.bSecondByTag, ParmId, ParmInfo))
+					ParmId = -1;
+			}
+
+			SlotParmIds[SlotIdx] = ParmId;
+			if (ParmId < 0)
+				continue;
+
+			FTextureJob& Job = MaterialJobs[MaterialIdx].AddDefaulted_GetRef();
+			Job.ParmId = ParmId;
+			Job.PlaneType = Slot.PlaneType;
+			Job.bNeedsImagePlanes = Slot.bNeedsImagePlanes;
+		}
+
+		// Without a normal map, the normal plane of the diffuse map is used
+		if (SlotParmIds[NormalSlot] < 0 && SlotParmIds[DiffuseSlot] >= 0)
+		{
+			FTextureJob& Job = MaterialJobs[MaterialIdx].AddDefaulted_GetRef();
+			Job.ParmId = SlotParmIds[DiffuseSlot];
+			Job.PlaneType = HAPI_UNREAL_MATERIAL_TEXTURE_NORMAL;
+			Job.Packing = HAPI_IMAGE_PACKING_RGB;
+		}
+	}
+
+	// Each material is processed by a single session, its textures are extracted one after the other
+	TArray<TArray<FHoudiniPrefetchedImage>> MaterialImages;
+	TArray<TArray<TArray<FString>>> MaterialImagePlanes;
+	MaterialImages.SetNum(InMaterialInfos.Num());
+	MaterialImagePlanes.SetNum(InMaterialInfos.Num());
+
+	const int32 NumSessions = FMath::Min(FHoudiniEngine::Get().GetNumSessions(), InMaterialInfos.Num());
+	FHoudiniEngineSessionPool::ExecuteChunks(InMaterialInfos.Num(), NumSessions, 0,
+		[&](const HAPI_Session* Session, int32 MaterialIdx)
+		{
+			const HAPI_NodeId NodeId = InMaterialInfos[MaterialIdx].nodeId;
+			const TArray<FTextureJob>& Jobs = MaterialJobs[MaterialIdx];
+			MaterialImages[MaterialIdx].SetNum(Jobs.Num());
+			MaterialImagePlanes[MaterialIdx].SetNum(Jobs.Num());
+			for (int32 JobIdx = 0; JobIdx < Jobs.Num(); JobIdx++)
+			{
+				const FTextureJob& Job = Jobs[JobIdx];
+				FHoudiniPrefetchedImage& Image = MaterialImages[MaterialIdx][JobIdx];
+				FHoudiniApi::ImageInfo_Init(&Image.ImageInfo);
+
+				if (FHoudiniApi::RenderTextureToImage(Session, NodeId, Job.ParmId) != HAPI_RESULT_SUCCESS)
+					continue;
+
+				if (Job.bNeedsImagePlanes)
+				{
+					TArray<FString>& ImagePlanes = MaterialImagePlanes[MaterialIdx][JobIdx];
+					int32 ImagePlaneCount = 0;
+					if (FHoudiniApi::GetImagePlaneCount(Session, NodeId, &ImagePlaneCount) == HAPI_RESULT_SUCCESS && ImagePlaneCount > 0)
+					{
+						TArray<HAPI_StringHandle> ImagePlaneStringHandles;
+						ImagePlaneStringHandles.SetNumZeroed(ImagePlaneCount);
+						if (FHoudiniApi::GetImagePlanes(Session, NodeId, ImagePlaneStringHandles.GetData(), ImagePlaneCount) == HAPI_RESULT_SUCCESS)
+							FHoudiniEngineString::SHArrayToFStringArray(ImagePlaneStringHandles, ImagePlanes, Session);
+					}
+
+					// The material component won't extract anything without a color plane
+					if (!ImagePlanes.Contains(TEXT(HAPI_UNREAL_MATERIAL_TEXTURE_COLOR)))
+						continue;
+				}
+
+				Image.bSuccess = HapiExtractImageViaSession(
+					Session, Job.ParmId, NodeId, Job.PlaneType, HAPI_IMAGE_DATA_INT8, Job.Packing, false, Image.Buffer, Image.ImageInfo);
+			}
+
+			// Failures are handled by the material components, which fall back to the main session
+			return true;
+		});
+
+	for (int32 MaterialIdx = 0; MaterialIdx < InMaterialInfos.Num(); MaterialIdx++)
+	{
+		const HAPI_NodeId NodeId = InMaterialInfos[MaterialIdx].nodeId;
+		const TArray<FTextureJob>& Jobs = MaterialJobs[MaterialIdx];
+		for (int32 JobIdx = 0; JobIdx < Jobs.Num() && JobIdx < MaterialImages[MaterialIdx].Num(); JobIdx++)
+		{
+			const FTextureJob& Job = Jobs[JobIdx];
+			if (Job.bNeedsImagePlanes)
+				HoudiniPrefetchedImagePlanes.Add(TPair<HAPI_NodeId, HAPI_ParmId>(NodeId, Job.ParmId), MoveTemp(MaterialImagePlanes[MaterialIdx][JobIdx]));
+
+			// Only keep successful extractions, the others are retried on the main session
+			if (MaterialImages[MaterialIdx][JobIdx].bSuccess)
+				HoudiniPrefetchedImages.Add(GetPrefetchedImageKey(NodeId, Job.ParmId, Job.PlaneType, Job.Packing), MoveTemp(MaterialImages[MaterialIdx][JobIdx]));
+		}
+	}
+
+	bHoudiniTexturePrefetchActive = true;
+}
+
+void
+FHoudiniMaterialTranslator::ResetPrefetchedTextures()
+{
+	HoudiniPrefetchedImages.Empty();
+	HoudiniPrefetchedImagePlanes.Empty();
+	HoudiniExtractedImageInfos.Empty();
+	bHoudiniTexturePrefetchActive = false;
+}
+
 bool
 FHoudiniMaterialTranslator::HapiGetImagePlanes(
 	const HAPI_ParmId& NodeParmId, const HAPI_MaterialInfo& MaterialInfo, TArray<FString>& OutImagePlanes)
 {
 	OutImagePlanes.Empty();
+
+	if (bHoudiniTexturePrefetchActive)
+	{
+		if (TArray<FString>* PrefetchedImagePlanes = HoudiniPrefetchedImagePlanes.Find(TPair<HAPI_NodeId, HAPI_ParmId>(MaterialInfo.nodeId, NodeParmId)))
+		{
+			OutImagePlanes = *PrefetchedImagePlanes;
+			return true;
+		}
+	}
 		
 	HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::RenderTextureToImage(
 		FHoudiniEngine::Get().GetSession(),
@@ -1511,9 +1849,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentDiffuse(
 
 			HAPI_ImageInfo ImageInfo;
 			FHoudiniApi::ImageInfo_Init(&ImageInfo);
-			Result = FHoudiniApi::GetImageInfo(
-				FHoudiniEngine::Get().GetSession(),
-				InMaterialInfo.nodeId, &ImageInfo);
+			Result = FHoudiniMaterialTranslator::HapiGetExtractedImageInfo(InMaterialInfo, ImageInfo);
 
 			if (Result == HAPI_RESULT_SUCCESS && ImageInfo.xRes > 0 && ImageInfo.yRes > 0)
 			{
@@ -1548,6 +1884,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentDiffuse(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing diffuse texture, or create new one.
+				bool bTextureDiffuseUpdated = false;
 				TextureDiffuse = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureDiffuse,
 					ImageInfo,
@@ -1557,7 +1894,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentDiffuse(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_DIFFUSE,
-					NodePath);
+					NodePath,
+					bTextureDiffuseUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureDiffuse->SetFlags(RF_Public | RF_Standalone);
@@ -1582,9 +1920,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentDiffuse(
 				if (bCreatedNewTextureDiffuse)
 					FAssetRegistryModule::AssetCreated(TextureDiffuse);
 
-				TextureDiffuse->PreEditChange(nullptr);
-				TextureDiffuse->PostEditChange();
-				TextureDiffuse->MarkPackageDirty();
+				if (bTextureDiffuseUpdated)
+				{
+					TextureDiffuse->PreEditChange(nullptr);
+					TextureDiffuse->PostEditChange();
+					TextureDiffuse->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
@@ -1837,9 +2178,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentOpacityMask(
 				TextureOpacityPackage = Cast< UPackage >(TextureOpacity->GetOuter());
 
 			HAPI_ImageInfo ImageInfo;
-			Result = FHoudiniApi::GetImageInfo(
-				FHoudiniEngine::Get().GetSession(),
-				InMaterialInfo.nodeId, &ImageInfo);
+			Result = FHoudiniMaterialTranslator::HapiGetExtractedImageInfo(InMaterialInfo, ImageInfo);
 
 			if (Result == HAPI_RESULT_SUCCESS && ImageInfo.xRes > 0 && ImageInfo.yRes > 0)
 			{
@@ -1874,6 +2213,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentOpacityMask(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing opacity texture, or create new one.
+				bool bTextureOpacityUpdated = false;
 				TextureOpacity = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureOpacity,
 					ImageInfo,
@@ -1883,7 +2223,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentOpacityMask(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_OPACITY_MASK,
-					NodePath);
+					NodePath,
+					bTextureOpacityUpdated);
 
  				// if (BakeMode == EBakeMode::CookToTemp)
 				TextureOpacity->SetFlags(RF_Public | RF_Standalone);
@@ -1927,9 +2268,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentOpacityMask(
 				if (bCreatedNewTextureOpacity)
 					FAssetRegistryModule::AssetCreated(TextureOpacity);
 
-				TextureOpacity->PreEditChange(nullptr);
-				TextureOpacity->PostEditChange();
-				TextureOpacity->MarkPackageDirty();
+				if (bTextureOpacityUpdated)
+				{
+					TextureOpacity->PreEditChange(nullptr);
+					TextureOpacity->PostEditChange();
+					TextureOpacity->MarkPackageDirty();
+				}
 
 				bExpressionCreated = true;
 			}
@@ -2272,9 +2616,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 
 			HAPI_ImageInfo ImageInfo;
 			FHoudiniApi::ImageInfo_Init(&ImageInfo);
-			Result = FHoudiniApi::GetImageInfo(
-				FHoudiniEngine::Get().GetSession(),
-				InMaterialInfo.nodeId, &ImageInfo);
+			Result = FHoudiniMaterialTranslator::HapiGetExtractedImageInfo(InMaterialInfo, ImageInfo);
 
 			if (Result == HAPI_RESULT_SUCCESS && ImageInfo.xRes > 0 && ImageInfo.yRes > 0)
 			{
@@ -2309,6 +2651,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing normal texture, or create new one.
+				bool bTextureNormalUpdated = false;
 				TextureNormal = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureNormal,
 					ImageInfo,
@@ -2318,7 +2661,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_WorldNormalMap,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_NORMAL,
-					NodePath);
+					NodePath,
+					bTextureNormalUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureNormal->SetFlags(RF_Public | RF_Standalone);
@@ -2353,9 +2697,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 				if (bCreatedNewTextureNormal)
 					FAssetRegistryModule::AssetCreated(TextureNormal);
 
-				TextureNormal->PreEditChange(nullptr);
-				TextureNormal->PostEditChange();
-				TextureNormal->MarkPackageDirty();
+				if (bTextureNormalUpdated)
+				{
+					TextureNormal->PreEditChange(nullptr);
+					TextureNormal->PostEditChange();
+					TextureNormal->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
@@ -2431,8 +2778,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 
 				HAPI_ImageInfo ImageInfo;
 				FHoudiniApi::ImageInfo_Init(&ImageInfo);
-				Result = FHoudiniApi::GetImageInfo(
-					FHoudiniEngine::Get().GetSession(),	InMaterialInfo.nodeId, &ImageInfo);
+				Result = FHoudiniMaterialTranslator::HapiGetExtractedImageInfo(InMaterialInfo, ImageInfo);
 
 				if (Result == HAPI_RESULT_SUCCESS && ImageInfo.xRes > 0 && ImageInfo.yRes > 0)
 				{
@@ -2467,6 +2813,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 					FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 					// Reuse existing normal texture, or create new one.
+					bool bTextureNormalUpdated = false;
 					TextureNormal = FHoudiniMaterialTranslator::CreateUnrealTexture(
 						TextureNormal, 
 						ImageInfo,
@@ -2476,7 +2823,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 						CreateTexture2DParameters,
 						TEXTUREGROUP_WorldNormalMap,
 						HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_NORMAL,
-						NodePath);
+						NodePath,
+						bTextureNormalUpdated);
 
 					//if (BakeMode == EBakeMode::CookToTemp)
 					TextureNormal->SetFlags(RF_Public | RF_Standalone);
@@ -2509,9 +2857,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentNormal(
 					if (bCreatedNewTextureNormal)
 						FAssetRegistryModule::AssetCreated(TextureNormal);
 
-					TextureNormal->PreEditChange(nullptr);
-					TextureNormal->PostEditChange();
-					TextureNormal->MarkPackageDirty();
+					if (bTextureNormalUpdated)
+					{
+						TextureNormal->PreEditChange(nullptr);
+						TextureNormal->PostEditChange();
+						TextureNormal->MarkPackageDirty();
+					}
 
 					bExpressionCreated = true;
 				}
@@ -2625,9 +2976,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentSpecular(
 
 			HAPI_ImageInfo ImageInfo;
 			FHoudiniApi::ImageInfo_Init(&ImageInfo);
-			Result = FHoudiniApi::GetImageInfo(
-				FHoudiniEngine::Get().GetSession(),
-				InMaterialInfo.nodeId, &ImageInfo);
+			Result = FHoudiniMaterialTranslator::HapiGetExtractedImageInfo(InMaterialInfo, ImageInfo);
 
 			if (Result == HAPI_RESULT_SUCCESS && ImageInfo.xRes > 0 && ImageInfo.yRes > 0)
 			{
@@ -2662,6 +3011,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentSpecular(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing specular texture, or create new one.
+				bool bTextureSpecularUpdated = false;
 				TextureSpecular = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureSpecular,
 					ImageInfo,
@@ -2671,7 +3021,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentSpecular(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_SPECULAR,
-					NodePath);
+					NodePath,
+					bTextureSpecularUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureSpecular->SetFlags(RF_Public | RF_Standalone);
@@ -2705,9 +3056,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentSpecular(
 				if (bCreatedNewTextureSpecular)
 					FAssetRegistryModule::AssetCreated(TextureSpecular);
 
-				TextureSpecular->PreEditChange(nullptr);
-				TextureSpecular->PostEditChange();
-				TextureSpecular->MarkPackageDirty();
+				if (bTextureSpecularUpdated)
+				{
+					TextureSpecular->PreEditChange(nullptr);
+					TextureSpecular->PostEditChange();
+					TextureSpecular->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
@@ -2884,9 +3238,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentRoughness(
 
 			HAPI_ImageInfo ImageInfo;
 			FHoudiniApi::ImageInfo_Init(&ImageInfo);
-			Result = FHoudiniApi::GetImageInfo(
-				FHoudiniEngine::Get().GetSession(),
-				InMaterialInfo.nodeId, &ImageInfo);
+			Result = FHoudiniMaterialTranslator::HapiGetExtractedImageInfo(InMaterialInfo, ImageInfo);
 
 			if (Result == HAPI_RESULT_SUCCESS && ImageInfo.xRes > 0 && ImageInfo.yRes > 0)
 			{
@@ -2921,6 +3273,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentRoughness(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing roughness texture, or create new one.
+				bool bTextureRoughnessUpdated = false;
 				TextureRoughness = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureRoughness,
 					ImageInfo,
@@ -2930,7 +3283,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentRoughness(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_ROUGHNESS,
-					NodePath);
+					NodePath,
+					bTextureRoughnessUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureRoughness->SetFlags(RF_Public | RF_Standalone);
@@ -2962,9 +3316,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentRoughness(
 				if (bCreatedNewTextureRoughness)
 					FAssetRegistryModule::AssetCreated(TextureRoughness);
 
-				TextureRoughness->PreEditChange(nullptr);
-				TextureRoughness->PostEditChange();
-				TextureRoughness->MarkPackageDirty();
+				if (bTextureRoughnessUpdated)
+				{
+					TextureRoughness->PreEditChange(nullptr);
+					TextureRoughness->PostEditChange();
+					TextureRoughness->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
@@ -3144,9 +3501,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentMetallic(
 
 			HAPI_ImageInfo ImageInfo;
 			FHoudiniApi::ImageInfo_Init(&ImageInfo);
-			Result = FHoudiniApi::GetImageInfo(
-				FHoudiniEngine::Get().GetSession(),
-				InMaterialInfo.nodeId, &ImageInfo);
+			Result = FHoudiniMaterialTranslator::HapiGetExtractedImageInfo(InMaterialInfo, ImageInfo);
 
 			if (Result == HAPI_RESULT_SUCCESS && ImageInfo.xRes > 0 && ImageInfo.yRes > 0)
 			{
@@ -3182,6 +3537,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentMetallic(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing metallic texture, or create new one.
+				bool bTextureMetallicUpdated = false;
 				TextureMetallic = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureMetallic, 
 					ImageInfo,
@@ -3191,7 +3547,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentMetallic(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_METALLIC,
-					NodePath);
+					NodePath,
+					bTextureMetallicUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureMetallic->SetFlags(RF_Public | RF_Standalone);
@@ -3223,9 +3580,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentMetallic(
 				if (bCreatedNewTextureMetallic)
 					FAssetRegistryModule::AssetCreated(TextureMetallic);
 
-				TextureMetallic->PreEditChange(nullptr);
-				TextureMetallic->PostEditChange();
-				TextureMetallic->MarkPackageDirty();
+				if (bTextureMetallicUpdated)
+				{
+					TextureMetallic->PreEditChange(nullptr);
+					TextureMetallic->PostEditChange();
+					TextureMetallic->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
@@ -3512,9 +3872,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentEmissive(
 
 			HAPI_ImageInfo ImageInfo;
 			FHoudiniApi::ImageInfo_Init(&ImageInfo);
-			Result = FHoudiniApi::GetImageInfo(
-				FHoudiniEngine::Get().GetSession(),
-				InMaterialInfo.nodeId, &ImageInfo);
+			Result = FHoudiniMaterialTranslator::HapiGetExtractedImageInfo(InMaterialInfo, ImageInfo);
 
 			if (Result == HAPI_RESULT_SUCCESS && ImageInfo.xRes > 0 && ImageInfo.yRes > 0)
 			{
@@ -3549,6 +3907,7 @@ FHoudiniMaterialTranslator::CreateMaterialComponentEmissive(
 				FHoudiniMaterialTranslator::GetMaterialRelativePath(InAssetId, InMaterialInfo.nodeId, NodePath);
 
 				// Reuse existing emissive texture, or create new one.
+				bool bTextureEmissiveUpdated = false;
 				TextureEmissive = FHoudiniMaterialTranslator::CreateUnrealTexture(
 					TextureEmissive,
 					ImageInfo,
@@ -3558,7 +3917,8 @@ FHoudiniMaterialTranslator::CreateMaterialComponentEmissive(
 					CreateTexture2DParameters,
 					TEXTUREGROUP_World,
 					HAPI_UNREAL_PACKAGE_META_GENERATED_TEXTURE_EMISSIVE,
-					NodePath);
+					NodePath,
+					bTextureEmissiveUpdated);
 
 				//if (BakeMode == EBakeMode::CookToTemp)
 				TextureEmissive->SetFlags(RF_Public | RF_Standalone);
@@ -3583,9 +3943,12 @@ FHoudiniMaterialTranslator::CreateMaterialComponentEmissive(
 				if (bCreatedNewTextureEmissive)
 					FAssetRegistryModule::AssetCreated(TextureEmissive);
 
-				TextureEmissive->PreEditChange(nullptr);
-				TextureEmissive->PostEditChange();
-				TextureEmissive->MarkPackageDirty();
+				if (bTextureEmissiveUpdated)
+				{
+					TextureEmissive->PreEditChange(nullptr);
+					TextureEmissive->PostEditChange();
+					TextureEmissive->MarkPackageDirty();
+				}
 			}
 
 			// Cache the texture package
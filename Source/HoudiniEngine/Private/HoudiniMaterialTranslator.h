@@ -261,7 +261,9 @@ public:
 		FString& OutMaterialName);
 
 
-	// Create a texture from given information.
+	// Create a texture from an extracted image buffer.
+	// If the existing texture was generated from the same pixels and settings, it is reused as is
+	// and bOutTextureUpdated is set to false.
 	static UTexture2D* CreateUnrealTexture(
 		UTexture2D* ExistingTexture,
 		const HAPI_ImageInfo& ImageInfo,
@@ -271,7 +273,15 @@ public:
 		const FCreateTexture2DParameters& TextureParameters,
 		const TextureGroup& LODGroup,
 		const FString& TextureType,
-		const FString& NodePath);
+		const FString& NodePath,
+		bool& bOutTextureUpdated);
+
+	// Returns the hash of an extracted image buffer and of the settings used to create its texture
+	static uint64 GetTextureContentHash(
+		const HAPI_ImageInfo& ImageInfo,
+		const TArray<char>& ImageBuffer,
+		const FCreateTexture2DParameters& TextureParameters,
+		const TextureGroup& LODGroup);
 
 	// HAPI : Retrieve a list of image planes.
 	static bool HapiExtractImage(
@@ -286,6 +296,28 @@ public:
 	// HAPI : Extract image data.
 	static bool HapiGetImagePlanes(
 		const HAPI_ParmId& NodeParmId, const HAPI_MaterialInfo& MaterialInfo, TArray<FString>& OutImagePlanes);
+
+	// HAPI : Extract image data using the given session.
+	static bool HapiExtractImageViaSession(
+		const HAPI_Session* Session,
+		const HAPI_ParmId& NodeParmId,
+		const HAPI_NodeId& MaterialNodeId,
+		const char * PlaneType,
+		const HAPI_ImageDataFormat& ImageDataFormat,
+		HAPI_ImagePacking ImagePacking,
+		bool bRenderToImage,
+		TArray<char>& OutImageBuffer,
+		HAPI_ImageInfo& OutImageInfo);
+
+	// HAPI : Retrieve the image info of the last image extracted for the given material.
+	static HAPI_Result HapiGetExtractedImageInfo(const HAPI_MaterialInfo& MaterialInfo, HAPI_ImageInfo& OutImageInfo);
+
+	// Extracts the textures of the given materials ahead of their creation, one material per session.
+	// The extracted images are then used by HapiExtractImage() until ResetPrefetchedTextures() is called.
+	static void PrefetchMaterialTextures(const TArray<HAPI_MaterialInfo>& InMaterialInfos);
+
+	// Discards the textures extracted by PrefetchMaterialTextures().
+	static void ResetPrefetchedTextures();
 	
 	// Returns a unique name for a given material, its relative path (to the asset)
 	static bool GetMaterialRelativePath(
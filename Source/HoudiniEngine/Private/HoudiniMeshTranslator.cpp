@@ -33,6 +33,7 @@
 #include "HoudiniGeoPartObject.h"
 #include "HoudiniGenericAttribute.h"
 #include "HoudiniEngineUtils.h"
+#include "HoudiniEngineCookStats.h"
 #include "HoudiniEnginePrivatePCH.h"
 #include "HoudiniMaterialTranslator.h"
 #include "HoudiniAssetActor.h"
@@ -66,8 +67,11 @@
 
 #include "Components/SkeletalMeshComponent.h"
 
+#include "Async/ParallelFor.h"
 #include "ProfilingDebugging/CpuProfilerTrace.h"
 
+#include <atomic>
+
 #include "EditorSupportDelegates.h"
 #include "HoudiniGeometryCollectionTranslator.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
@@ -87,6 +91,24 @@ static TAutoConsoleVariable<float> CVarHoudiniEngineMeshBuildTimer(
 	TEXT("When enabled, the plugin will output timings during the Mesh creation.\n")
 );
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineMeshBuildParallel(
+	TEXT("HoudiniEngine.MeshBuildParallel"),
+	1,
+	TEXT("Controls whether vertex and triangle data of Houdini Static Meshes (proxy meshes) is filled in parallel.\n")
+	TEXT("0: Always use the serial path\n")
+	TEXT("1: Fill large meshes in parallel (default)\n")
+);
+
+// Below this number of elements, the overhead of ParallelFor isn't worth it
+static constexpr int32 HoudiniMeshBuildMinParallelElements = 4096;
+
+static bool
+ShouldFillMeshDataSerially(const int32& InNumElements)
+{
+	return CVarHoudiniEngineMeshBuildParallel.GetValueOnAnyThread() == 0
+		|| InNumElements < HoudiniMeshBuildMinParallelElements;
+}
+
 bool
 FHoudiniMeshTranslator::CreateAllMeshesAndComponentsFromHoudiniOutput(
 	UHoudiniOutput* InOutput, 
@@ -175,6 +197,7 @@ FHoudiniMeshTranslator::CreateOrUpdateAllComponents(
 	bool bInApplyGenericProperties)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshTranslator::CreateOrUpdateAllComponents);
+	H_SCOPED_COOK_STAT(EHoudiniCookStage::Components);
 
 	if (!IsValid(InOutput))
 		return false;
@@ -705,6 +728,7 @@ FHoudiniMeshTranslator::CreateStaticMeshFromHoudiniGeoPartObject(
 	bool bInTreatExistingMaterialsAsUpToDate)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshTranslator::CreateStaticMeshFromHoudiniGeoPartObject);
+	H_SCOPED_COOK_STAT(EHoudiniCookStage::MeshBuild);
 
 	// If we're not forcing the rebuild
 	// No need to recreate something that hasn't changed
@@ -1002,7 +1026,8 @@ FHoudiniMeshTranslator::ResetPartCache()
 	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshTranslator::ResetPartCache);
 
 	// Vertex Positions
-	PartPositions.Empty();
+	PartPositions = TArrayView<const float>();
+	PartPositionsStorage.Empty();
 	FHoudiniApi::AttributeInfo_Init(&AttribInfoPositions);
 
 	// Vertex Normals
@@ -1069,7 +1094,8 @@ FHoudiniMeshTranslator::UpdatePartPositionIfNeeded()
 	FHoudiniHapiAccessor Accessor(HGPO.GeoInfo.NodeId, HGPO.PartInfo.PartId, HAPI_UNREAL_ATTRIB_POSITION);
 	Accessor.GetInfo(AttribInfoPositions);
 
-	if (!Accessor.GetAttributeData(AttribInfoPositions, PartPositions))
+	// Avoid copying the positions if they were prefetched after the cook
+	if (!Accessor.GetAttributeDataView(AttribInfoPositions, PartPositionsStorage, PartPositions))
 	{
 		// Error retrieving positions.
 		HOUDINI_LOG_WARNING(
@@ -3774,16 +3800,18 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 			{
 				TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshTranslator::CreateHoudiniStaticMesh -- Set Vertex Positions);
 
-				bool bHasInvalidPositionIndexData = false;
-				for (int32 VertexPositionIdx = 0; VertexPositionIdx < NumVertexPositions; ++VertexPositionIdx)
-				//ParallelFor(NumVertexPositions, [&](uint32 VertexPositionIdx)
+				// Each vertex only writes its own position, so they can be filled in parallel
+				const double PositionsStartTime = FPlatformTime::Seconds();
+				const bool bFillPositionsSerially = ShouldFillMeshDataSerially(NumVertexPositions);
+				std::atomic<bool> bHasInvalidPositionIndexData = false;
+				ParallelFor(NumVertexPositions, [&](int32 VertexPositionIdx)
 				{
 					int32 NeededVertexIndex = NeededVertices[VertexPositionIdx];
 					if (!PartPositions.IsValidIndex(NeededVertexIndex * 3 + 2))
 					{
 						// Error retrieving positions.
 						bHasInvalidPositionIndexData = true;
-						continue;
+						return;
 					}
 
 					// We need to swap Z and Y coordinate here, and convert from m to cm. 
@@ -3792,7 +3820,13 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 						PartPositions[NeededVertexIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION,
 						PartPositions[NeededVertexIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION
 					));
-				}//);
+				}, bFillPositionsSerially);
+
+				if (bDoTiming)
+				{
+					HOUDINI_LOG_MESSAGE(TEXT("CreateHoudiniStaticMesh() - Positions (%s) in %f seconds."),
+						bFillPositionsSerially ? TEXT("serial") : TEXT("parallel"), FPlatformTime::Seconds() - PositionsStartTime);
+				}
 
 				if (bHasInvalidPositionIndexData)
 				{
@@ -3812,8 +3846,10 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 				TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshTranslator::CreateHoudiniStaticMesh -- Set Triangle Indices & Per Vertex Instance Attribute Values);
 
 				// Now add the triangles to the mesh
-				for (int32 TriangleIdx = 0; TriangleIdx < NumTriangles; ++TriangleIdx)
-				// ParallelFor(NumTriangles, [&](uint32 TriangleIdx)
+				// Each triangle only writes its own indices and vertex instances, so they can be filled in parallel
+				const double TrianglesStartTime = FPlatformTime::Seconds();
+				const bool bFillTrianglesSerially = ShouldFillMeshDataSerially(NumTriangles);
+				ParallelFor(NumTriangles, [&](int32 TriangleIdx)
 				{
 					// TODO: add some additional intermediate consts for index calculations to make the indexing
 					// TODO: code a bit more readable
@@ -3866,9 +3902,9 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 									TangentU.Y = SplitTangentU[TriVertIdx0 * 3 + 3 * ElementIdx + 2];
 									TangentU.Z = SplitTangentU[TriVertIdx0 * 3 + 3 * ElementIdx + 1];
 
-									TangentU.X = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 0];
-									TangentU.Y = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 2];
-									TangentU.Z = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 1];
+									TangentV.X = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 0];
+									TangentV.Y = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 2];
+									TangentV.Z = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 1];
 
 									FoundStaticMesh->SetTriangleVertexUTangent(TriangleIdx, TriWindingIndex[ElementIdx], TangentU);
 									FoundStaticMesh->SetTriangleVertexVTangent(TriangleIdx, TriWindingIndex[ElementIdx], TangentV);
@@ -3935,6 +3971,12 @@ FHoudiniMeshTranslator::CreateHoudiniStaticMesh()
 							}
 						}
 					}
+				}, bFillTrianglesSerially);
+
+				if (bDoTiming)
+				{
+					HOUDINI_LOG_MESSAGE(TEXT("CreateHoudiniStaticMesh() - Triangles (%s) in %f seconds."),
+						bFillTrianglesSerially ? TEXT("serial") : TEXT("parallel"), FPlatformTime::Seconds() - TrianglesStartTime);
 				}
 			}
 
@@ -8144,16 +8186,18 @@ void FHoudiniMeshTranslator::BuildHoudiniMesh(const FString& SplitGroupName, UHo
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshTranslator::CreateHoudiniStaticMesh -- Set Vertex Positions);
 
-		bool bHasInvalidPositionIndexData = false;
-		for (int32 VertexPositionIdx = 0; VertexPositionIdx < NumVertexPositions; ++VertexPositionIdx)
-			//ParallelFor(NumVertexPositions, [&](uint32 VertexPositionIdx)
+		// Each vertex only writes its own position, so they can be filled in parallel
+		const double PositionsStartTime = FPlatformTime::Seconds();
+		const bool bFillPositionsSerially = ShouldFillMeshDataSerially(NumVertexPositions);
+		std::atomic<bool> bHasInvalidPositionIndexData = false;
+		ParallelFor(NumVertexPositions, [&](int32 VertexPositionIdx)
 		{
 			int32 NeededVertexIndex = NeededVertices[VertexPositionIdx];
 			if (!PartPositions.IsValidIndex(NeededVertexIndex * 3 + 2))
 			{
 				// Error retrieving positions.
 				bHasInvalidPositionIndexData = true;
-				continue;
+				return;
 			}
 
 			// We need to swap Z and Y coordinate here, and convert from m to cm. 
@@ -8162,7 +8206,13 @@ void FHoudiniMeshTranslator::BuildHoudiniMesh(const FString& SplitGroupName, UHo
 				PartPositions[NeededVertexIndex * 3 + 2] * HAPI_UNREAL_SCALE_FACTOR_POSITION,
 				PartPositions[NeededVertexIndex * 3 + 1] * HAPI_UNREAL_SCALE_FACTOR_POSITION
 			));
-		}//);
+		}, bFillPositionsSerially);
+
+		if (bDoTiming)
+		{
+			HOUDINI_LOG_MESSAGE(TEXT("CreateHoudiniStaticMesh() - Positions (%s) in %f seconds."),
+				bFillPositionsSerially ? TEXT("serial") : TEXT("parallel"), FPlatformTime::Seconds() - PositionsStartTime);
+		}
 
 		if (bHasInvalidPositionIndexData)
 		{
@@ -8182,8 +8232,10 @@ void FHoudiniMeshTranslator::BuildHoudiniMesh(const FString& SplitGroupName, UHo
 		TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniMeshTranslator::CreateHoudiniStaticMesh -- Set Triangle Indices & Per Vertex Instance Attribute Values);
 
 		// Now add the triangles to the mesh
-		for (int32 TriangleIdx = 0; TriangleIdx < NumTriangles; ++TriangleIdx)
-			// ParallelFor(NumTriangles, [&](uint32 TriangleIdx)
+		// Each triangle only writes its own indices and vertex instances, so they can be filled in parallel
+		const double TrianglesStartTime = FPlatformTime::Seconds();
+		const bool bFillTrianglesSerially = ShouldFillMeshDataSerially(NumTriangles);
+		ParallelFor(NumTriangles, [&](int32 TriangleIdx)
 		{
 			// TODO: add some additional intermediate consts for index calculations to make the indexing
 			// TODO: code a bit more readable
@@ -8236,9 +8288,9 @@ void FHoudiniMeshTranslator::BuildHoudiniMesh(const FString& SplitGroupName, UHo
 							TangentU.Y = SplitTangentU[TriVertIdx0 * 3 + 3 * ElementIdx + 2];
 							TangentU.Z = SplitTangentU[TriVertIdx0 * 3 + 3 * ElementIdx + 1];
 
-							TangentU.X = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 0];
-							TangentU.Y = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 2];
-							TangentU.Z = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 1];
+							TangentV.X = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 0];
+							TangentV.Y = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 2];
+							TangentV.Z = SplitTangentV[TriVertIdx0 * 3 + 3 * ElementIdx + 1];
 
 							FoundStaticMesh->SetTriangleVertexUTangent(TriangleIdx, TriWindingIndex[ElementIdx], TangentU);
 							FoundStaticMesh->SetTriangleVertexVTangent(TriangleIdx, TriWindingIndex[ElementIdx], TangentV);
@@ -8299,6 +8351,12 @@ void FHoudiniMeshTranslator::BuildHoudiniMesh(const FString& SplitGroupName, UHo
 					}
 				}
 			}
+		}, bFillTrianglesSerially);
+
+		if (bDoTiming)
+		{
+			HOUDINI_LOG_MESSAGE(TEXT("CreateHoudiniStaticMesh() - Triangles (%s) in %f seconds."),
+				bFillTrianglesSerially ? TEXT("serial") : TEXT("parallel"), FPlatformTime::Seconds() - TrianglesStartTime);
 		}
 	}
 
@@ -499,8 +499,9 @@ protected:
 		// Vertex Indices for the part
 		TArray<int32> PartVertexList;
 
-		// Positions
-		TArray<float> PartPositions;
+		// Positions, points to the prefetched data when available, to PartPositionsStorage otherwise
+		TArrayView<const float> PartPositions;
+		TArray<float> PartPositionsStorage;
 		HAPI_AttributeInfo AttribInfoPositions;
 
 		// Vertex Normals
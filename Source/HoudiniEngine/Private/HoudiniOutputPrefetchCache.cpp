@@ -0,0 +1,390 @@
+/*
+* Copyright (c) <2024> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniOutputPrefetchCache.h"
+
+#include "HoudiniApi.h"
+#include "HoudiniEngine.h"
+#include "HoudiniEnginePrivatePCH.h"
+#include "HoudiniEngineString.h"
+
+TSharedPtr<FHoudiniOutputPrefetchCache> FHoudiniOutputPrefetchCache::ActiveCache;
+
+// Returns the size of a single element for the numeric storages that can be prefetched, 0 otherwise.
+static int32
+GetPrefetchElementSize(const HAPI_StorageType& InStorage)
+{
+	switch (InStorage)
+	{
+		case HAPI_STORAGETYPE_INT: return sizeof(int32);
+		case HAPI_STORAGETYPE_INT64: return sizeof(HAPI_Int64);
+		case HAPI_STORAGETYPE_FLOAT: return sizeof(float);
+		case HAPI_STORAGETYPE_FLOAT64: return sizeof(double);
+		case HAPI_STORAGETYPE_UINT8: return sizeof(uint8);
+		case HAPI_STORAGETYPE_INT8: return sizeof(int8);
+		case HAPI_STORAGETYPE_INT16: return sizeof(int16);
+		default: return 0;
+	}
+}
+
+TSharedPtr<FHoudiniOutputPrefetchCache>
+FHoudiniOutputPrefetchCache::Fetch(const TArray<HAPI_NodeId>& InOutputNodeIds, const int64& InMaxBytes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniOutputPrefetchCache::Fetch);
+
+	TSharedPtr<FHoudiniOutputPrefetchCache> Cache = MakeShared<FHoudiniOutputPrefetchCache>();
+
+	const HAPI_Session* Session = FHoudiniEngine::Get().GetSession();
+	if (!Session)
+		return Cache;
+
+	for (const HAPI_NodeId& NodeId : InOutputNodeIds)
+	{
+		HAPI_GeoInfo GeoInfo;
+		FHoudiniApi::GeoInfo_Init(&GeoInfo);
+		if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetGeoInfo(Session, NodeId, &GeoInfo))
+			continue;
+
+		for (HAPI_PartId PartId = 0; PartId < GeoInfo.partCount; PartId++)
+		{
+			Cache->FetchPart(Session, GeoInfo.nodeId, PartId, InMaxBytes);
+		}
+	}
+
+	return Cache;
+}
+
+bool
+FHoudiniOutputPrefetchCache::FetchPart(const HAPI_Session* InSession, const HAPI_NodeId& InNodeId, const HAPI_PartId& InPartId, const int64& InMaxBytes)
+{
+	HAPI_PartInfo PartInfo;
+	FHoudiniApi::PartInfo_Init(&PartInfo);
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetPartInfo(InSession, InNodeId, InPartId, &PartInfo))
+		return false;
+
+	// Only add the part once all its attribute infos have been read, as the cache is considered
+	// authoritative for the attributes of the parts it contains.
+	FPrefetchedPart Part;
+	if (PartInfo.type == HAPI_PARTTYPE_MESH)
+		FetchTopology(InSession, InNodeId, PartInfo, InMaxBytes, Part);
+
+	for (int32 OwnerIdx = 0; OwnerIdx < HAPI_ATTROWNER_MAX; OwnerIdx++)
+	{
+		const HAPI_AttributeOwner Owner = (HAPI_AttributeOwner)OwnerIdx;
+		const int32 AttributeCount = PartInfo.attributeCounts[Owner];
+		if (AttributeCount <= 0)
+			continue;
+
+		TArray<HAPI_StringHandle> NameHandles;
+		NameHandles.SetNumZeroed(AttributeCount);
+		if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetAttributeNames(
+			InSession, InNodeId, InPartId, Owner, NameHandles.GetData(), AttributeCount))
+			return false;
+
+		for (const HAPI_StringHandle& NameHandle : NameHandles)
+		{
+			// Resolve the names one by one, string batches can't be used concurrently with the game thread.
+			std::string Name;
+			if (!FHoudiniEngineString::ToStdString(NameHandle, Name, InSession))
+				return false;
+
+			FHoudiniPrefetchedAttribute Attribute;
+			FHoudiniApi::AttributeInfo_Init(&Attribute.Info);
+			if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetAttributeInfo(
+				InSession, InNodeId, InPartId, Name.c_str(), Owner, &Attribute.Info))
+				return false;
+
+			const int32 ElementSize = GetPrefetchElementSize(Attribute.Info.storage);
+			const int64 DataSize = (int64)ElementSize * Attribute.Info.count * Attribute.Info.tupleSize;
+			if (Attribute.Info.exists && DataSize > 0 && DataSize <= MAX_int32 && NumBytes + DataSize <= InMaxBytes)
+			{
+				Attribute.Data.SetNumUninitialized(DataSize);
+				void* Data = Attribute.Data.GetData();
+
+				HAPI_AttributeInfo TempInfo = Attribute.Info;
+				HAPI_Result Result = HAPI_RESULT_FAILURE;
+				switch (Attribute.Info.storage)
+				{
+					case HAPI_STORAGETYPE_INT:
+						Result = FHoudiniApi::GetAttributeIntData(InSession, InNodeId, InPartId, Name.c_str(), &TempInfo, -1, (int32*)Data, 0, TempInfo.count);
+						break;
+					case HAPI_STORAGETYPE_INT64:
+						Result = FHoudiniApi::GetAttributeInt64Data(InSession, InNodeId, InPartId, Name.c_str(), &TempInfo, -1, (HAPI_Int64*)Data, 0, TempInfo.count);
+						break;
+					case HAPI_STORAGETYPE_FLOAT:
+						Result = FHoudiniApi::GetAttributeFloatData(InSession, InNodeId, InPartId, Name.c_str(), &TempInfo, -1, (float*)Data, 0, TempInfo.count);
+						break;
+					case HAPI_STORAGETYPE_FLOAT64:
+						Result = FHoudiniApi::GetAttributeFloat64Data(InSession, InNodeId, InPartId, Name.c_str(), &TempInfo, -1, (double*)Data, 0, TempInfo.count);
+						break;
+					case HAPI_STORAGETYPE_UINT8:
+						Result = FHoudiniApi::GetAttributeUInt8Data(InSession, InNodeId, InPartId, Name.c_str(), &TempInfo, -1, (HAPI_UInt8*)Data, 0, TempInfo.count);
+						break;
+					case HAPI_STORAGETYPE_INT8:
+						Result = FHoudiniApi::GetAttributeInt8Data(InSession, InNodeId, InPartId, Name.c_str(), &TempInfo, -1, (HAPI_Int8*)Data, 0, TempInfo.count);
+						break;
+					case HAPI_STORAGETYPE_INT16:
+						Result = FHoudiniApi::GetAttributeInt16Data(InSession, InNodeId, InPartId, Name.c_str(), &TempInfo, -1, (HAPI_Int16*)Data, 0, TempInfo.count);
+						break;
+					default:
+						break;
+				}
+
+				// Data that failed to be read will simply be fetched again from HAPI
+				if (Result == HAPI_RESULT_SUCCESS)
+					NumBytes += DataSize;
+				else
+					Attribute.Data.Empty();
+			}
+			else if (Attribute.Info.exists && Attribute.Info.storage == HAPI_STORAGETYPE_STRING && Attribute.Info.tupleSize == 1)
+			{
+				const int64 HandlesSize = (int64)Attribute.Info.count * sizeof(HAPI_StringHandle);
+				if (Attribute.Info.count > 0 && NumBytes + HandlesSize <= InMaxBytes)
+				{
+					TArray<HAPI_StringHandle> StringHandles;
+					StringHandles.SetNumUninitialized(Attribute.Info.count);
+					HAPI_AttributeInfo TempInfo = Attribute.Info;
+					if (HAPI_RESULT_SUCCESS == FHoudiniApi::GetAttributeStringData(
+						InSession, InNodeId, InPartId, Name.c_str(), &TempInfo, StringHandles.GetData(), 0, TempInfo.count))
+					{
+						Attribute.StringData.SetNum(StringHandles.Num());
+						if (FHoudiniEngineString::SHArrayToFStringArray_Singles(StringHandles, Attribute.StringData.GetData(), InSession))
+							NumBytes += HandlesSize;
+						else
+							Attribute.StringData.Empty();
+					}
+				}
+			}
+
+			Part.Attributes[Owner].Add(UTF8_TO_TCHAR(Name.c_str()), MoveTemp(Attribute));
+		}
+	}
+
+	Parts.Add(TPair<HAPI_NodeId, HAPI_PartId>(InNodeId, InPartId), MoveTemp(Part));
+	return true;
+}
+
+bool
+FHoudiniOutputPrefetchCache::FetchTopology(
+	const HAPI_Session* InSession,
+	const HAPI_NodeId& InNodeId,
+	const HAPI_PartInfo& InPartInfo,
+	const int64& InMaxBytes,
+	FPrefetchedPart& OutPart)
+{
+	const int64 DataSize = (int64)InPartInfo.faceCount * (sizeof(int32) + sizeof(HAPI_NodeId)) + (int64)InPartInfo.vertexCount * sizeof(int32);
+	if (InPartInfo.faceCount <= 0 || InPartInfo.vertexCount <= 0 || NumBytes + DataSize > InMaxBytes)
+		return false;
+
+	FHoudiniPrefetchedTopology Topology;
+	Topology.FaceCounts.SetNumUninitialized(InPartInfo.faceCount);
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetFaceCounts(
+		InSession, InNodeId, InPartInfo.id, Topology.FaceCounts.GetData(), 0, InPartInfo.faceCount))
+		return false;
+
+	Topology.VertexList.SetNumUninitialized(InPartInfo.vertexCount);
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetVertexList(
+		InSession, InNodeId, InPartInfo.id, Topology.VertexList.GetData(), 0, InPartInfo.vertexCount))
+		return false;
+
+	HAPI_Bool bSingleFaceMaterial = false;
+	Topology.FaceMaterialIds.SetNumUninitialized(InPartInfo.faceCount);
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetMaterialNodeIdsOnFaces(
+		InSession, InNodeId, InPartInfo.id, &bSingleFaceMaterial, Topology.FaceMaterialIds.GetData(), 0, InPartInfo.faceCount))
+		return false;
+
+	Topology.bSingleFaceMaterial = bSingleFaceMaterial;
+	if (Topology.bSingleFaceMaterial)
+		Topology.FaceMaterialIds.SetNum(1);
+
+	NumBytes += DataSize;
+	OutPart.Topology = MoveTemp(Topology);
+	return true;
+}
+
+void
+FHoudiniOutputPrefetchCache::SetActive(const TSharedPtr<FHoudiniOutputPrefetchCache>& InCache)
+{
+	check(IsInGameThread());
+	ActiveCache = InCache;
+}
+
+const FHoudiniOutputPrefetchCache*
+FHoudiniOutputPrefetchCache::GetActive()
+{
+	// Attribute reads made on worker threads always go to HAPI
+	if (!IsInGameThread())
+		return nullptr;
+
+	return ActiveCache.Get();
+}
+
+const FHoudiniPrefetchedAttribute*
+FHoudiniOutputPrefetchCache::FindAttribute(
+	const HAPI_NodeId& InNodeId,
+	const HAPI_PartId& InPartId,
+	const char* InAttributeName,
+	const HAPI_AttributeOwner& InOwner,
+	bool& bOutPartFound) const
+{
+	const FPrefetchedPart* Part = Parts.Find(TPair<HAPI_NodeId, HAPI_PartId>(InNodeId, InPartId));
+	bOutPartFound = Part != nullptr;
+	if (!Part || !InAttributeName || InOwner < 0 || InOwner >= HAPI_ATTROWNER_MAX)
+		return nullptr;
+
+	return Part->Attributes[InOwner].Find(UTF8_TO_TCHAR(InAttributeName));
+}
+
+bool
+FHoudiniOutputPrefetchCache::FindAttributeInfo(
+	const HAPI_NodeId& InNodeId,
+	const HAPI_PartId& InPartId,
+	const char* InAttributeName,
+	const HAPI_AttributeOwner& InOwner,
+	HAPI_AttributeInfo& OutAttributeInfo) const
+{
+	if (!Parts.Contains(TPair<HAPI_NodeId, HAPI_PartId>(InNodeId, InPartId)))
+		return false;
+
+	FHoudiniApi::AttributeInfo_Init(&OutAttributeInfo);
+	OutAttributeInfo.exists = false;
+
+	// Same search order as FHoudiniHapiAccessor::GetInfo
+	const int32 FirstOwner = InOwner == HAPI_ATTROWNER_INVALID ? 0 : InOwner;
+	const int32 LastOwner = InOwner == HAPI_ATTROWNER_INVALID ? HAPI_ATTROWNER_MAX - 1 : InOwner;
+	for (int32 OwnerIdx = FirstOwner; OwnerIdx <= LastOwner; OwnerIdx++)
+	{
+		bool bPartFound = false;
+		const FHoudiniPrefetchedAttribute* Attribute = FindAttribute(InNodeId, InPartId, InAttributeName, (HAPI_AttributeOwner)OwnerIdx, bPartFound);
+		if (Attribute && Attribute->Info.exists)
+		{
+			OutAttributeInfo = Attribute->Info;
+			break;
+		}
+	}
+
+	return true;
+}
+
+const uint8*
+FHoudiniOutputPrefetchCache::FindAttributeData(
+	const HAPI_NodeId& InNodeId,
+	const HAPI_PartId& InPartId,
+	const char* InAttributeName,
+	const HAPI_AttributeInfo& InAttributeInfo,
+	const HAPI_StorageType& InStorage,
+	const int32& InElementSize) const
+{
+	bool bPartFound = false;
+	const FHoudiniPrefetchedAttribute* Attribute = FindAttribute(InNodeId, InPartId, InAttributeName, InAttributeInfo.owner, bPartFound);
+	if (!Attribute || Attribute->Data.Num() <= 0)
+		return nullptr;
+
+	const HAPI_AttributeInfo& Info = Attribute->Info;
+	if (Info.storage != InStorage
+		|| Info.tupleSize != InAttributeInfo.tupleSize
+		|| Info.count != InAttributeInfo.count
+		|| GetPrefetchElementSize(Info.storage) != InElementSize)
+		return nullptr;
+
+	return Attribute->Data.GetData();
+}
+
+bool
+FHoudiniOutputPrefetchCache::GetAttributeData(
+	const HAPI_NodeId& InNodeId,
+	const HAPI_PartId& InPartId,
+	const char* InAttributeName,
+	const HAPI_AttributeInfo& InAttributeInfo,
+	const HAPI_StorageType& InStorage,
+	const int32& InElementSize,
+	void* OutData,
+	const int32& InIndexStart,
+	const int32& InIndexCount) const
+{
+	bool bPartFound = false;
+	const FHoudiniPrefetchedAttribute* Attribute = FindAttribute(InNodeId, InPartId, InAttributeName, InAttributeInfo.owner, bPartFound);
+	if (!Attribute || Attribute->Data.Num() <= 0 || !OutData)
+		return false;
+
+	const HAPI_AttributeInfo& Info = Attribute->Info;
+	if (Info.storage != InStorage
+		|| InAttributeInfo.tupleSize <= 0
+		|| InAttributeInfo.tupleSize > Info.tupleSize
+		|| GetPrefetchElementSize(Info.storage) != InElementSize)
+		return false;
+
+	if (InIndexStart < 0 || InIndexCount < 0 || InIndexStart + InIndexCount > Info.count)
+		return false;
+
+	const int64 SrcTupleBytes = (int64)InElementSize * Info.tupleSize;
+	const int64 DstTupleBytes = (int64)InElementSize * InAttributeInfo.tupleSize;
+	const uint8* Src = Attribute->Data.GetData() + InIndexStart * SrcTupleBytes;
+	if (SrcTupleBytes == DstTupleBytes)
+	{
+		FMemory::Memcpy(OutData, Src, InIndexCount * SrcTupleBytes);
+		return true;
+	}
+
+	// Only keep the first components of each tuple, like HAPI does for smaller tuple sizes
+	uint8* Dst = static_cast<uint8*>(OutData);
+	for (int32 Idx = 0; Idx < InIndexCount; Idx++)
+	{
+		FMemory::Memcpy(Dst, Src, DstTupleBytes);
+		Src += SrcTupleBytes;
+		Dst += DstTupleBytes;
+	}
+	return true;
+}
+
+const FHoudiniPrefetchedTopology*
+FHoudiniOutputPrefetchCache::FindTopology(const HAPI_NodeId& InNodeId, const HAPI_PartId& InPartId) const
+{
+	const FPrefetchedPart* Part = Parts.Find(TPair<HAPI_NodeId, HAPI_PartId>(InNodeId, InPartId));
+	if (!Part || !Part->Topology.IsSet())
+		return nullptr;
+
+	return &Part->Topology.GetValue();
+}
+
+bool
+FHoudiniOutputPrefetchCache::ForEachAttribute(
+	const HAPI_NodeId& InNodeId,
+	const HAPI_PartId& InPartId,
+	TFunctionRef<void(const FString&, const FHoudiniPrefetchedAttribute&)> InFunction) const
+{
+	const FPrefetchedPart* Part = Parts.Find(TPair<HAPI_NodeId, HAPI_PartId>(InNodeId, InPartId));
+	if (!Part)
+		return false;
+
+	for (int32 OwnerIdx = 0; OwnerIdx < HAPI_ATTROWNER_MAX; OwnerIdx++)
+	{
+		for (const auto& Pair : Part->Attributes[OwnerIdx])
+			InFunction(Pair.Key, Pair.Value);
+	}
+
+	return true;
+}
@@ -0,0 +1,147 @@
+/*
+* Copyright (c) <2024> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAPI/HAPI_Common.h"
+
+// Attribute of a prefetched part. Data is only filled for numeric, non-array attributes,
+// StringData for string attributes.
+struct FHoudiniPrefetchedAttribute
+{
+	HAPI_AttributeInfo Info;
+	TArray<uint8> Data;
+	TArray<FString> StringData;
+};
+
+// Faces, vertices and face materials of a prefetched mesh part.
+struct FHoudiniPrefetchedTopology
+{
+	TArray<int32> FaceCounts;
+	TArray<int32> VertexList;
+	TArray<HAPI_NodeId> FaceMaterialIds;
+	bool bSingleFaceMaterial = false;
+};
+
+// Geometry data of a HAC's output nodes, read from HAPI ahead of the output translation.
+//
+// The cache is filled on a worker thread right after a cook. While it is active, attribute infos and data
+// requested through FHoudiniHapiAccessor on the game thread are served from it instead of from the session.
+// The cache only holds plain data, it does not know anything about UObjects.
+class HOUDINIENGINE_API FHoudiniOutputPrefetchCache
+{
+public:
+
+	// Reads the parts, attributes and mesh topologies of the given output nodes. Data is only read until
+	// InMaxBytes is reached. Safe to call from any thread.
+	static TSharedPtr<FHoudiniOutputPrefetchCache> Fetch(const TArray<HAPI_NodeId>& InOutputNodeIds, const int64& InMaxBytes);
+
+	// Sets the cache used by attribute reads on the game thread, pass nullptr to stop using it.
+	static void SetActive(const TSharedPtr<FHoudiniOutputPrefetchCache>& InCache);
+
+	// Returns the active cache, or nullptr. Only valid on the game thread.
+	static const FHoudiniOutputPrefetchCache* GetActive();
+
+	// Looks for an attribute's info. If InOwner is invalid, all owners are searched.
+	// Returns false if the part was not prefetched, in which case HAPI has to be used.
+	bool FindAttributeInfo(
+		const HAPI_NodeId& InNodeId,
+		const HAPI_PartId& InPartId,
+		const char* InAttributeName,
+		const HAPI_AttributeOwner& InOwner,
+		HAPI_AttributeInfo& OutAttributeInfo) const;
+
+	// Returns the prefetched data of an attribute if it was read with the requested storage and tuple size, nullptr otherwise.
+	// The data remains valid as long as the cache is alive.
+	const uint8* FindAttributeData(
+		const HAPI_NodeId& InNodeId,
+		const HAPI_PartId& InPartId,
+		const char* InAttributeName,
+		const HAPI_AttributeInfo& InAttributeInfo,
+		const HAPI_StorageType& InStorage,
+		const int32& InElementSize) const;
+
+	// Copies the tuples [InIndexStart, InIndexStart + InIndexCount[ of an attribute into OutData.
+	// The requested tuple size can be smaller than the attribute's, in which case only the first components are copied.
+	// Returns false if the data was not prefetched with the requested storage.
+	bool GetAttributeData(
+		const HAPI_NodeId& InNodeId,
+		const HAPI_PartId& InPartId,
+		const char* InAttributeName,
+		const HAPI_AttributeInfo& InAttributeInfo,
+		const HAPI_StorageType& InStorage,
+		const int32& InElementSize,
+		void* OutData,
+		const int32& InIndexStart,
+		const int32& InIndexCount) const;
+
+	// Returns the prefetched topology of a mesh part, or nullptr if it was not prefetched.
+	const FHoudiniPrefetchedTopology* FindTopology(const HAPI_NodeId& InNodeId, const HAPI_PartId& InPartId) const;
+
+	// Calls InFunction for each attribute of a prefetched part, in the order HAPI returned them.
+	// Returns false if the part was not prefetched.
+	bool ForEachAttribute(
+		const HAPI_NodeId& InNodeId,
+		const HAPI_PartId& InPartId,
+		TFunctionRef<void(const FString&, const FHoudiniPrefetchedAttribute&)> InFunction) const;
+
+	int64 GetNumBytes() const { return NumBytes; }
+
+private:
+
+	// Attribute names are case sensitive
+	struct FAttributeKeyFuncs : TDefaultMapKeyFuncs<FString, FHoudiniPrefetchedAttribute, false>
+	{
+		static bool Matches(const FString& A, const FString& B) { return A.Equals(B, ESearchCase::CaseSensitive); }
+		static uint32 GetKeyHash(const FString& Key) { return FCrc::StrCrc32(*Key); }
+	};
+
+	using FAttributeMap = TMap<FString, FHoudiniPrefetchedAttribute, FDefaultSetAllocator, FAttributeKeyFuncs>;
+
+	struct FPrefetchedPart
+	{
+		FAttributeMap Attributes[HAPI_ATTROWNER_MAX];
+		TOptional<FHoudiniPrefetchedTopology> Topology;
+	};
+
+	const FHoudiniPrefetchedAttribute* FindAttribute(
+		const HAPI_NodeId& InNodeId,
+		const HAPI_PartId& InPartId,
+		const char* InAttributeName,
+		const HAPI_AttributeOwner& InOwner,
+		bool& bOutPartFound) const;
+
+	bool FetchPart(const HAPI_Session* InSession, const HAPI_NodeId& InNodeId, const HAPI_PartId& InPartId, const int64& InMaxBytes);
+
+	bool FetchTopology(const HAPI_Session* InSession, const HAPI_NodeId& InNodeId, const HAPI_PartInfo& InPartInfo, const int64& InMaxBytes, FPrefetchedPart& OutPart);
+
+	TMap<TPair<HAPI_NodeId, HAPI_PartId>, FPrefetchedPart> Parts;
+
+	int64 NumBytes = 0;
+
+	static TSharedPtr<FHoudiniOutputPrefetchCache> ActiveCache;
+};
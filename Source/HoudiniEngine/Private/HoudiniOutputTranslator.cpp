@@ -35,6 +35,7 @@
 #include "HoudiniEngineUtils.h"
 #include "HoudiniEngineString.h"
 #include "HoudiniGeoPartObject.h"
+#include "HoudiniOutputPrefetchCache.h"
 #include "HoudiniEnginePrivatePCH.h"
 #include "HoudiniAsset.h"
 #include "HoudiniAssetActor.h"
@@ -80,9 +81,19 @@
 #include "HoudiniHLODLayerUtils.h"
 #include <HoudiniAnimationTranslator.h>
 #include "HoudiniFoliageUtils.h"
+#include "Hash/CityHash.h"
 
 #define LOCTEXT_NAMESPACE HOUDINI_LOCTEXT_NAMESPACE
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineIncrementalMeshOutputs(
+	TEXT("HoudiniEngine.IncrementalMeshOutputs"),
+	1,
+	TEXT("Keep the meshes and components of mesh parts whose data hasn't changed since the previous cook.\n")
+	TEXT("Parts are compared using the data read by HoudiniEngine.AsyncOutputFetch, parts that were not entirely prefetched are rebuilt.\n")
+	TEXT("0: Disabled, all mesh outputs are rebuilt after each cook\n")
+	TEXT("1: Enabled (default)\n")
+);
+
 //
 bool
 FHoudiniOutputTranslator::UpdateOutputs(
@@ -95,6 +106,29 @@ FHoudiniOutputTranslator::UpdateOutputs(
 	if (!IsValid(HAC))
 		return false;
 
+	// Set aside the mesh outputs that can be kept if their part hasn't changed,
+	// the other previous outputs are simply destroyed.
+	// Proxy meshes are always rebuilt, so their parts don't need to be fingerprinted.
+	const bool bIsProxyStaticMeshEnabled = HAC->IsProxyStaticMeshEnabled()
+		&& !HAC->HasNoProxyMeshNextCookBeenRequested()
+		&& !HAC->IsBakeAfterNextCookEnabled();
+	const bool bReuseMeshOutputs = !bInForceUpdate
+		&& !bIsProxyStaticMeshEnabled
+		&& CVarHoudiniEngineIncrementalMeshOutputs.GetValueOnGameThread() > 0;
+
+	TArray<TObjectPtr<UHoudiniOutput>> PreviousMeshOutputs;
+	if (bReuseMeshOutputs)
+	{
+		for (int32 Idx = HAC->Outputs.Num() - 1; Idx >= 0; Idx--)
+		{
+			if (!IsReusableMeshOutput(HAC->Outputs[Idx]))
+				continue;
+
+			PreviousMeshOutputs.Add(HAC->Outputs[Idx]);
+			HAC->Outputs.RemoveAt(Idx);
+		}
+	}
+
 	RemovePreviousOutputs(HAC);
 
 	// Outputs that should be cleared, but only AFTER new output processing have taken place.
@@ -110,8 +144,12 @@ FHoudiniOutputTranslator::UpdateOutputs(
 		TMap<HAPI_NodeId, int32> OutputNodeCookCounts = HAC->GetOutputNodeCookCounts();
 		if (FHoudiniOutputTranslator::BuildAllOutputs(
 			HAC->GetAssetId(), HAC, OutputNodes, OutputNodeCookCounts,
-			HAC->Outputs, NewOutputs, HAC->bOutputTemplateGeos, HAC->bUseOutputNodes, HAC->bEnableCurveEditing))
+			HAC->Outputs, NewOutputs, HAC->bOutputTemplateGeos, HAC->bUseOutputNodes, HAC->bEnableCurveEditing, bReuseMeshOutputs))
 		{
+			// Keep the previous meshes/components of the parts that haven't changed
+			if (PreviousMeshOutputs.Num() > 0)
+				ReuseUnchangedMeshOutputs(NewOutputs, PreviousMeshOutputs);
+
 			// NOTE: For now we are currently forcing all outputs to be cleared here. There is still an issue where, in some
 			// circumstances, landscape tiles disappear when clearing outputs after processing.
 			// The reason we may need to defer landscape clearing is to allow the landscape creation code to
@@ -129,6 +167,14 @@ FHoudiniOutputTranslator::UpdateOutputs(
 		ClearAndRemoveOutputs(HAC, DeferredClearOutputs, true);
 	}
 
+	// Destroy the previous mesh outputs that haven't been reused
+	for (auto& PreviousOutput : PreviousMeshOutputs)
+	{
+		if (IsValid(PreviousOutput))
+			PreviousOutput->DestroyCookedData();
+	}
+	PreviousMeshOutputs.Empty();
+
 	// At the moment we don't support controlling KeepTags separately for components and actors, so if we find any
 	// HGPOs with KeepTags set to true, we'll keep the tags on both actors and components. In the future we may
 	// want to control these separately.
@@ -718,6 +764,178 @@ FHoudiniOutputTranslator::RemovePreviousOutputs(UHoudiniAssetComponent* HAC)
 	HAC->Outputs.Empty();
 }
 
+uint64
+FHoudiniOutputTranslator::GetPartFingerprint(const FHoudiniGeoPartObject& InHGPO, const HAPI_PartInfo& InPartInfo)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniOutputTranslator::GetPartFingerprint);
+
+	// Only hash the data that was already read by the output prefetch, never read buffers from HAPI here
+	const FHoudiniOutputPrefetchCache* PrefetchCache = FHoudiniOutputPrefetchCache::GetActive();
+	if (!PrefetchCache)
+		return 0;
+
+	const FHoudiniPrefetchedTopology* Topology = PrefetchCache->FindTopology(InHGPO.GeoId, InHGPO.PartId);
+	if (!Topology)
+		return 0;
+
+	// Split groups (LODs, collisions) are not prefetched, we can't tell if their membership has changed
+	if (InHGPO.SplitGroups.Num() > 0)
+		return 0;
+
+	uint64 Hash = 0;
+	auto HashBytes = [&Hash](const void* InData, const int64 InSize)
+	{
+		if (InData && InSize > 0)
+			Hash = CityHash64WithSeed(static_cast<const char*>(InData), InSize, Hash);
+	};
+
+	auto HashString = [&HashBytes](const FString& InString)
+	{
+		const int32 Length = InString.Len();
+		HashBytes(&Length, sizeof(Length));
+		HashBytes(*InString, Length * sizeof(TCHAR));
+	};
+
+	// Part infos
+	HashBytes(&InPartInfo.type, sizeof(InPartInfo.type));
+	HashBytes(&InPartInfo.faceCount, sizeof(InPartInfo.faceCount));
+	HashBytes(&InPartInfo.vertexCount, sizeof(InPartInfo.vertexCount));
+	HashBytes(&InPartInfo.pointCount, sizeof(InPartInfo.pointCount));
+	HashBytes(InPartInfo.attributeCounts, sizeof(InPartInfo.attributeCounts));
+	HashBytes(&InPartInfo.isInstanced, sizeof(InPartInfo.isInstanced));
+	HashString(InHGPO.PartName);
+
+	// Topology
+	HashBytes(Topology->FaceCounts.GetData(), Topology->FaceCounts.Num() * sizeof(int32));
+	HashBytes(Topology->VertexList.GetData(), Topology->VertexList.Num() * sizeof(int32));
+	HashBytes(Topology->FaceMaterialIds.GetData(), Topology->FaceMaterialIds.Num() * sizeof(HAPI_NodeId));
+
+	// The previous meshes can't be reused if any of the materials they use has changed
+	TSet<HAPI_NodeId> UniqueMaterialIds(Topology->FaceMaterialIds);
+	for (const HAPI_NodeId& MaterialId : UniqueMaterialIds)
+	{
+		if (MaterialId < 0)
+			continue;
+
+		HAPI_MaterialInfo MaterialInfo;
+		FHoudiniApi::MaterialInfo_Init(&MaterialInfo);
+		if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetMaterialInfo(FHoudiniEngine::Get().GetSession(), MaterialId, &MaterialInfo))
+			return 0;
+
+		if (MaterialInfo.hasChanged)
+			return 0;
+	}
+
+	// Attributes, all of them need to have been prefetched
+	bool bAllPrefetched = true;
+	PrefetchCache->ForEachAttribute(InHGPO.GeoId, InHGPO.PartId,
+		[&bAllPrefetched, &HashBytes, &HashString](const FString& InName, const FHoudiniPrefetchedAttribute& InAttribute)
+	{
+		if (!bAllPrefetched || !InAttribute.Info.exists)
+			return;
+
+		HashString(InName);
+		HashBytes(&InAttribute.Info.owner, sizeof(InAttribute.Info.owner));
+		HashBytes(&InAttribute.Info.storage, sizeof(InAttribute.Info.storage));
+		HashBytes(&InAttribute.Info.tupleSize, sizeof(InAttribute.Info.tupleSize));
+		HashBytes(&InAttribute.Info.count, sizeof(InAttribute.Info.count));
+
+		if (InAttribute.Data.Num() > 0)
+		{
+			HashBytes(InAttribute.Data.GetData(), InAttribute.Data.Num());
+		}
+		else if (InAttribute.StringData.Num() > 0)
+		{
+			for (const FString& Value : InAttribute.StringData)
+				HashString(Value);
+		}
+		else if (InAttribute.Info.count > 0)
+		{
+			// Array attributes, or data that didn't fit in the prefetch budget
+			bAllPrefetched = false;
+		}
+	});
+
+	if (!bAllPrefetched)
+		return 0;
+
+	// Keep 0 for invalid fingerprints
+	return Hash != 0 ? Hash : 1;
+}
+
+bool
+FHoudiniOutputTranslator::IsReusableMeshOutput(UHoudiniOutput* InOutput)
+{
+	if (!IsValid(InOutput) || InOutput->GetType() != EHoudiniOutputType::Mesh)
+		return false;
+
+	// Mesh outputs are created per part
+	const TArray<FHoudiniGeoPartObject>& HGPOs = InOutput->GetHoudiniGeoPartObjects();
+	if (HGPOs.Num() != 1 || HGPOs[0].Type != EHoudiniPartType::Mesh || HGPOs[0].PartFingerprint == 0)
+		return false;
+
+	// Let proxies be refined/replaced by a normal rebuild
+	if (InOutput->HasAnyCurrentProxy() || InOutput->IsEditableNode())
+		return false;
+
+	return InOutput->GetOutputObjects().Num() > 0;
+}
+
+void
+FHoudiniOutputTranslator::ReuseUnchangedMeshOutputs(
+	TArray<TObjectPtr<UHoudiniOutput>>& InOutNewOutputs,
+	TArray<TObjectPtr<UHoudiniOutput>>& InOutPreviousOutputs)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniOutputTranslator::ReuseUnchangedMeshOutputs);
+
+	int32 NumReused = 0;
+	for (int32 OutputIdx = 0; OutputIdx < InOutNewOutputs.Num(); OutputIdx++)
+	{
+		UHoudiniOutput* NewOutput = InOutNewOutputs[OutputIdx];
+		if (!IsValid(NewOutput) || NewOutput->GetType() != EHoudiniOutputType::Mesh)
+			continue;
+
+		const TArray<FHoudiniGeoPartObject>& NewHGPOs = NewOutput->GetHoudiniGeoPartObjects();
+		if (NewHGPOs.Num() != 1 || NewHGPOs[0].PartFingerprint == 0)
+			continue;
+
+		const FHoudiniGeoPartObject& NewHGPO = NewHGPOs[0];
+		const int32 PreviousIdx = InOutPreviousOutputs.IndexOfByPredicate([&NewHGPO](const UHoudiniOutput* PreviousOutput)
+		{
+			const FHoudiniGeoPartObject& PreviousHGPO = PreviousOutput->GetHoudiniGeoPartObjects()[0];
+			return PreviousHGPO.AssetId == NewHGPO.AssetId
+				&& PreviousHGPO.ObjectId == NewHGPO.ObjectId
+				&& PreviousHGPO.GeoId == NewHGPO.GeoId
+				&& PreviousHGPO.PartId == NewHGPO.PartId
+				&& PreviousHGPO.bIsTemplated == NewHGPO.bIsTemplated
+				&& PreviousHGPO.PartFingerprint == NewHGPO.PartFingerprint;
+		});
+
+		if (PreviousIdx == INDEX_NONE)
+			continue;
+
+		// Give the new HGPO to the previous output, and flag it as unchanged
+		// so the mesh translator keeps the existing meshes.
+		UHoudiniOutput* PreviousOutput = InOutPreviousOutputs[PreviousIdx];
+		FHoudiniGeoPartObject ReusedHGPO = NewHGPO;
+		ReusedHGPO.bHasGeoChanged = false;
+		ReusedHGPO.bHasPartChanged = false;
+
+		PreviousOutput->MarkAllHGPOsAsStale(true);
+		PreviousOutput->AddNewHGPO(ReusedHGPO);
+		PreviousOutput->DeleteAllStaleHGPOs();
+		PreviousOutput->SetIsEditableNode(NewOutput->IsEditableNode());
+		PreviousOutput->SetIsUpdating(true);
+
+		InOutNewOutputs[OutputIdx] = PreviousOutput;
+		InOutPreviousOutputs.RemoveAt(PreviousIdx);
+		NumReused++;
+	}
+
+	if (NumReused > 0)
+		HOUDINI_LOG_MESSAGE(TEXT("Reused %d unchanged mesh outputs."), NumReused);
+}
+
 bool
 FHoudiniOutputTranslator::BuildStaticMeshesOnHoudiniProxyMeshOutputs(UHoudiniAssetComponent* HAC, bool bInDestroyProxies)
 {
@@ -1075,7 +1293,8 @@ FHoudiniOutputTranslator::BuildAllOutputs(
 	TArray<TObjectPtr<UHoudiniOutput>>& OutNewOutputs,
 	bool InOutputTemplatedGeos,
 	bool InUseOutputNodes, 
-	bool bGatherEditableCurves)
+	bool bGatherEditableCurves,
+	bool bInFingerprintMeshParts)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniOutputTranslator::BuildAllOutputs);
 
@@ -1980,6 +2199,10 @@ FHoudiniOutputTranslator::BuildAllOutputs(
 					}
 				}
 
+				// Fingerprint the mesh's data so the outputs of unchanged parts can be kept
+				if (bInFingerprintMeshParts && CurrentPartType == EHoudiniPartType::Mesh)
+					currentHGPO.PartFingerprint = GetPartFingerprint(currentHGPO, CurrentHapiPartInfo);
+
 				//
 				// Volume Only - Extract volume name/tile index
 				// 
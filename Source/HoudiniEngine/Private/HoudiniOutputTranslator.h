@@ -38,6 +38,7 @@ struct FHoudiniGeoInfo;
 struct FHoudiniPartInfo;
 struct FHoudiniVolumeInfo;
 struct FHoudiniCurveInfo;
+struct FHoudiniGeoPartObject;
 
 enum class EHoudiniOutputType : uint8;
 enum class EHoudiniGeoType : uint8;
@@ -72,7 +73,8 @@ struct HOUDINIENGINE_API FHoudiniOutputTranslator
 		TArray<TObjectPtr<UHoudiniOutput>>& OutNewOutputs,
 		bool InOutputTemplatedGeos,
 		bool InUseOutputNodes,
-		bool bGatherEditableCurves);
+		bool bGatherEditableCurves,
+		bool bInFingerprintMeshParts = false);
 
 	static bool UpdateChangedOutputs(
 		UHoudiniAssetComponent* HAC);
@@ -107,4 +109,17 @@ struct HOUDINIENGINE_API FHoudiniOutputTranslator
 
 	static void RemovePreviousOutputs(UHoudiniAssetComponent* HAC);
 
+	// Returns a hash of a mesh part's infos and of its topology and attributes read by the active output prefetch.
+	// Returns 0 if the part's materials have changed, or if some of its data was not prefetched.
+	static uint64 GetPartFingerprint(const FHoudiniGeoPartObject& InHGPO, const HAPI_PartInfo& InPartInfo);
+
+	// Returns true if the mesh output can be kept for the next cook if its part doesn't change.
+	static bool IsReusableMeshOutput(UHoudiniOutput* InOutput);
+
+	// Replaces the new mesh outputs whose part fingerprint matches a previous output by that previous output,
+	// so their meshes and components are kept. Reused outputs are removed from InOutPreviousOutputs.
+	static void ReuseUnchangedMeshOutputs(
+		TArray<TObjectPtr<UHoudiniOutput>>& InOutNewOutputs,
+		TArray<TObjectPtr<UHoudiniOutput>>& InOutPreviousOutputs);
+
 };
\ No newline at end of file
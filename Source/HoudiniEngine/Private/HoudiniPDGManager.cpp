@@ -29,6 +29,8 @@
 #include "Modules/ModuleManager.h"
 #include "MessageEndpointBuilder.h"
 #include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/RunnableThread.h"
 
 #include "HoudiniApi.h"
 #include "HoudiniAsset.h"
@@ -52,12 +54,233 @@ HOUDINI_PDG_DEFINE_LOG_CATEGORY();
 
 #define LOCTEXT_NAMESPACE HOUDINI_LOCTEXT_NAMESPACE
 
+static TAutoConsoleVariable<int32> CVarHoudiniEnginePDGEventThread(
+	TEXT("HoudiniEngine.PDGEventThread"),
+	1,
+	TEXT("Controls how PDG events are fetched from Houdini Engine.\n")
+	TEXT("0: A fixed number of events is fetched and processed per context on each editor tick\n")
+	TEXT("1: A background thread continuously fetches the events of all contexts, the editor tick processes them in batches (default)\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEnginePDGEventsPerTick(
+	TEXT("HoudiniEngine.PDGEventsPerTick"),
+	2000,
+	TEXT("Maximum number of queued PDG events processed per editor tick when HoudiniEngine.PDGEventThread is enabled.\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEnginePDGEventQueueSize(
+	TEXT("HoudiniEngine.PDGEventQueueSize"),
+	65536,
+	TEXT("Number of queued PDG events above which the PDG event thread stops fetching events until the editor catches up.\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEnginePDGResultValidationBatchSize(
+	TEXT("HoudiniEngine.PDGResultValidationBatchSize"),
+	256,
+	TEXT("Maximum number of work results checked per tick for output actors deleted by the user.\n")
+	TEXT("The check resumes where it stopped on the next tick, cycling through the work results of all TOP nodes,\n")
+	TEXT("and stops once a full cycle found no loaded work result until a new one is loaded.\n")
+	TEXT("0: Check all work results on every tick\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEnginePDGCommandletPoolSize(
+	TEXT("HoudiniEngine.PDGCommandletPoolSize"),
+	1,
+	TEXT("Number of BGEO import commandlets started when async importing of PDG results is enabled.\n")
+	TEXT("Each commandlet is a separate editor process running its own Houdini Engine session (and using its own license).\n")
+	TEXT("Imports are dispatched to the commandlet with the least pending data.\n")
+	TEXT("0: One commandlet per four CPU cores, up to four\n")
+	TEXT("1: A single commandlet (default)\n")
+	TEXT("N: N commandlets\n")
+);
+
+// Returns the number of BGEO import commandlets to start
+static int32
+HoudiniGetPDGCommandletPoolSize()
+{
+	const int32 PoolSize = CVarHoudiniEnginePDGCommandletPoolSize.GetValueOnGameThread();
+	if (PoolSize > 0)
+		return PoolSize;
+
+	// Only size the pool from the CPU count when explicitly requested
+	return FMath::Clamp(FPlatformMisc::NumberOfCores() / 4, 1, 4);
+}
+
+// Number of events requested per GetPDGEvents call by the event pump
+static const int32 HoudiniPDGEventPumpBatchSize = 512;
+
+// Sleep time (in seconds) between each poll when no event was received
+const float
+FHoudiniPDGEventPump::UpdateFrequency = 0.02f;
+
+FHoudiniPDGEventPump::FHoudiniPDGEventPump()
+	: NumQueuedEvents(0)
+	, NumRemainingEvents(0)
+	, WakeUpEvent(EEventMode::AutoReset)
+	, bActive(false)
+	, bStopping(false)
+	, bHasSession(false)
+	, SessionKey(INDEX_NONE)
+	, SessionGeneration(0)
+{
+	Session.type = HAPI_SESSION_MAX;
+	Session.id = -1;
+}
+
+FHoudiniPDGEventPump::~FHoudiniPDGEventPump()
+{
+}
+
+uint32
+FHoudiniPDGEventPump::Run()
+{
+	while (!bStopping)
+	{
+		int32 NumPumpedEvents = 0;
+		if (bActive && NumQueuedEvents.load() < CVarHoudiniEnginePDGEventQueueSize.GetValueOnAnyThread())
+		{
+			// Keep the lock while polling, so the session can't be closed under us
+			FScopeLock Lock(&SessionLock);
+			if (bHasSession)
+				NumPumpedEvents = PumpEvents(&Session, SessionGeneration.load());
+		}
+
+		// Keep draining as long as HAPI has events for us, otherwise wait for the next poll
+		if (NumPumpedEvents <= 0)
+			WakeUpEvent->Wait(FTimespan::FromSeconds(UpdateFrequency));
+	}
+
+	return 0;
+}
+
+void
+FHoudiniPDGEventPump::Stop()
+{
+	bStopping = true;
+	WakeUpEvent->Trigger();
+}
+
+void
+FHoudiniPDGEventPump::SetActive(const bool bInActive)
+{
+	if (bActive.exchange(bInActive) != bInActive && bInActive)
+		WakeUpEvent->Trigger();
+}
+
+void
+FHoudiniPDGEventPump::SetSession(const HAPI_Session* InSession)
+{
+	const int64 NewSessionKey = GetSessionKey(InSession);
+	if (SessionKey.load() == NewSessionKey)
+		return;
+
+	{
+		FScopeLock Lock(&SessionLock);
+		bHasSession = InSession != nullptr;
+		if (InSession)
+			Session = *InSession;
+
+		SessionKey = NewSessionKey;
+		SessionGeneration++;
+		NumRemainingEvents = 0;
+	}
+
+	if (InSession && bActive)
+		WakeUpEvent->Trigger();
+}
+
+int64
+FHoudiniPDGEventPump::GetSessionKey(const HAPI_Session* InSession)
+{
+	if (!InSession)
+		return INDEX_NONE;
+
+	return ((int64)InSession->type << 32) | (uint32)InSession->id;
+}
+
+bool
+FHoudiniPDGEventPump::DequeueEvent(FHoudiniPDGEvent& OutEvent)
+{
+	// Skip the events fetched from a previous session, their context and node ids are meaningless now
+	while (Events.Dequeue(OutEvent))
+	{
+		NumQueuedEvents--;
+		if (OutEvent.SessionGeneration == SessionGeneration.load())
+			return true;
+	}
+
+	return false;
+}
+
+int32
+FHoudiniPDGEventPump::PumpEvents(const HAPI_Session* InSession, const uint32& InSessionGeneration)
+{
+	// Get the current PDG graph contexts
+	int32 NumContexts = 0;
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetPDGGraphContextsCount(InSession, &NumContexts) || NumContexts <= 0)
+	{
+		NumRemainingEvents = 0;
+		return 0;
+	}
+
+	ContextNames.SetNum(NumContexts);
+	ContextIDs.SetNum(NumContexts);
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetPDGGraphContexts(
+		InSession, ContextNames.GetData(), ContextIDs.GetData(), 0, NumContexts))
+	{
+		NumRemainingEvents = 0;
+		return 0;
+	}
+
+	if (EventInfos.Num() != HoudiniPDGEventPumpBatchSize)
+		EventInfos.SetNum(HoudiniPDGEventPumpBatchSize);
+
+	// Fetch one batch per context, so a busy context can't starve the others
+	int32 NumPumpedEvents = 0;
+	int32 NumRemaining = 0;
+	for (const HAPI_PDG_GraphContextId& CurrentContextID : ContextIDs)
+	{
+		int32 PDGEventCount = 0;
+		int32 RemainingPDGEventCount = 0;
+		HAPI_Result Result = FHoudiniApi::GetPDGEvents(InSession,
+			CurrentContextID, EventInfos.GetData(), HoudiniPDGEventPumpBatchSize, &PDGEventCount, &RemainingPDGEventCount);
+
+		if (Result != HAPI_RESULT_SUCCESS)
+		{
+			HOUDINI_LOG_ERROR(TEXT("Failed to get PDG events, error code: %d"), Result);
+			continue;
+		}
+
+		for (int32 EventIdx = 0; EventIdx < PDGEventCount; EventIdx++)
+		{
+			FHoudiniPDGEvent Event;
+			Event.ContextId = CurrentContextID;
+			Event.EventInfo = EventInfos[EventIdx];
+			Event.SessionGeneration = InSessionGeneration;
+
+			// Decode the message now, as its string handle may not outlive the next GetPDGEvents call
+			if (Event.EventInfo.msgSH >= 0)
+				FHoudiniEngineString::ToFString(Event.EventInfo.msgSH, Event.Message, InSession);
+
+			Events.Enqueue(MoveTemp(Event));
+			NumQueuedEvents++;
+		}
+
+		NumPumpedEvents += PDGEventCount;
+		NumRemaining += RemainingPDGEventCount;
+	}
+
+	NumRemainingEvents = NumRemaining;
+	return NumPumpedEvents;
+}
+
 FHoudiniPDGManager::FHoudiniPDGManager()
 {
 }
 
 FHoudiniPDGManager::~FHoudiniPDGManager()
 {
+	StopPDGEventPump();
 }
 
 bool
@@ -131,6 +354,7 @@ FHoudiniPDGManager::InitializePDGAssetLink(UHoudiniAssetComponent* InHAC)
 		// Register this PDG Asset Link to the PDG Manager
 		TWeakObjectPtr<UHoudiniPDGAssetLink> AssetLinkPtr(PDGAssetLink);
 		PDGAssetLinks.Add(AssetLinkPtr);
+		bTOPNodeEntriesDirty = true;
 	}
 
 	// If the commandlet is enabled, check if we have started and established communication with the commandlet yet
@@ -378,6 +602,7 @@ FHoudiniPDGManager::PopulateTOPNetworks(UHoudiniPDGAssetLink* PDGAssetLink, bool
 	}
 	//PDGAssetLink->ClearAllTOPData();
 	PDGAssetLink->AllTOPNetworks = AllTOPNetworks;
+	bTOPNodeEntriesDirty = true;
 
 	return (AllTOPNetworks.Num() > 0);
 }
@@ -484,6 +709,7 @@ FHoudiniPDGManager::PopulateTOPNodes(
 	}
 
 	InTOPNetwork->AllTOPNodes = AllTOPNodes;
+	bTOPNodeEntriesDirty = true;
 
 	return (TOPNodeCount > 0);
 }
@@ -687,6 +913,7 @@ FHoudiniPDGManager::Update()
 		if (!Ptr.IsValid() || Ptr.IsStale())
 		{
 			PDGAssetLinks.RemoveAt(Idx);
+			bTOPNodeEntriesDirty = true;
 			continue;
 		}
 
@@ -694,13 +921,18 @@ FHoudiniPDGManager::Update()
 		if (!IsValid(CurPDGAssetLink))
 		{
 			PDGAssetLinks.RemoveAt(Idx);
+			bTOPNodeEntriesDirty = true;
 			continue;
 		}
 	}
 
 	// Do nothing if we dont have any valid PDG asset Link
 	if (PDGAssetLinks.Num() <= 0)
+	{
+		if (PDGEventPump)
+			PDGEventPump->SetActive(false);
 		return;
+	}
 
 	// Update the PDG contexts and handle all pdg events and work item status updates
 	UpdatePDGContexts();
@@ -715,62 +947,69 @@ FHoudiniPDGManager::Update()
 void
 FHoudiniPDGManager::UpdatePDGContexts()
 {
-	// Get current PDG graph contexts
-	ReinitializePDGContext();
+	if (CVarHoudiniEnginePDGEventThread.GetValueOnGameThread() > 0)
+	{
+		// Events are fetched by the event pump thread, only process the next batch of queued events
+		StartPDGEventPump();
+		if (PDGEventPump)
+		{
+			PDGEventPump->SetSession(FHoudiniEngine::Get().GetSession());
+			PDGEventPump->SetActive(true);
+		}
 
-	// Process next set of events for each graph context
-	if (PDGContextIDs.Num() > 0)
+		ProcessQueuedPDGEvents();
+	}
+	else
 	{
-		// Only initialize event array if not valid, or user resized max size
-		if(PDGEventInfos.Num() != MaxNumberOfPDGEvents)
-			PDGEventInfos.SetNum(MaxNumberOfPDGEvents);
+		// Process the events left over by the event pump before fetching new ones
+		if (PDGEventPump)
+		{
+			PDGEventPump->SetActive(false);
+			ProcessQueuedPDGEvents();
+		}
+
+		// Get current PDG graph contexts
+		ReinitializePDGContext();
 
-		// TODO: member?
-		//HAPI_PDG_State PDGState;
-		for(const HAPI_PDG_GraphContextId& CurrentContextID : PDGContextIDs)
+		// Process next set of events for each graph context
+		if (PDGContextIDs.Num() > 0)
 		{
-			/*
-			// TODO: No need to reset events at each tick
-			int32 PDGStateInt;
-			if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetPDGState(
-			FHoudiniEngine::Get().GetSession(), CurrentContextID, &PDGStateInt))
-			{
-			HOUDINI_LOG_ERROR(TEXT("Failed to get PDG state"));
-			continue;
-			}
+			// Only initialize event array if not valid, or user resized max size
+			if(PDGEventInfos.Num() != MaxNumberOfPDGEvents)
+				PDGEventInfos.SetNum(MaxNumberOfPDGEvents);
 
-			PDGState = (HAPI_PDG_State)PDGStateInt;
-			
-			for (int32 Idx = 0; Idx < PDGEventInfos.Num(); Idx++)
+			for(const HAPI_PDG_GraphContextId& CurrentContextID : PDGContextIDs)
 			{
-			ResetPDGEventInfo(PDGEventInfos[Idx]);
-			}
-			*/
+				int32 PDGEventCount = 0;
+				int32 RemainingPDGEventCount = 0;
 
-			int32 PDGEventCount = 0;
-			int32 RemainingPDGEventCount = 0;
+				HAPI_Result Result = FHoudiniApi::GetPDGEvents(FHoudiniEngine::Get().GetSession(), 
+					CurrentContextID, PDGEventInfos.GetData(),  MaxNumberOfPDGEvents, &PDGEventCount, &RemainingPDGEventCount);
 
-			HAPI_Result Result = FHoudiniApi::GetPDGEvents(FHoudiniEngine::Get().GetSession(), 
-				CurrentContextID, PDGEventInfos.GetData(),  MaxNumberOfPDGEvents, &PDGEventCount, &RemainingPDGEventCount);
+				if (Result != HAPI_RESULT_SUCCESS)
+				{
+					HOUDINI_LOG_ERROR(TEXT("Failed to get PDG events, error code: %d"), Result);
+					continue;
+				}
 
-			if (Result != HAPI_RESULT_SUCCESS)
-			{
-				HOUDINI_LOG_ERROR(TEXT("Failed to get PDG events, error code: %d"), Result);
-				continue;
-			}
+				if (PDGEventCount < 1)
+					continue;
+				
+				for (int32 EventIdx = 0; EventIdx < PDGEventCount; EventIdx++)
+				{
+					FString EventMsg;
+					if (PDGEventInfos[EventIdx].msgSH >= 0)
+						FHoudiniEngineString::ToFString(PDGEventInfos[EventIdx].msgSH, EventMsg);
 
-			if (PDGEventCount < 1)
-				continue;
-			
-			for (int32 EventIdx = 0; EventIdx < PDGEventCount; EventIdx++)
-			{
-				ProcessPDGEvent(CurrentContextID, PDGEventInfos[EventIdx]);
-			}
+					ProcessPDGEvent(CurrentContextID, PDGEventInfos[EventIdx], EventMsg);
+				}
 
-			HOUDINI_LOG_MESSAGE(TEXT("PDG: Tick processed %d events, %d remaining."), PDGEventCount, RemainingPDGEventCount);
+				HOUDINI_LOG_MESSAGE(TEXT("PDG: Tick processed %d events, %d remaining."), PDGEventCount, RemainingPDGEventCount);
+			}
 		}
 	}
 
+	// Tallies and UI are refreshed once per asset link per tick, regardless of the number of events processed
 	for (auto CurAssetLink : PDGAssetLinks)
 	{
 		UHoudiniPDGAssetLink* const AssetLink = CurAssetLink.Get();
@@ -821,9 +1060,79 @@ FHoudiniPDGManager::ReinitializePDGContext()
 	}
 }
 
+void
+FHoudiniPDGManager::StartPDGEventPump()
+{
+	if (PDGEventPump)
+		return;
+
+	PDGEventPump = new FHoudiniPDGEventPump();
+	PDGEventPumpThread = FRunnableThread::Create(PDGEventPump, TEXT("HoudiniPDGEventThread"), 0, TPri_BelowNormal);
+	if (!PDGEventPumpThread)
+	{
+		HOUDINI_LOG_WARNING(TEXT("Failed to create the PDG event thread, PDG events will be fetched on the game thread."));
+		delete PDGEventPump;
+		PDGEventPump = nullptr;
+		CVarHoudiniEnginePDGEventThread->Set(0);
+	}
+}
+
+void
+FHoudiniPDGManager::StopPDGEventPump()
+{
+	if (PDGEventPump)
+		PDGEventPump->Stop();
+
+	if (PDGEventPumpThread)
+	{
+		PDGEventPumpThread->WaitForCompletion();
+		delete PDGEventPumpThread;
+		PDGEventPumpThread = nullptr;
+	}
+
+	if (PDGEventPump)
+	{
+		delete PDGEventPump;
+		PDGEventPump = nullptr;
+	}
+}
+
+void
+FHoudiniPDGManager::DetachPDGEventPumpSession()
+{
+	if (PDGEventPump)
+		PDGEventPump->SetSession(nullptr);
+}
+
+int32
+FHoudiniPDGManager::ProcessQueuedPDGEvents()
+{
+	if (!PDGEventPump)
+		return 0;
+
+	// Only process a bounded number of events per tick to keep the editor responsive,
+	// the remaining ones stay queued until the next tick.
+	const int32 MaxEvents = FMath::Max(1, CVarHoudiniEnginePDGEventsPerTick.GetValueOnGameThread());
+	int32 NumProcessed = 0;
+	FHoudiniPDGEvent Event;
+	while (NumProcessed < MaxEvents && PDGEventPump->DequeueEvent(Event))
+	{
+		ProcessPDGEvent(Event.ContextId, Event.EventInfo, Event.Message);
+		NumProcessed++;
+	}
+
+	if (NumProcessed > 0)
+	{
+		HOUDINI_LOG_MESSAGE(TEXT("PDG: Tick processed %d events, %d queued, %d remaining."),
+			NumProcessed, PDGEventPump->GetNumQueuedEvents(), PDGEventPump->GetNumRemainingEvents());
+	}
+
+	return NumProcessed;
+}
+
 // Process a PDG event. Notify the relevant PDGAssetLink object.
 void
-FHoudiniPDGManager::ProcessPDGEvent(const HAPI_PDG_GraphContextId& InContextID, HAPI_PDG_EventInfo& EventInfo)
+FHoudiniPDGManager::ProcessPDGEvent(const HAPI_PDG_GraphContextId& InContextID, const HAPI_PDG_EventInfo& EventInfo, const FString& InEventMsg)
 {
 	UHoudiniPDGAssetLink* PDGAssetLink = nullptr;
 	UTOPNetwork* TOPNetwork = nullptr;
@@ -1038,27 +1347,22 @@ FHoudiniPDGManager::ProcessPDGEvent(const HAPI_PDG_GraphContextId& InContextID,
 		}
 	}
 
-	if (EventInfo.msgSH >= 0)
+	if (!InEventMsg.IsEmpty())
 	{
-		FString EventMsg;
-		FHoudiniEngineString::ToFString(EventInfo.msgSH, EventMsg);
-		if (!EventMsg.IsEmpty())
+		// TODO: Event MSG?
+		// Somehow update the PDG event msg UI ??
+		// Simply log for now...
+		if (MsgColor == FLinearColor::Red)
 		{
-			// TODO: Event MSG?
-			// Somehow update the PDG event msg UI ??
-			// Simply log for now...
-			if (MsgColor == FLinearColor::Red)
-			{
-				HOUDINI_LOG_ERROR(TEXT("%s"), *EventMsg);
-			}
-			else if (MsgColor == FLinearColor::Yellow)
-			{
-				HOUDINI_LOG_WARNING(TEXT("%s"), *EventMsg);
-			}
-			else
-			{
-				HOUDINI_LOG_MESSAGE(TEXT("%s"), *EventMsg);
-			}
+			HOUDINI_LOG_ERROR(TEXT("%s"), *InEventMsg);
+		}
+		else if (MsgColor == FLinearColor::Yellow)
+		{
+			HOUDINI_LOG_WARNING(TEXT("%s"), *InEventMsg);
+		}
+		else
+		{
+			HOUDINI_LOG_MESSAGE(TEXT("%s"), *InEventMsg);
 		}
 	}
 }
@@ -1475,7 +1779,7 @@ FHoudiniPDGManager::CreateOrRelinkWorkItemResult(
 				ExistingResultObject.SetAutoBakedSinceLastLoad(false);
 				if (ExistingResultObject.State == EPDGWorkResultState::Loaded && !bInLoadResultObjects)
 				{
-					ExistingResultObject.State = EPDGWorkResultState::ToDelete;
+					InTOPNode->SetWorkResultObjectState(ExistingResultObject, EPDGWorkResultState::ToDelete);
 				}
 				else
 				{
@@ -1493,11 +1797,12 @@ FHoudiniPDGManager::CreateOrRelinkWorkItemResult(
 						 ExistingResultObject.State ==  EPDGWorkResultState::ToDelete ||
 						 ExistingResultObject.State == EPDGWorkResultState::Deleting) && bInLoadResultObjects)
 					{
-						ExistingResultObject.State = EPDGWorkResultState::ToLoad;
+						InTOPNode->SetWorkResultObjectState(ExistingResultObject, EPDGWorkResultState::ToLoad);
 					}
 					else
 					{
-						ExistingResultObject.State = bInLoadResultObjects ? EPDGWorkResultState::ToLoad : EPDGWorkResultState::NotLoaded;
+						InTOPNode->SetWorkResultObjectState(
+							ExistingResultObject, bInLoadResultObjects ? EPDGWorkResultState::ToLoad : EPDGWorkResultState::NotLoaded);
 					}
 				}
 
@@ -1525,7 +1830,20 @@ FHoudiniPDGManager::CreateOrRelinkWorkItemResult(
 			continue;
 		InTOPNode->DeleteWorkResultObjectOutputs(WorkResultArrayIndex, ResultObjectIndex);
 	}
+	InTOPNode->OnWorkResultObjectsRemoved(WorkResult->ResultObjects);
 	WorkResult->ResultObjects = NewResultObjects;
+	InTOPNode->OnWorkResultObjectsAdded(WorkResult->ResultObjects);
+
+	// Queue the work item if it has results to load or delete, so ProcessWorkItemResults picks it up without
+	// scanning the whole node
+	for (const FTOPWorkResultObject& ResultObject : WorkResult->ResultObjects)
+	{
+		if (ResultObject.State == EPDGWorkResultState::ToLoad || ResultObject.State == EPDGWorkResultState::ToDelete)
+		{
+			EnqueueWorkItemResult(InTOPNode, InWorkItemID);
+			break;
+		}
+	}
 
 	return true;
 }
@@ -1591,6 +1909,7 @@ FHoudiniPDGManager::SyncAndPruneWorkItems(UTOPNode* InTOPNode)
 			HOUDINI_PDG_WARNING(
 				TEXT("Pruning a FTOPWorkResult entry from TOP Node %d, WorkItemID %d, WorkItemIndex %d, Array Index %d"),
 				InTOPNode->NodeId, WorkResult.WorkItemID, WorkResult.WorkItemIndex, Index);
+			InTOPNode->OnWorkResultObjectsRemoved(WorkResult.ResultObjects);
 			WorkResult.ClearAndDestroyResultObjects(HoudiniComponentGuid);
 			InTOPNode->WorkResult.RemoveAt(Index);
 			InTOPNode->OnWorkItemRemoved(WorkResult.WorkItemID);
@@ -1609,177 +1928,334 @@ FHoudiniPDGManager::SyncAndPruneWorkItems(UTOPNode* InTOPNode)
 	return NumRemoved;
 }
 
+// Package parameters and mesh build settings used when loading the work results of an asset link
+struct FHoudiniPDGResultLoadParams
+{
+	FHoudiniPackageParams PackageParams;
+	FHoudiniStaticMeshGenerationProperties StaticMeshGenerationProperties;
+	FMeshBuildSettings MeshBuildSettings;
+};
+
+// Fills the load parameters for the work results of InAssetLink
+static void
+HoudiniInitPDGResultLoadParams(UHoudiniPDGAssetLink* InAssetLink, FHoudiniPDGResultLoadParams& OutLoadParams)
+{
+	// Set up package parameters to:
+	// Cook to temp houdini engine directory
+	// and if the PDG asset link is associated with a Houdini Asset Component (HAC):
+	//		set the outer package to the HAC
+	//		set the HoudiniAssetName according to the HAC
+	//		set the ComponentGUID according to the HAC
+	// otherwise we set the outer to the asset link's parent and leave naming and GUID blank
+	FHoudiniPackageParams& PackageParams = OutLoadParams.PackageParams;
+	PackageParams.PackageMode = FHoudiniPackageParams::GetDefaultStaticMeshesCookMode();
+	PackageParams.ReplaceMode = FHoudiniPackageParams::GetDefaultReplaceMode();
+
+	PackageParams.BakeFolder = FHoudiniEngineRuntime::Get().GetDefaultBakeFolder();
+	PackageParams.TempCookFolder = FHoudiniEngineRuntime::Get().GetDefaultTemporaryCookFolder();
+
+	UObject* AssetLinkParent = InAssetLink->GetOuter();
+	UHoudiniAssetComponent* HAC = AssetLinkParent != nullptr ? Cast<UHoudiniAssetComponent>(AssetLinkParent) : nullptr;
+	if (HAC)
+	{
+		PackageParams.OuterPackage = HAC->GetComponentLevel();
+		PackageParams.HoudiniAssetName = HAC->GetHoudiniAssetName();
+		PackageParams.HoudiniAssetActorName = HAC->GetOwner()->GetActorNameOrLabel();
+		PackageParams.ComponentGUID = HAC->GetComponentGUID();
+	}
+	else
+	{
+		PackageParams.OuterPackage = AssetLinkParent ? AssetLinkParent->GetOutermost() : nullptr;
+		PackageParams.HoudiniAssetName = FString();
+		PackageParams.HoudiniAssetActorName = FString();
+	}
+	PackageParams.ObjectName = FString();
+
+	// Static mesh generation / build settings, get it from the HAC if available, otherwise from the plugin
+	// defaults
+	OutLoadParams.StaticMeshGenerationProperties = HAC ? HAC->StaticMeshGenerationProperties : FHoudiniEngineRuntimeUtils::GetDefaultStaticMeshGenerationProperties();
+	OutLoadParams.MeshBuildSettings = HAC ? HAC->StaticMeshBuildSettings : FHoudiniEngineRuntimeUtils::GetDefaultMeshBuildSettings();
+}
+
+void
+FHoudiniPDGManager::EnqueueWorkItemResult(UTOPNode* InTOPNode, const HAPI_PDG_WorkItemId& InWorkItemID)
+{
+	if (!IsValid(InTOPNode))
+		return;
+
+	// A work item only needs to be queued once, its result objects are all processed together
+	const TPair<TObjectKey<UTOPNode>, HAPI_PDG_WorkItemId> Key(InTOPNode, InWorkItemID);
+	if (PendingResultSequences.Contains(Key))
+		return;
+
+	FHoudiniPDGPendingResult PendingResult;
+	PendingResult.TOPNode = InTOPNode;
+	PendingResult.WorkItemID = InWorkItemID;
+	PendingResult.Sequence = NextPendingResultSequence++;
+
+	PendingResultSequences.Add(Key, PendingResult.Sequence);
+	PendingResults.HeapPush(PendingResult);
+}
+
 void
 FHoudiniPDGManager::ProcessWorkItemResults()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniPDGManager::ProcessWorkItemResults);
 
 	const EHoudiniBGEOCommandletStatus CommandletStatus = UpdateAndGetBGEOCommandletStatus();
-	for (auto& CurrentPDGAssetLink : PDGAssetLinks)
+
+	// Load parameters are only built for the asset links that have work results to process this tick
+	TMap<UHoudiniPDGAssetLink*, FHoudiniPDGResultLoadParams> LoadParamsPerAssetLink;
+	auto GetLoadParams = [&LoadParamsPerAssetLink](UHoudiniPDGAssetLink* InAssetLink) -> FHoudiniPDGResultLoadParams&
 	{
-		// Iterate through all PDG Asset Link
-		UHoudiniPDGAssetLink* AssetLink = CurrentPDGAssetLink.Get();
-		if (!AssetLink)
-			continue;
+		FHoudiniPDGResultLoadParams* LoadParams = LoadParamsPerAssetLink.Find(InAssetLink);
+		if (!LoadParams)
+		{
+			LoadParams = &LoadParamsPerAssetLink.Add(InAssetLink);
+			HoudiniInitPDGResultLoadParams(InAssetLink, *LoadParams);
+		}
+		return *LoadParams;
+	};
 
-		// Set up package parameters to:
-		// Cook to temp houdini engine directory
-		// and if the PDG asset link is associated with a Houdini Asset Component (HAC):
-		//		set the outer package to the HAC
-		//		set the HoudiniAssetName according to the HAC
-		//		set the ComponentGUID according to the HAC
-		// otherwise we set the outer to the asset link's parent and leave naming and GUID blank
-		FHoudiniPackageParams PackageParams;
-		PackageParams.PackageMode = FHoudiniPackageParams::GetDefaultStaticMeshesCookMode();
-		PackageParams.ReplaceMode = FHoudiniPackageParams::GetDefaultReplaceMode();
+	// Process the work items that completed since the last tick
+	while (PendingResults.Num() > 0)
+	{
+		FHoudiniPDGPendingResult PendingResult;
+		PendingResults.HeapPop(PendingResult);
+		PendingResultSequences.Remove(TPair<TObjectKey<UTOPNode>, HAPI_PDG_WorkItemId>(PendingResult.TOPNode, PendingResult.WorkItemID));
 
-		PackageParams.BakeFolder = FHoudiniEngineRuntime::Get().GetDefaultBakeFolder();
-		PackageParams.TempCookFolder = FHoudiniEngineRuntime::Get().GetDefaultTemporaryCookFolder();
+		// Nodes that need a rescan will process this work item below
+		UTOPNode* TOPNode = PendingResult.TOPNode.ResolveObjectPtr();
+		if (!IsValid(TOPNode) || TOPNode->bHasPendingWorkResultChanges)
+			continue;
 
-		// AActor* ParentActor = nullptr;
-		UObject* AssetLinkParent = AssetLink->GetOuter();
-		UHoudiniAssetComponent* HAC = AssetLinkParent != nullptr ? Cast<UHoudiniAssetComponent>(AssetLinkParent) : nullptr;
-		if (HAC)
-		{
-			PackageParams.OuterPackage = HAC->GetComponentLevel();
-			PackageParams.HoudiniAssetName = HAC->GetHoudiniAssetName();
-			PackageParams.HoudiniAssetActorName = HAC->GetOwner()->GetActorNameOrLabel();
-			PackageParams.ComponentGUID = HAC->GetComponentGUID();
+		UHoudiniPDGAssetLink* AssetLink = TOPNode->GetOuterAssetLink();
+		if (!IsValid(AssetLink) || !PDGAssetLinks.Contains(AssetLink))
+			continue;
 
-			// ParentActor = HAC->GetOwner();
-		}
-		else
+		UTOPNetwork* const* TOPNet = AssetLink->AllTOPNetworks.FindByPredicate([TOPNode](const UTOPNetwork* InTOPNet)
 		{
-			PackageParams.OuterPackage = AssetLinkParent ? AssetLinkParent->GetOutermost() : nullptr;
-			PackageParams.HoudiniAssetName = FString();
-			PackageParams.HoudiniAssetActorName = FString();
-			// PackageParams.ComponentGUID = HAC->GetComponentGUID();
+			return IsValid(InTOPNet) && TOPNode->IsParentTOPNetwork(InTOPNet);
+		});
+		if (!TOPNet)
+			continue;
 
-			// // Try to find a parent actor
-			// UObject* Parent = AssetLinkParent;
-			// while (Parent && !ParentActor)
-			// {
-			// 	ParentActor = Cast<AActor>(Parent);
-			// 	if (!ParentActor)
-			// 		Parent = ParentActor->GetOuter();
-			// }
+		const int32 WorkResultArrayIndex = TOPNode->ArrayIndexOfWorkResultByID(PendingResult.WorkItemID);
+		if (WorkResultArrayIndex == INDEX_NONE)
+			continue;
+
+		ProcessWorkResult(AssetLink, *TOPNet, TOPNode, WorkResultArrayIndex, GetLoadParams(AssetLink), CommandletStatus);
+	}
+
+	UpdateTOPNodeEntries();
+
+	// Check a bounded number of work results for output actors deleted by the user
+	if (bHasLoadedWorkResultsToValidate)
+	{
+		const int32 BatchSize = CVarHoudiniEnginePDGResultValidationBatchSize.GetValueOnGameThread();
+		ValidateWorkResultOutputActors(BatchSize > 0 ? BatchSize : MAX_int32);
+	}
+
+	// Rescan the TOP nodes that were modified outside of the queue or have deleted output actors
+	for (const FHoudiniPDGTOPNodeEntry& Entry : TOPNodeEntries)
+	{
+		UTOPNode* CurrentTOPNode = Entry.TOPNode.Get();
+		if (!IsValid(CurrentTOPNode) || !CurrentTOPNode->bHasPendingWorkResultChanges)
+			continue;
+
+		UHoudiniPDGAssetLink* AssetLink = Entry.AssetLink.Get();
+		UTOPNetwork* CurrentTOPNet = Entry.TOPNetwork.Get();
+		if (!IsValid(AssetLink) || !IsValid(CurrentTOPNet))
+			continue;
+
+		CurrentTOPNode->bHasPendingWorkResultChanges = false;
+
+		// ... All WorkResult
+		const int32 NumWorkResults = CurrentTOPNode->WorkResult.Num();
+		for (int32 WorkResultArrayIndex = 0; WorkResultArrayIndex < NumWorkResults; ++WorkResultArrayIndex)
+		{
+			ProcessWorkResult(
+				AssetLink, CurrentTOPNet, CurrentTOPNode, WorkResultArrayIndex, GetLoadParams(AssetLink), CommandletStatus);
 		}
-		PackageParams.ObjectName = FString();
+	}
+}
+
+void
+FHoudiniPDGManager::UpdateTOPNodeEntries()
+{
+	if (!bTOPNodeEntriesDirty)
+		return;
 
-		// Static mesh generation / build settings, get it from the HAC if available, otherwise from the plugin
-		// defaults
-		const FHoudiniStaticMeshGenerationProperties& StaticMeshGenerationProperties = HAC ? HAC->StaticMeshGenerationProperties : FHoudiniEngineRuntimeUtils::GetDefaultStaticMeshGenerationProperties();
-		const FMeshBuildSettings& MeshBuildSettings = HAC ? HAC->StaticMeshBuildSettings : FHoudiniEngineRuntimeUtils::GetDefaultMeshBuildSettings();
+	bTOPNodeEntriesDirty = false;
+	TOPNodeEntries.Reset();
+	for (auto& CurrentPDGAssetLink : PDGAssetLinks)
+	{
+		UHoudiniPDGAssetLink* AssetLink = CurrentPDGAssetLink.Get();
+		if (!IsValid(AssetLink))
+			continue;
 
-		// .. All TOP Nets
 		for (UTOPNetwork* CurrentTOPNet : AssetLink->AllTOPNetworks)
 		{
 			if (!IsValid(CurrentTOPNet))
 				continue;
-			
-			// .. All TOP Nodes
+
 			for (UTOPNode* CurrentTOPNode : CurrentTOPNet->AllTOPNodes)
 			{
-				if (!IsValid(CurrentTOPNode))
-					continue;
-				
-				// ... All WorkResult
-				CurrentTOPNode->bCachedHaveNotLoadedWorkResults = false;
-				CurrentTOPNode->bCachedHaveLoadedWorkResults = false;
-				
-				const int32 NumWorkResults = CurrentTOPNode->WorkResult.Num();
-				for (int32 WorkResultArrayIndex = 0; WorkResultArrayIndex < NumWorkResults; ++WorkResultArrayIndex)
-				// for (FTOPWorkResult& CurrentWorkResult : CurrentTOPNode->WorkResult)
+				if (IsValid(CurrentTOPNode))
+					TOPNodeEntries.Add({ AssetLink, CurrentTOPNet, CurrentTOPNode });
+			}
+		}
+	}
+
+	// Restart the check for deleted output actors on the new nodes
+	ValidationTOPNodeIndex = 0;
+	ValidationWorkResultIndex = 0;
+	bHasLoadedWorkResultsToValidate = true;
+	bValidationPassFoundLoadedWorkResults = false;
+}
+
+void
+FHoudiniPDGManager::ValidateWorkResultOutputActors(const int32 InMaxWorkResults)
+{
+	const int32 NumTOPNodes = TOPNodeEntries.Num();
+	if (NumTOPNodes <= 0)
+	{
+		bHasLoadedWorkResultsToValidate = false;
+		return;
+	}
+
+	// Skipping a node counts as checking one work result so the cost of a tick stays bounded
+	int32 Budget = InMaxWorkResults;
+	for (int32 NumVisitedNodes = 0; NumVisitedNodes <= NumTOPNodes && Budget > 0; ++NumVisitedNodes)
+	{
+		if (!TOPNodeEntries.IsValidIndex(ValidationTOPNodeIndex))
+			ValidationTOPNodeIndex = 0;
+
+		UTOPNode* TOPNode = TOPNodeEntries[ValidationTOPNodeIndex].TOPNode.Get();
+		if (IsValid(TOPNode) && TOPNode->bCachedHaveLoadedWorkResults)
+		{
+			bValidationPassFoundLoadedWorkResults = true;
+
+			const int32 NumWorkResults = TOPNode->WorkResult.Num();
+			for (; ValidationWorkResultIndex < NumWorkResults && Budget > 0; ++ValidationWorkResultIndex, --Budget)
+			{
+				for (FTOPWorkResultObject& WorkResultObj : TOPNode->WorkResult[ValidationWorkResultIndex].ResultObjects)
 				{
-					FTOPWorkResult& CurrentWorkResult = CurrentTOPNode->WorkResult[WorkResultArrayIndex];
-					// ... All WorkResultObjects
-					const int32 NumWorkResultObjects = CurrentWorkResult.ResultObjects.Num();
-					for (int32 WorkResultObjectArrayIndex = 0; WorkResultObjectArrayIndex < NumWorkResultObjects; ++WorkResultObjectArrayIndex)
-					// for (FTOPWorkResultObject& CurrentWorkResultObj : CurrentWorkResult.ResultObjects)
+					if (WorkResultObj.State != EPDGWorkResultState::Loaded)
+						continue;
+
+					if (!IsValid(WorkResultObj.GetOutputActorOwner().GetOutputActor()))
 					{
-						FTOPWorkResultObject& CurrentWorkResultObj = CurrentWorkResult.ResultObjects[WorkResultObjectArrayIndex];
-						if (CurrentWorkResultObj.State == EPDGWorkResultState::ToLoad)
-						{
-							CurrentWorkResultObj.State = EPDGWorkResultState::Loading;
+						TOPNode->SetWorkResultObjectState(WorkResultObj, EPDGWorkResultState::ToDelete);
+						TOPNode->bHasPendingWorkResultChanges = true;
+					}
+				}
+			}
 
-							// Load this WRObj
-							PackageParams.PDGTOPNetworkName = CurrentTOPNet->NodeName;
-							PackageParams.PDGTOPNodeName = CurrentTOPNode->NodeName;
-							PackageParams.PDGWorkItemIndex = CurrentWorkResult.WorkItemIndex;
-							// Use the array index to ensure uniqueness among the work items of the node (
-							// CurrentWorkResult.WorkItemIndex is not necessarily unique)
-							PackageParams.PDGWorkResultArrayIndex = WorkResultArrayIndex;
+			if (ValidationWorkResultIndex < NumWorkResults)
+				return;
+		}
+		else
+		{
+			--Budget;
+		}
 
-							if (CommandletStatus == EHoudiniBGEOCommandletStatus::Connected)
-							{
-								BGEOCommandletEndpoint->Send(new FHoudiniPDGImportBGEOMessage(
-									CurrentWorkResultObj.FilePath,
-									CurrentWorkResultObj.Name,
-									PackageParams,
-									CurrentTOPNode->NodeId,
-									CurrentWorkResult.WorkItemID,
-									StaticMeshGenerationProperties,
-									MeshBuildSettings
-								), BGEOCommandletAddress);
-							}
-							else
-							{
-								if (FHoudiniPDGTranslator::CreateAllResultObjectsForPDGWorkItem(
-									AssetLink,
-									CurrentTOPNode,
-									CurrentWorkResultObj,
-									PackageParams))
-								{
-									CurrentWorkResultObj.State = EPDGWorkResultState::Loaded;
-									CurrentWorkResultObj.SetAutoBakedSinceLastLoad(false);
-									CurrentTOPNode->bCachedHaveLoadedWorkResults = true;
-									
-									// Broadcast that we have loaded the work result object to those interested
-									AssetLink->OnWorkResultObjectLoaded.Broadcast(
-										AssetLink, CurrentTOPNode, WorkResultArrayIndex,
-										CurrentWorkResultObj.WorkItemResultInfoIndex);
-								}
-								else
-								{
-									CurrentWorkResultObj.State = EPDGWorkResultState::None;
-								}
-							}
-						}
-						else if (CurrentWorkResultObj.State == EPDGWorkResultState::Loaded)
-						{
-							// If the work item result obj is in the "Loaded" state, confirm that the output actor
-							// is still valid (the user could have manually deleted the output
-							if (!IsValid(CurrentWorkResultObj.GetOutputActorOwner().GetOutputActor()))
-							{
-								// If the output actor is invalid, set the state to ToDelete to complete the
-								// unload/deletion process
-								CurrentWorkResultObj.State = EPDGWorkResultState::ToDelete;
-							}
-							else
-							{
-								CurrentTOPNode->bCachedHaveLoadedWorkResults = true;
-							}
-						}
-						else if (CurrentWorkResultObj.State == EPDGWorkResultState::ToDelete)
-						{
-							CurrentWorkResultObj.State = EPDGWorkResultState::Deleting;
+		// Move on to the next node, stop checking once a full pass found nothing loaded
+		ValidationWorkResultIndex = 0;
+		if (++ValidationTOPNodeIndex >= NumTOPNodes)
+		{
+			ValidationTOPNodeIndex = 0;
+			bHasLoadedWorkResultsToValidate = bValidationPassFoundLoadedWorkResults;
+			bValidationPassFoundLoadedWorkResults = false;
+			if (!bHasLoadedWorkResultsToValidate)
+				return;
+		}
+	}
+}
 
-							// Delete and clean up that WRObj
-							CurrentTOPNode->DeleteWorkResultObjectOutputs(WorkResultArrayIndex, WorkResultObjectArrayIndex);
-							CurrentTOPNode->bCachedHaveNotLoadedWorkResults = true;
-						}
-						else if (CurrentWorkResultObj.State == EPDGWorkResultState::Deleted)
-						{
-							CurrentTOPNode->bCachedHaveNotLoadedWorkResults = true;
-						}
-						else if (CurrentWorkResultObj.State == EPDGWorkResultState::NotLoaded)
-						{
-							CurrentTOPNode->bCachedHaveNotLoadedWorkResults = true;
-						}
-					}
+void
+FHoudiniPDGManager::ProcessWorkResult(
+	UHoudiniPDGAssetLink* InAssetLink,
+	UTOPNetwork* InTOPNet,
+	UTOPNode* InTOPNode,
+	const int32 InWorkResultArrayIndex,
+	FHoudiniPDGResultLoadParams& InLoadParams,
+	const EHoudiniBGEOCommandletStatus& InCommandletStatus)
+{
+	FHoudiniPackageParams& PackageParams = InLoadParams.PackageParams;
+	FTOPWorkResult& CurrentWorkResult = InTOPNode->WorkResult[InWorkResultArrayIndex];
+	// ... All WorkResultObjects
+	const int32 NumWorkResultObjects = CurrentWorkResult.ResultObjects.Num();
+	for (int32 WorkResultObjectArrayIndex = 0; WorkResultObjectArrayIndex < NumWorkResultObjects; ++WorkResultObjectArrayIndex)
+	{
+		FTOPWorkResultObject& CurrentWorkResultObj = CurrentWorkResult.ResultObjects[WorkResultObjectArrayIndex];
+		if (CurrentWorkResultObj.State == EPDGWorkResultState::ToLoad)
+		{
+			InTOPNode->SetWorkResultObjectState(CurrentWorkResultObj, EPDGWorkResultState::Loading);
+
+			// Load this WRObj
+			PackageParams.PDGTOPNetworkName = InTOPNet->NodeName;
+			PackageParams.PDGTOPNodeName = InTOPNode->NodeName;
+			PackageParams.PDGWorkItemIndex = CurrentWorkResult.WorkItemIndex;
+			// Use the array index to ensure uniqueness among the work items of the node (
+			// CurrentWorkResult.WorkItemIndex is not necessarily unique)
+			PackageParams.PDGWorkResultArrayIndex = InWorkResultArrayIndex;
+
+			if (InCommandletStatus == EHoudiniBGEOCommandletStatus::Connected)
+			{
+				SendImportBGEOMessage(new FHoudiniPDGImportBGEOMessage(
+					CurrentWorkResultObj.FilePath,
+					CurrentWorkResultObj.Name,
+					PackageParams,
+					InTOPNode->NodeId,
+					CurrentWorkResult.WorkItemID,
+					InLoadParams.StaticMeshGenerationProperties,
+					InLoadParams.MeshBuildSettings
+				));
+			}
+			else
+			{
+				if (FHoudiniPDGTranslator::CreateAllResultObjectsForPDGWorkItem(
+					InAssetLink,
+					InTOPNode,
+					CurrentWorkResultObj,
+					PackageParams))
+				{
+					InTOPNode->SetWorkResultObjectState(CurrentWorkResultObj, EPDGWorkResultState::Loaded);
+					CurrentWorkResultObj.SetAutoBakedSinceLastLoad(false);
+					bHasLoadedWorkResultsToValidate = true;
+					bValidationPassFoundLoadedWorkResults = true;
+					
+					// Broadcast that we have loaded the work result object to those interested
+					InAssetLink->OnWorkResultObjectLoaded.Broadcast(
+						InAssetLink, InTOPNode, InWorkResultArrayIndex,
+						CurrentWorkResultObj.WorkItemResultInfoIndex);
+				}
+				else
+				{
+					InTOPNode->SetWorkResultObjectState(CurrentWorkResultObj, EPDGWorkResultState::None);
 				}
 			}
 		}
+		else if (CurrentWorkResultObj.State == EPDGWorkResultState::Loaded)
+		{
+			// If the work item result obj is in the "Loaded" state, confirm that the output actor
+			// is still valid (the user could have manually deleted the output
+			if (!IsValid(CurrentWorkResultObj.GetOutputActorOwner().GetOutputActor()))
+			{
+				// If the output actor is invalid, set the state to ToDelete to complete the
+				// unload/deletion process
+				InTOPNode->SetWorkResultObjectState(CurrentWorkResultObj, EPDGWorkResultState::ToDelete);
+				InTOPNode->bHasPendingWorkResultChanges = true;
+			}
+		}
+		else if (CurrentWorkResultObj.State == EPDGWorkResultState::ToDelete)
+		{
+			InTOPNode->SetWorkResultObjectState(CurrentWorkResultObj, EPDGWorkResultState::Deleting);
+
+			// Delete and clean up that WRObj
+			InTOPNode->DeleteWorkResultObjectOutputs(InWorkResultArrayIndex, WorkResultObjectArrayIndex);
+		}
 	}
 }
 
@@ -1788,14 +2264,19 @@ void FHoudiniPDGManager::HandleImportBGEODiscoverMessage(
 	const TSharedRef<IMessageContext, ESPMode::ThreadSafe>& InContext)
 {
 	HOUDINI_LOG_DISPLAY(TEXT("Received Discover from %s"), *InContext->GetSender().ToString());
-	// Ignore any discover acks received if we already have a valid local address
-	// for the commandlet
-	if (BGEOCommandletAddress.IsValid())
+	if (!InMessage.CommandletGuid.IsValid())
 		return;
 
-	if (BGEOCommandletProcHandle.IsValid() && InMessage.CommandletGuid.IsValid() && BGEOCommandletGuid == InMessage.CommandletGuid)
+	for (FHoudiniBGEOCommandlet& Commandlet : BGEOCommandlets)
 	{
-		BGEOCommandletAddress = InContext->GetSender();
+		// Ignore any discover acks received if we already have a valid local address
+		// for the commandlet
+		if (Commandlet.Guid != InMessage.CommandletGuid || Commandlet.Address.IsValid())
+			continue;
+
+		if (Commandlet.ProcHandle.IsValid())
+			Commandlet.Address = InContext->GetSender();
+		break;
 	}
 }
 
@@ -1804,6 +2285,20 @@ void FHoudiniPDGManager::HandleImportBGEOResultMessage(
 	const TSharedRef<IMessageContext, ESPMode::ThreadSafe>& InContext)
 {
 	HOUDINI_LOG_MESSAGE(TEXT("Received BGEO import result message"));
+
+	// This import is no longer pending on the commandlet that sent the result
+	const FMessageAddress& Sender = InContext->GetSender();
+	for (FHoudiniBGEOCommandlet& Commandlet : BGEOCommandlets)
+	{
+		if (Commandlet.Address != Sender)
+			continue;
+
+		FHoudiniBGEOCommandletImport Import;
+		if (Commandlet.PendingImports.RemoveAndCopyValue(InMessage.FilePath, Import))
+			Commandlet.PendingBytes -= Import.FileSize;
+		break;
+	}
+
 	if (InMessage.ImportResult == EHoudiniPDGImportBGEOResult::HPIBR_Success || InMessage.ImportResult == EHoudiniPDGImportBGEOResult::HPIBR_PartialSuccess)
 	{
 		FHoudiniPackageParams PackageParams;
@@ -2028,8 +2523,10 @@ void FHoudiniPDGManager::HandleImportBGEOResultMessage(
 		
 		if (bSuccess)
 		{
-			WorkResultObject->State = EPDGWorkResultState::Loaded;
+			TOPNode->SetWorkResultObjectState(*WorkResultObject, EPDGWorkResultState::Loaded);
 			WorkResultObject->SetAutoBakedSinceLastLoad(false);
+			bHasLoadedWorkResultsToValidate = true;
+			bValidationPassFoundLoadedWorkResults = true;
 			HOUDINI_LOG_MESSAGE(TEXT("Loaded geo for %s"), *InMessage.Name);
 			// Broadcast that we have loaded the work result object to those interested
 			AssetLink->OnWorkResultObjectLoaded.Broadcast(
@@ -2037,21 +2534,100 @@ void FHoudiniPDGManager::HandleImportBGEOResultMessage(
 		}
 		else
 		{
-			WorkResultObject->State = EPDGWorkResultState::None;
+			TOPNode->SetWorkResultObjectState(*WorkResultObject, EPDGWorkResultState::None);
 			HOUDINI_LOG_WARNING(TEXT("Failed to process loaded assets for %s"), *InMessage.Name);
 		}
 	}
 	else
 	{
 		HOUDINI_LOG_WARNING(TEXT("Commandlet failed to import bgeo for %s"), *InMessage.Name);
+
+		// Release the work result object, so it can be loaded again
+		FHoudiniBGEOCommandletImport Import;
+		Import.TOPNodeId = InMessage.TOPNodeId;
+		Import.WorkItemId = InMessage.WorkItemId;
+		Import.Name = InMessage.Name;
+		ResetBGEOCommandletImport(Import, EPDGWorkResultState::None);
 	}
 }
 
+bool
+FHoudiniPDGManager::SendImportBGEOMessage(FHoudiniPDGImportBGEOMessage* InMessage)
+{
+	if (!InMessage)
+		return false;
+
+	// Each file also counts for a fixed amount, so that many small files still get spread over the pool
+	static const int64 PerFileCost = 1024 * 1024;
+
+	FHoudiniBGEOCommandlet* BestCommandlet = nullptr;
+	for (FHoudiniBGEOCommandlet& Commandlet : BGEOCommandlets)
+	{
+		if (Commandlet.Status != EHoudiniBGEOCommandletStatus::Connected)
+			continue;
+
+		if (!BestCommandlet
+			|| Commandlet.PendingBytes + Commandlet.PendingImports.Num() * PerFileCost
+				< BestCommandlet->PendingBytes + BestCommandlet->PendingImports.Num() * PerFileCost)
+		{
+			BestCommandlet = &Commandlet;
+		}
+	}
+
+	if (!BestCommandlet || !BGEOCommandletEndpoint.IsValid())
+	{
+		delete InMessage;
+		return false;
+	}
+
+	FHoudiniBGEOCommandletImport Import;
+	Import.TOPNodeId = InMessage->TOPNodeId;
+	Import.WorkItemId = InMessage->WorkItemId;
+	Import.Name = InMessage->Name;
+	Import.FileSize = FMath::Max<int64>(IFileManager::Get().FileSize(*InMessage->FilePath), 0);
+
+	if (const FHoudiniBGEOCommandletImport* PreviousImport = BestCommandlet->PendingImports.Find(InMessage->FilePath))
+		BestCommandlet->PendingBytes -= PreviousImport->FileSize;
+	BestCommandlet->PendingImports.Add(InMessage->FilePath, Import);
+	BestCommandlet->PendingBytes += Import.FileSize;
+
+	BGEOCommandletEndpoint->Send(InMessage, BestCommandlet->Address);
+	return true;
+}
+
+void
+FHoudiniPDGManager::ResetBGEOCommandletImport(const FHoudiniBGEOCommandletImport& InImport, const EPDGWorkResultState& InNewState)
+{
+	UHoudiniPDGAssetLink* AssetLink = nullptr;
+	UTOPNetwork* TOPNetwork = nullptr;
+	UTOPNode* TOPNode = nullptr;
+	if (!GetTOPAssetLinkNetworkAndNode(InImport.TOPNodeId, AssetLink, TOPNetwork, TOPNode) || !IsValid(TOPNode))
+		return;
+
+	FTOPWorkResult* WorkResult = TOPNode->GetWorkResultByID(InImport.WorkItemId);
+	if (!WorkResult)
+		return;
+
+	FTOPWorkResultObject* WorkResultObject = WorkResult->ResultObjects.FindByPredicate(
+		[&InImport](const FTOPWorkResultObject& InWorkResultObject)
+		{
+			return InWorkResultObject.Name == InImport.Name;
+		});
+	if (!WorkResultObject || WorkResultObject->State != EPDGWorkResultState::Loading)
+		return;
+
+	TOPNode->SetWorkResultObjectState(*WorkResultObject, InNewState);
+	if (InNewState == EPDGWorkResultState::ToLoad)
+		EnqueueWorkItemResult(TOPNode, InImport.WorkItemId);
+}
+
 bool FHoudiniPDGManager::CreateBGEOCommandletAndEndpoint()
 {
 	if (!BGEOCommandletEndpoint.IsValid())
 	{
-		BGEOCommandletAddress.Invalidate();
+		for (FHoudiniBGEOCommandlet& Commandlet : BGEOCommandlets)
+			Commandlet.Address.Invalidate();
+
 		BGEOCommandletEndpoint = FMessageEndpoint::Builder(TEXT("Houdini BGEO Commandlet"))
 			.Handling<FHoudiniPDGImportBGEOResultMessage>(this, &FHoudiniPDGManager::HandleImportBGEOResultMessage)
 			.Handling<FHoudiniPDGImportBGEODiscoverMessage>(this, &FHoudiniPDGManager::HandleImportBGEODiscoverMessage)
@@ -2066,97 +2642,144 @@ bool FHoudiniPDGManager::CreateBGEOCommandletAndEndpoint()
 		BGEOCommandletEndpoint->Subscribe<FHoudiniPDGImportBGEODiscoverMessage>();
 	}
 
-	if (!BGEOCommandletProcHandle.IsValid() || !FPlatformProcess::IsProcRunning(BGEOCommandletProcHandle))
-	{
-		// Start the bgeo commandlet
-		static const FString BGEOCommandletName = TEXT("HoudiniGeoImport");
-		BGEOCommandletGuid = FGuid::NewGuid();
-		BGEOCommandletAddress.Invalidate();
-
-		// Get the absolute path to the project file, if known, otherwise get
-		// the project name. For the path: quote it for the command line.
-		IFileManager& FileManager = IFileManager::Get();
-		FString ProjectPathOrName = FApp::GetProjectName();
-		if (FPaths::IsProjectFilePathSet())
-		{
-			const FString ProjectPath = FPaths::GetProjectFilePath();
-			if (!ProjectPath.IsEmpty())
-			{
-				ProjectPathOrName = FString::Printf(
-                    TEXT("\"%s\""),
-                    *FileManager.ConvertToAbsolutePathForExternalAppForRead(*ProjectPath)
-                );
-			}
-		}
+	const int32 PoolSize = HoudiniGetPDGCommandletPoolSize();
+	if (BGEOCommandlets.Num() < PoolSize)
+		BGEOCommandlets.SetNum(PoolSize);
 
-		if (ProjectPathOrName.IsEmpty())
-			return false;
+	bool bSuccess = true;
+	for (FHoudiniBGEOCommandlet& Commandlet : BGEOCommandlets)
+	{
+		if (!Commandlet.ProcHandle.IsValid() || !FPlatformProcess::IsProcRunning(Commandlet.ProcHandle))
+			bSuccess &= StartBGEOCommandlet(Commandlet);
+	}
 
-		// Get the executable path for the app/editor
-		FString ExePath = FPlatformProcess::GenerateApplicationPath(FApp::GetName(), FApp::GetBuildConfiguration());
-		if (!ExePath.IsEmpty())
-			ExePath = FileManager.ConvertToAbsolutePathForExternalAppForRead(*ExePath);
+	return bSuccess;
+}
 
-		if (ExePath.IsEmpty())
-			return false;
-		
-		const FString CommandLineParameters = FString::Printf(
-			TEXT("%s -messaging -run=%s -guid=%s -listen=%s -managerpid=%d"),
-			*ProjectPathOrName,
-			*BGEOCommandletName,
-			*BGEOCommandletGuid.ToString(),
-			*BGEOCommandletEndpoint->GetAddress().ToString(),
-			FPlatformProcess::GetCurrentProcessId());
-
-		BGEOCommandletProcHandle = FPlatformProcess::CreateProc(
-			*ExePath,
-			*CommandLineParameters,
-			false,
-			true,
-			false,
-			&BGEOCommandletProcessId,
-			0,
-			NULL,
-			NULL);
-		if (!BGEOCommandletProcHandle.IsValid())
+bool
+FHoudiniPDGManager::StartBGEOCommandlet(FHoudiniBGEOCommandlet& InOutCommandlet)
+{
+	// Start the bgeo commandlet
+	static const FString BGEOCommandletName = TEXT("HoudiniGeoImport");
+
+	// Anything that was sent to a previous instance of this commandlet will never be answered, load it again
+	for (const TPair<FString, FHoudiniBGEOCommandletImport>& Entry : InOutCommandlet.PendingImports)
+		ResetBGEOCommandletImport(Entry.Value, EPDGWorkResultState::ToLoad);
+	InOutCommandlet.PendingImports.Empty();
+	InOutCommandlet.PendingBytes = 0;
+
+	if (InOutCommandlet.ProcHandle.IsValid())
+		FPlatformProcess::CloseProc(InOutCommandlet.ProcHandle);
+
+	InOutCommandlet.Guid = FGuid::NewGuid();
+	InOutCommandlet.Address.Invalidate();
+
+	// Get the absolute path to the project file, if known, otherwise get
+	// the project name. For the path: quote it for the command line.
+	IFileManager& FileManager = IFileManager::Get();
+	FString ProjectPathOrName = FApp::GetProjectName();
+	if (FPaths::IsProjectFilePathSet())
+	{
+		const FString ProjectPath = FPaths::GetProjectFilePath();
+		if (!ProjectPath.IsEmpty())
 		{
-			return false;
+			ProjectPathOrName = FString::Printf(
+                TEXT("\"%s\""),
+                *FileManager.ConvertToAbsolutePathForExternalAppForRead(*ProjectPath)
+            );
 		}
 	}
 
-	return true;
+	if (ProjectPathOrName.IsEmpty())
+		return false;
+
+	// Get the executable path for the app/editor
+	FString ExePath = FPlatformProcess::GenerateApplicationPath(FApp::GetName(), FApp::GetBuildConfiguration());
+	if (!ExePath.IsEmpty())
+		ExePath = FileManager.ConvertToAbsolutePathForExternalAppForRead(*ExePath);
+
+	if (ExePath.IsEmpty())
+		return false;
+	
+	const FString CommandLineParameters = FString::Printf(
+		TEXT("%s -messaging -run=%s -guid=%s -listen=%s -managerpid=%d"),
+		*ProjectPathOrName,
+		*BGEOCommandletName,
+		*InOutCommandlet.Guid.ToString(),
+		*BGEOCommandletEndpoint->GetAddress().ToString(),
+		FPlatformProcess::GetCurrentProcessId());
+
+	InOutCommandlet.ProcHandle = FPlatformProcess::CreateProc(
+		*ExePath,
+		*CommandLineParameters,
+		false,
+		true,
+		false,
+		&InOutCommandlet.ProcessId,
+		0,
+		NULL,
+		NULL);
+
+	return InOutCommandlet.ProcHandle.IsValid();
 }
 
 void FHoudiniPDGManager::StopBGEOCommandletAndEndpoint()
 {
 	BGEOCommandletEndpoint.Reset();
-	BGEOCommandletAddress.Invalidate();
-	BGEOCommandletGuid.Invalidate();
 
-	if (BGEOCommandletProcHandle.IsValid() && FPlatformProcess::IsProcRunning(BGEOCommandletProcHandle))
+	for (FHoudiniBGEOCommandlet& Commandlet : BGEOCommandlets)
 	{
-		FPlatformProcess::TerminateProc(BGEOCommandletProcHandle, true);
-		if (BGEOCommandletProcHandle.IsValid())
+		if (Commandlet.ProcHandle.IsValid() && FPlatformProcess::IsProcRunning(Commandlet.ProcHandle))
 		{
-			FPlatformProcess::WaitForProc(BGEOCommandletProcHandle);
-			FPlatformProcess::CloseProc(BGEOCommandletProcHandle);
+			FPlatformProcess::TerminateProc(Commandlet.ProcHandle, true);
+			if (Commandlet.ProcHandle.IsValid())
+			{
+				FPlatformProcess::WaitForProc(Commandlet.ProcHandle);
+				FPlatformProcess::CloseProc(Commandlet.ProcHandle);
+			}
 		}
+
+		// Imports that were in flight will never complete
+		for (const TPair<FString, FHoudiniBGEOCommandletImport>& Entry : Commandlet.PendingImports)
+			ResetBGEOCommandletImport(Entry.Value, EPDGWorkResultState::None);
 	}
+	BGEOCommandlets.Empty();
 }
 
 EHoudiniBGEOCommandletStatus FHoudiniPDGManager::UpdateAndGetBGEOCommandletStatus()
 {
-	if (BGEOCommandletProcHandle.IsValid())
+	BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::NotStarted;
+	for (FHoudiniBGEOCommandlet& Commandlet : BGEOCommandlets)
 	{
-		if (!FPlatformProcess::IsProcRunning(BGEOCommandletProcHandle))
-			BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::Crashed;
-		else if (BGEOCommandletAddress.IsValid())
-			BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::Connected;
+		if (Commandlet.ProcHandle.IsValid())
+		{
+			if (!FPlatformProcess::IsProcRunning(Commandlet.ProcHandle))
+				Commandlet.Status = EHoudiniBGEOCommandletStatus::Crashed;
+			else if (Commandlet.Address.IsValid())
+				Commandlet.Status = EHoudiniBGEOCommandletStatus::Connected;
+			else
+				Commandlet.Status = EHoudiniBGEOCommandletStatus::Running;
+		}
 		else
-			BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::Running;
+			Commandlet.Status = EHoudiniBGEOCommandletStatus::NotStarted;
+
+		// Imports sent to a crashed commandlet will never complete, send them to the rest of the pool
+		if (Commandlet.Status == EHoudiniBGEOCommandletStatus::Crashed && Commandlet.PendingImports.Num() > 0)
+		{
+			for (const TPair<FString, FHoudiniBGEOCommandletImport>& Entry : Commandlet.PendingImports)
+				ResetBGEOCommandletImport(Entry.Value, EPDGWorkResultState::ToLoad);
+			Commandlet.PendingImports.Empty();
+			Commandlet.PendingBytes = 0;
+		}
+
+		// Report the most advanced status of the pool
+		if (Commandlet.Status == EHoudiniBGEOCommandletStatus::Connected
+			|| (Commandlet.Status == EHoudiniBGEOCommandletStatus::Running && BGEOCommandletStatus != EHoudiniBGEOCommandletStatus::Connected)
+			|| (Commandlet.Status == EHoudiniBGEOCommandletStatus::Crashed && BGEOCommandletStatus == EHoudiniBGEOCommandletStatus::NotStarted))
+		{
+			BGEOCommandletStatus = Commandlet.Status;
+		}
 	}
-	else
-		BGEOCommandletStatus = EHoudiniBGEOCommandletStatus::NotStarted;
 
 	return BGEOCommandletStatus;
 }
@@ -28,17 +28,27 @@
 
 #include "HAPI/HAPI_Common.h"
 
+#include "Containers/Queue.h"
+#include "HAL/Event.h"
 #include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+
+#include <atomic>
 
 #include "MessageEndpoint.h"
+#include "UObject/ObjectKey.h"
 
 class UHoudiniAssetComponent;
 class UHoudiniPDGAssetLink;
 class UTOPNetwork;
 class UTOPNode;
 class FSocket;
+class FRunnableThread;
 
 enum class EPDGNodeState : uint8;
+enum class EPDGWorkResultState : uint8;
+struct FHoudiniPDGImportBGEOMessage;
+struct FHoudiniPDGResultLoadParams;
 
 // BGEO commandlet status
 enum class HOUDINIENGINE_API EHoudiniBGEOCommandletStatus : uint8
@@ -55,6 +65,131 @@ enum class HOUDINIENGINE_API EHoudiniBGEOCommandletStatus : uint8
 	Crashed
 };
 
+// A BGEO import sent to a commandlet that has not replied yet
+struct FHoudiniBGEOCommandletImport
+{
+	int32 TOPNodeId = -1;
+	int32 WorkItemId = -1;
+	// Name of the work result object
+	FString Name;
+	// Size of the BGEO file, used to balance the load between the commandlets
+	int64 FileSize = 0;
+};
+
+// One BGEO import commandlet process of the PDG manager's pool
+struct FHoudiniBGEOCommandlet
+{
+	FProcHandle ProcHandle;
+	uint32 ProcessId = 0;
+	FGuid Guid;
+	// Messaging address of the commandlet, valid once its discover message has been received
+	FMessageAddress Address;
+	EHoudiniBGEOCommandletStatus Status = EHoudiniBGEOCommandletStatus::NotStarted;
+
+	// Imports in flight, by BGEO file path, and the sum of their file sizes
+	TMap<FString, FHoudiniBGEOCommandletImport> PendingImports;
+	int64 PendingBytes = 0;
+};
+
+// A PDG event fetched by the event pump, along with its already decoded message
+struct FHoudiniPDGEvent
+{
+	HAPI_PDG_GraphContextId ContextId = -1;
+	HAPI_PDG_EventInfo EventInfo;
+	FString Message;
+	// Session the event was fetched from, see FHoudiniPDGEventPump::SetSession
+	uint32 SessionGeneration = 0;
+};
+
+// Background thread that continuously drains the PDG events of all graph contexts in the main session.
+// Events are pushed to a queue that is consumed by FHoudiniPDGManager on the game thread.
+class FHoudiniPDGEventPump : public FRunnable
+{
+public:
+
+	FHoudiniPDGEventPump();
+	virtual ~FHoudiniPDGEventPump();
+
+	// FRunnable methods.
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+	// Enables/disables polling HAPI for events, the pump idles while inactive.
+	void SetActive(const bool bInActive);
+
+	// Sets the session to poll, pass nullptr to stop using the current one. The pump never reads the engine's sessions itself.
+	// Blocks until the pump is done with its current poll, so the previous session can safely be closed afterwards.
+	// When the session changes, the events queued from the previous one are discarded.
+	void SetSession(const HAPI_Session* InSession);
+
+	// Pops the oldest queued event, returns false if the queue is empty. Must only be called by a single consumer.
+	bool DequeueEvent(FHoudiniPDGEvent& OutEvent);
+
+	// Returns the number of events waiting in the queue.
+	int32 GetNumQueuedEvents() const { return NumQueuedEvents.load(); }
+
+	// Returns the number of events that were still pending on the HAPI side after the last poll.
+	int32 GetNumRemainingEvents() const { return NumRemainingEvents.load(); }
+
+private:
+
+	// Fetches the pending events of all graph contexts, returns the number of events queued.
+	int32 PumpEvents(const HAPI_Session* InSession, const uint32& InSessionGeneration);
+
+	// Identifies a session, or returns INDEX_NONE for no session.
+	static int64 GetSessionKey(const HAPI_Session* InSession);
+
+	// Sleep time between each poll (in seconds) when no event was received.
+	static const float UpdateFrequency;
+
+	// Events fetched from HAPI, waiting to be processed on the game thread.
+	TQueue<FHoudiniPDGEvent, EQueueMode::Mpsc> Events;
+
+	std::atomic<int32> NumQueuedEvents;
+	std::atomic<int32> NumRemainingEvents;
+
+	// Event to wake up the thread when it gets activated or stopped.
+	FEventRef WakeUpEvent;
+
+	std::atomic<bool> bActive;
+	std::atomic<bool> bStopping;
+
+	// Session used by the pump, only accessed with SessionLock held. The lock is held for the whole duration of a poll.
+	FCriticalSection SessionLock;
+	HAPI_Session Session;
+	bool bHasSession;
+
+	// Key of the current session, to skip locking when the session didn't change.
+	std::atomic<int64> SessionKey;
+
+	// Incremented every time the session changes, events from older generations are discarded.
+	std::atomic<uint32> SessionGeneration;
+
+	// Only accessed by the pump thread.
+	TArray<HAPI_StringHandle> ContextNames;
+	TArray<HAPI_PDG_GraphContextId> ContextIDs;
+	TArray<HAPI_PDG_EventInfo> EventInfos;
+};
+
+// A work item whose result objects are waiting to be loaded or deleted by FHoudiniPDGManager::ProcessWorkItemResults
+struct FHoudiniPDGPendingResult
+{
+	TObjectKey<UTOPNode> TOPNode;
+	HAPI_PDG_WorkItemId WorkItemID = -1;
+	// Order in which the work item was queued, older entries are processed first
+	uint64 Sequence = 0;
+
+	bool operator<(const FHoudiniPDGPendingResult& InOther) const { return Sequence < InOther.Sequence; }
+};
+
+// A TOP node of a registered asset link, with the asset link and TOP network it belongs to
+struct FHoudiniPDGTOPNodeEntry
+{
+	TWeakObjectPtr<UHoudiniPDGAssetLink> AssetLink;
+	TWeakObjectPtr<UTOPNetwork> TOPNetwork;
+	TWeakObjectPtr<UTOPNode> TOPNode;
+};
+
 struct HOUDINIENGINE_API FHoudiniPDGManager
 {
 
@@ -153,21 +288,65 @@ public:
 		const struct FHoudiniPDGImportBGEOResultMessage& InMessage, 
 		const TSharedRef<IMessageContext, ESPMode::ThreadSafe>& InContext);
 
-	// Create the bgeo commandlet endpoint and start the commandlet (if not already running).
+	// Create the bgeo commandlet endpoint and start the commandlets of the pool (if not already running).
+	// The pool size is controlled by HoudiniEngine.PDGCommandletPoolSize.
 	bool CreateBGEOCommandletAndEndpoint();
 
 	void StopBGEOCommandletAndEndpoint();
 
-	// Updates and returns the BGEO commandlet status
+	// Updates and returns the BGEO commandlet status: Connected if any commandlet of the pool is connected,
+	// otherwise the status of the most advanced commandlet.
 	EHoudiniBGEOCommandletStatus UpdateAndGetBGEOCommandletStatus();
 
+	// Stops the PDG event pump from using the current session and discards its queued events.
+	// Must be called before the session is closed or the engine's sessions are reset. Can be called from any thread.
+	void DetachPDGEventPumpSession();
+
 private:
 	
 	void UpdatePDGContexts();
 
+	// Starts the PDG event pump thread if it isn't running yet
+	void StartPDGEventPump();
+
+	// Stops the PDG event pump thread and discards any event left in its queue
+	void StopPDGEventPump();
+
+	// Processes a bounded batch of the events queued by the PDG event pump, returns the number of events processed
+	int32 ProcessQueuedPDGEvents();
+
 	void ProcessWorkItemResults();
 
-	void ProcessPDGEvent(const HAPI_PDG_GraphContextId& InContextID, HAPI_PDG_EventInfo& EventInfo);
+	// Starts the commandlet process of a pool slot
+	bool StartBGEOCommandlet(FHoudiniBGEOCommandlet& InOutCommandlet);
+
+	// Sends a BGEO import to the connected commandlet with the least amount of pending data.
+	// Returns false if no commandlet is connected.
+	bool SendImportBGEOMessage(FHoudiniPDGImportBGEOMessage* InMessage);
+
+	// Sets the state of the work result object of a pending commandlet import, if it is still loading
+	void ResetBGEOCommandletImport(const FHoudiniBGEOCommandletImport& InImport, const EPDGWorkResultState& InNewState);
+
+	// Queues a work item whose result objects need to be loaded or deleted by ProcessWorkItemResults
+	void EnqueueWorkItemResult(UTOPNode* InTOPNode, const HAPI_PDG_WorkItemId& InWorkItemID);
+
+	// Rebuilds TOPNodeEntries if the asset links, TOP networks or TOP nodes changed
+	void UpdateTOPNodeEntries();
+
+	// Checks at most InMaxWorkResults work results, resuming where the previous call stopped, for loaded result
+	// objects whose output actor was deleted by the user. Their nodes are flagged for a rescan.
+	void ValidateWorkResultOutputActors(const int32 InMaxWorkResults);
+
+	// Loads, deletes or validates the result objects of the work result at InWorkResultArrayIndex in InTOPNode
+	void ProcessWorkResult(
+		UHoudiniPDGAssetLink* InAssetLink,
+		UTOPNetwork* InTOPNet,
+		UTOPNode* InTOPNode,
+		const int32 InWorkResultArrayIndex,
+		FHoudiniPDGResultLoadParams& InLoadParams,
+		const EHoudiniBGEOCommandletStatus& InCommandletStatus);
+
+	void ProcessPDGEvent(const HAPI_PDG_GraphContextId& InContextID, const HAPI_PDG_EventInfo& EventInfo, const FString& InEventMsg);
 
 	static void ResetPDGEventInfo(HAPI_PDG_EventInfo& InEventInfo);
 
@@ -204,11 +383,30 @@ private:
 
 	int32 MaxNumberOfPDGEvents = 20;
 
+	// Heap of the work items with results to load or delete, and the sequence of each queued (TOP node, work item)
+	TArray<FHoudiniPDGPendingResult> PendingResults;
+	TMap<TPair<TObjectKey<UTOPNode>, HAPI_PDG_WorkItemId>, uint64> PendingResultSequences;
+	uint64 NextPendingResultSequence = 0;
+
+	// All TOP nodes of the registered asset links, only rebuilt when asset links are registered / removed or their
+	// TOP networks and nodes are repopulated
+	TArray<FHoudiniPDGTOPNodeEntry> TOPNodeEntries;
+	bool bTOPNodeEntriesDirty = true;
+
+	// TOP node (index in TOPNodeEntries) and work result at which the check for deleted output actors resumes
+	int32 ValidationTOPNodeIndex = 0;
+	int32 ValidationWorkResultIndex = 0;
+	// Cleared once a full pass over TOPNodeEntries found no loaded work result, set again when one is loaded
+	bool bHasLoadedWorkResultsToValidate = true;
+	bool bValidationPassFoundLoadedWorkResults = false;
+
+	// Background thread fetching PDG events, only used when HoudiniEngine.PDGEventThread is enabled
+	FHoudiniPDGEventPump* PDGEventPump = nullptr;
+	FRunnableThread* PDGEventPumpThread = nullptr;
+
 	TSharedPtr<FMessageEndpoint, ESPMode::ThreadSafe> BGEOCommandletEndpoint;
-	FMessageAddress BGEOCommandletAddress;
-	FProcHandle BGEOCommandletProcHandle;
-	FGuid BGEOCommandletGuid;
-	uint32 BGEOCommandletProcessId;
-	// Keep track of the BGEO commandlet status
+	// Pool of BGEO import commandlets, all talking to BGEOCommandletEndpoint
+	TArray<FHoudiniBGEOCommandlet> BGEOCommandlets;
+	// Keep track of the BGEO commandlet status (of the whole pool)
 	EHoudiniBGEOCommandletStatus BGEOCommandletStatus;
 };
@@ -89,7 +89,8 @@ FHoudiniParameterTranslator::UpdateParameters(UHoudiniAssetComponent* HAC)
 	const bool bForceFullUpdate = HAC->HasRebuildBeenRequested() || HAC->HasRecookBeenRequested() || HAC->IsParameterDefinitionUpdateNeeded();
 
 	TArray<TObjectPtr<UHoudiniParameter>> NewParameters;
-	if (FHoudiniParameterTranslator::BuildAllParameters(HAC->GetAssetId(), HAC, HAC->Parameters, NewParameters, true, bForceFullUpdate, HAC->GetHoudiniAsset(), HAC->GetHapiAssetName()))
+	bool bParametersChanged = true;
+	if (FHoudiniParameterTranslator::BuildAllParameters(HAC->GetAssetId(), HAC, HAC->Parameters, NewParameters, true, bForceFullUpdate, HAC->GetHoudiniAsset(), HAC->GetHapiAssetName(), &bParametersChanged))
 	{
 		/*
 		// DO NOT MANUALLY DESTROY THE OLD/DANGLING PARAMETERS!
@@ -111,7 +112,8 @@ FHoudiniParameterTranslator::UpdateParameters(UHoudiniAssetComponent* HAC)
 
 #if WITH_EDITORONLY_DATA
 		// Indicate we want to update the details panel after the parameter changes/updates
-		HAC->bNeedToUpdateEditorProperties = true;
+		if (bParametersChanged)
+			HAC->bNeedToUpdateEditorProperties = true;
 #endif
 	}
 
@@ -236,6 +238,159 @@ FHoudiniParameterTranslator::UpdateLoadedParameters(UHoudiniAssetComponent* HAC)
 	return true;
 }
 
+// Parameter infos and values of a node used during the last BuildAllParameters.
+// Used to skip rebuilding the parameters when nothing has changed on the node.
+struct FHoudiniCachedNodeParameters
+{
+	TArray<HAPI_ParmInfo> ParmInfos;
+	TArray<int> IntValues;
+	TArray<float> FloatValues;
+	TArray<FString> StringValues;
+	// Labels, names, help and type info of the parameters, then the labels and values of the menu choices,
+	// then the names and values of the parameter tags.
+	// These can all change without changing the parameter infos (script menus, spare parameters...).
+	TArray<FString> Strings;
+	TArray<TWeakObjectPtr<UHoudiniParameter>> Parameters;
+
+	static bool AreParmInfosEquivalent(const HAPI_ParmInfo& A, const HAPI_ParmInfo& B)
+	{
+		// String handles are not compared as they are not guaranteed to be identical between calls
+		return A.id == B.id
+			&& A.parentId == B.parentId
+			&& A.childIndex == B.childIndex
+			&& A.type == B.type
+			&& A.scriptType == B.scriptType
+			&& A.size == B.size
+			&& A.permissions == B.permissions
+			&& A.choiceCount == B.choiceCount
+			&& A.choiceListType == B.choiceListType
+			&& A.tagCount == B.tagCount
+			&& A.hasMin == B.hasMin
+			&& A.hasMax == B.hasMax
+			&& A.hasUIMin == B.hasUIMin
+			&& A.hasUIMax == B.hasUIMax
+			&& A.min == B.min
+			&& A.max == B.max
+			&& A.UIMin == B.UIMin
+			&& A.UIMax == B.UIMax
+			&& A.invisible == B.invisible
+			&& A.disabled == B.disabled
+			&& A.spare == B.spare
+			&& A.joinNext == B.joinNext
+			&& A.labelNone == B.labelNone
+			&& A.intValuesIndex == B.intValuesIndex
+			&& A.floatValuesIndex == B.floatValuesIndex
+			&& A.stringValuesIndex == B.stringValuesIndex
+			&& A.choiceIndex == B.choiceIndex
+			&& A.inputNodeType == B.inputNodeType
+			&& A.inputNodeFlag == B.inputNodeFlag
+			&& A.isChildOfMultiParm == B.isChildOfMultiParm
+			&& A.instanceNum == B.instanceNum
+			&& A.instanceLength == B.instanceLength
+			&& A.instanceCount == B.instanceCount
+			&& A.instanceStartOffset == B.instanceStartOffset
+			&& A.rampType == B.rampType
+			&& A.useMenuItemTokenAsValue == B.useMenuItemTokenAsValue;
+	}
+
+	bool Matches(
+		const TArray<HAPI_ParmInfo>& InParmInfos,
+		const TArray<int>& InIntValues,
+		const TArray<float>& InFloatValues,
+		const TArray<FString>& InStringValues,
+		const TArray<FString>& InStrings,
+		const TArray<TObjectPtr<UHoudiniParameter>>& InCurrentParameters) const
+	{
+		if (ParmInfos.Num() != InParmInfos.Num()
+			|| IntValues.Num() != InIntValues.Num()
+			|| FloatValues.Num() != InFloatValues.Num()
+			|| StringValues.Num() != InStringValues.Num()
+			|| Strings.Num() != InStrings.Num()
+			|| Parameters.Num() != InCurrentParameters.Num())
+			return false;
+
+		// The current parameters must be the ones we built last time, and must not have pending changes
+		for (int32 Idx = 0; Idx < Parameters.Num(); Idx++)
+		{
+			const UHoudiniParameter* Parm = InCurrentParameters[Idx];
+			if (!IsValid(Parm) || Parm != Parameters[Idx].Get() || Parm->HasChanged())
+				return false;
+		}
+
+		if (FMemory::Memcmp(IntValues.GetData(), InIntValues.GetData(), IntValues.Num() * sizeof(int)) != 0)
+			return false;
+
+		if (FMemory::Memcmp(FloatValues.GetData(), InFloatValues.GetData(), FloatValues.Num() * sizeof(float)) != 0)
+			return false;
+
+		if (StringValues != InStringValues)
+			return false;
+
+		if (Strings != InStrings)
+			return false;
+
+		for (int32 Idx = 0; Idx < ParmInfos.Num(); Idx++)
+		{
+			if (!AreParmInfosEquivalent(ParmInfos[Idx], InParmInfos[Idx]))
+				return false;
+		}
+
+		return true;
+	}
+};
+
+static TMap<HAPI_NodeId, FHoudiniCachedNodeParameters> CachedNodeParameters;
+
+// Fetches the names and values of the tags of all the parameters of a node.
+static bool
+HoudiniGetAllParameterTags(const HAPI_NodeId& NodeId, const TArray<HAPI_ParmInfo>& ParmInfos, TArray<FString>& OutTags)
+{
+	TArray<FString> TagNames;
+	TArray<HAPI_StringHandle> TagValueHandles;
+	for (const HAPI_ParmInfo& ParmInfo : ParmInfos)
+	{
+		for (int32 Idx = 0; Idx < ParmInfo.tagCount; Idx++)
+		{
+			HAPI_StringHandle TagNameSH;
+			if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetParmTagName(
+				FHoudiniEngine::Get().GetSession(), NodeId, ParmInfo.id, Idx, &TagNameSH))
+				return false;
+
+			FString TagName;
+			if (!FHoudiniEngineString::ToFString(TagNameSH, TagName))
+				return false;
+
+			HAPI_StringHandle TagValueSH;
+			if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetParmTagValue(
+				FHoudiniEngine::Get().GetSession(), NodeId, ParmInfo.id, TCHAR_TO_ANSI(*TagName), &TagValueSH))
+				return false;
+
+			TagNames.Add(MoveTemp(TagName));
+			TagValueHandles.Add(TagValueSH);
+		}
+	}
+
+	TArray<FString> TagValues;
+	TagValues.SetNum(TagValueHandles.Num());
+	if (TagValueHandles.Num() > 0 && !FHoudiniEngineString::SHArrayToFStringArray_Batch(TagValueHandles, TagValues.GetData()))
+		return false;
+
+	OutTags.Reserve(OutTags.Num() + TagNames.Num() * 2);
+	for (int32 Idx = 0; Idx < TagNames.Num(); Idx++)
+	{
+		OutTags.Add(MoveTemp(TagNames[Idx]));
+		OutTags.Add(MoveTemp(TagValues[Idx]));
+	}
+
+	return true;
+}
+
+void
+FHoudiniParameterTranslator::ResetCachedNodeParameters()
+{
+	CachedNodeParameters.Empty();
+}
+
 bool
 FHoudiniParameterTranslator::BuildAllParameters(
 	const HAPI_NodeId& AssetId, 
@@ -245,10 +400,14 @@ FHoudiniParameterTranslator::BuildAllParameters(
 	const bool& bUpdateValues,
 	const bool& InForceFullUpdate,
 	const UHoudiniAsset* InHoudiniAsset,
-	const FString& InHoudiniAssetName)
+	const FString& InHoudiniAssetName,
+	bool* bOutParametersChanged)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniParameterTranslator::BuildAllParameters);
 
+	if (bOutParametersChanged)
+		*bOutParametersChanged = true;
+
 	// Ensure the asset has a valid node ID
 	const bool bIsAssetValid = IsValid(InHoudiniAsset);	
 	if (AssetId < 0 && !bIsAssetValid)
@@ -271,6 +430,12 @@ FHoudiniParameterTranslator::BuildAllParameters(
 	HAPI_NodeId NodeId = -1;
 	HAPI_AssetLibraryId AssetLibraryId = -1;
 	FString HoudiniAssetName;
+
+	// Value counts of the instantiated node, used to fetch all its values in bulk.
+	int NodeIntValueCount = 0;
+	int NodeFloatValueCount = 0;
+	int NodeStringValueCount = 0;
+	int NodeChoiceCount = 0;
 	
 	if (AssetId >= 0)
 	{
@@ -295,6 +460,10 @@ FHoudiniParameterTranslator::BuildAllParameters(
 			FHoudiniEngine::Get().GetSession(), AssetInfo.nodeId, &NodeInfo), false);
 
 		ParmCount = NodeInfo.parmCount;
+		NodeIntValueCount = NodeInfo.parmIntValueCount;
+		NodeFloatValueCount = NodeInfo.parmFloatValueCount;
+		NodeStringValueCount = NodeInfo.parmStringValueCount;
+		NodeChoiceCount = NodeInfo.parmChoiceCount;
 	}
 	else
 	{
@@ -384,6 +553,7 @@ FHoudiniParameterTranslator::BuildAllParameters(
 	if (ParmCount == 0)
 	{
 		// The asset doesnt have any parameter, we're done.
+		CachedNodeParameters.Remove(NodeId);
 		return true;
 	}
 	else if (ParmCount < 0)
@@ -407,6 +577,99 @@ FHoudiniParameterTranslator::BuildAllParameters(
 				FHoudiniEngine::Get().GetSession(), AssetLibraryId, TCHAR_TO_UTF8(*HoudiniAssetName), &ParmInfos[0], 0, ParmCount), false);
 	}
 
+	// Values used to update the parameters: the asset definition's defaults, or the node's values.
+	const TArray<int>* IntValues = AssetId >= 0 ? nullptr : &DefaultIntValues;
+	const TArray<float>* FloatValues = AssetId >= 0 ? nullptr : &DefaultFloatValues;
+	const TArray<HAPI_StringHandle>* StringValues = AssetId >= 0 ? nullptr : &DefaultStringValues;
+	const TArray<HAPI_ParmChoiceInfo>* ChoiceValues = AssetId >= 0 ? nullptr : &DefaultChoiceValues;
+
+	// Fetch all the node's values with one call per value type, instead of one call per parameter.
+	// If this fails, UpdateParameterFromInfo will fetch the values of each parameter individually.
+	TArray<int> NodeIntValues;
+	TArray<float> NodeFloatValues;
+	TArray<HAPI_StringHandle> NodeStringValues;
+	bool bHasNodeValues = false;
+	if (AssetId >= 0)
+	{
+		bHasNodeValues = HapiGetAllParameterValues(
+			NodeId, NodeIntValueCount, NodeFloatValueCount, NodeStringValueCount,
+			NodeIntValues, NodeFloatValues, NodeStringValues);
+
+		if (bHasNodeValues)
+		{
+			IntValues = &NodeIntValues;
+			FloatValues = &NodeFloatValues;
+			StringValues = &NodeStringValues;
+		}
+	}
+
+	// Compare the node's values and parameter infos with the ones from the previous update.
+	// If nothing changed, we can keep the current parameters as they are.
+	TArray<FString> NodeStringValuesResolved;
+	TArray<FString> NodeStringsResolved;
+	bool bCanUseCache = bHasNodeValues && bUpdateValues;
+	if (bCanUseCache)
+	{
+		NodeStringValuesResolved.SetNum(NodeStringValues.Num());
+		if (NodeStringValues.Num() > 0)
+			FHoudiniEngineString::SHArrayToFStringArray_Batch(NodeStringValues, NodeStringValuesResolved.GetData());
+
+		// The labels, help, tags and menu choices can change without changing the parm infos
+		// (script menus, expressions in labels, spare parameters), so fetch and compare them as well.
+		TArray<HAPI_ParmChoiceInfo> NodeChoices;
+		if (NodeChoiceCount > 0)
+		{
+			NodeChoices.SetNum(NodeChoiceCount);
+			for (int32 Idx = 0; Idx < NodeChoices.Num(); Idx++)
+				FHoudiniApi::ParmChoiceInfo_Init(&(NodeChoices[Idx]));
+
+			if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetParmChoiceLists(
+				FHoudiniEngine::Get().GetSession(), NodeId, NodeChoices.GetData(), 0, NodeChoiceCount))
+				bCanUseCache = false;
+		}
+
+		TArray<HAPI_StringHandle> StringHandles;
+		StringHandles.Reserve(ParmInfos.Num() * 4 + NodeChoices.Num() * 2);
+		for (const HAPI_ParmInfo& ParmInfo : ParmInfos)
+		{
+			StringHandles.Add(ParmInfo.labelSH);
+			StringHandles.Add(ParmInfo.nameSH);
+			// Help and type info are optional
+			if (ParmInfo.helpSH >= 0)
+				StringHandles.Add(ParmInfo.helpSH);
+			if (ParmInfo.typeInfoSH >= 0)
+				StringHandles.Add(ParmInfo.typeInfoSH);
+		}
+		for (const HAPI_ParmChoiceInfo& Choice : NodeChoices)
+		{
+			StringHandles.Add(Choice.labelSH);
+			StringHandles.Add(Choice.valueSH);
+		}
+
+		NodeStringsResolved.SetNum(StringHandles.Num());
+		if (bCanUseCache && !FHoudiniEngineString::SHArrayToFStringArray_Batch(StringHandles, NodeStringsResolved.GetData()))
+			bCanUseCache = false;
+
+		if (bCanUseCache && !HoudiniGetAllParameterTags(NodeId, ParmInfos, NodeStringsResolved))
+			bCanUseCache = false;
+	}
+
+	if (bCanUseCache)
+	{
+		const FHoudiniCachedNodeParameters* Cached = CachedNodeParameters.Find(NodeId);
+		if (!InForceFullUpdate && Cached
+			&& Cached->Matches(ParmInfos, NodeIntValues, NodeFloatValues, NodeStringValuesResolved, NodeStringsResolved, CurrentParameters))
+		{
+			NewParameters = CurrentParameters;
+			CurrentParameters.Empty();
+
+			if (bOutParametersChanged)
+				*bOutParametersChanged = false;
+
+			return true;
+		}
+	}
+
 	// Create a name lookup cache for the current parameters
 	// Use an array has in some cases, multiple parameters can have the same name!
 	TMap<FString, TArray<UHoudiniParameter*>> CurrentParametersByName;
@@ -550,10 +813,7 @@ FHoudiniParameterTranslator::BuildAllParameters(
 			// Do a fast update of this parameter
 			if (!FHoudiniParameterTranslator::UpdateParameterFromInfo(
 					HoudiniAssetParameter, NodeId, ParmInfo, InForceFullUpdate, bUpdateValues, 
-					AssetId >= 0 ? nullptr : &DefaultIntValues,
-					AssetId >= 0 ? nullptr : &DefaultFloatValues,
-					AssetId >= 0 ? nullptr : &DefaultStringValues,
-					AssetId >= 0 ? nullptr : &DefaultChoiceValues))
+					IntValues, FloatValues, StringValues, ChoiceValues))
 				continue;
 
 			// Reset the states of ramp parameters.
@@ -599,10 +859,7 @@ FHoudiniParameterTranslator::BuildAllParameters(
 			// Fully update this parameter
 			if (!FHoudiniParameterTranslator::UpdateParameterFromInfo(
 					HoudiniAssetParameter, NodeId, ParmInfo, true, true,
-					AssetId >= 0 ? nullptr : &DefaultIntValues,
-					AssetId >= 0 ? nullptr : &DefaultFloatValues,
-					AssetId >= 0 ? nullptr : &DefaultStringValues,
-					AssetId >= 0 ? nullptr : &DefaultChoiceValues))
+					IntValues, FloatValues, StringValues, ChoiceValues))
 				continue;
 
 			// Record float and color ramps for further processing (creating their Points arrays)
@@ -705,10 +962,72 @@ FHoudiniParameterTranslator::BuildAllParameters(
 			RampColorParam->UpdatePointsArray(NewParameters, ParamIndex + 1);
 		}
 	}
+
+	// Keep the values we've just used to detect unchanged parameters on the next update
+	if (bCanUseCache)
+	{
+		// Deleted nodes are only removed from the cache with the session, simply reset it if it grows too much
+		if (CachedNodeParameters.Num() >= 1024 && !CachedNodeParameters.Contains(NodeId))
+			CachedNodeParameters.Empty();
+
+		FHoudiniCachedNodeParameters& Cached = CachedNodeParameters.FindOrAdd(NodeId);
+		Cached.ParmInfos = MoveTemp(ParmInfos);
+		Cached.IntValues = MoveTemp(NodeIntValues);
+		Cached.FloatValues = MoveTemp(NodeFloatValues);
+		Cached.StringValues = MoveTemp(NodeStringValuesResolved);
+		Cached.Strings = MoveTemp(NodeStringsResolved);
+		Cached.Parameters.Empty(NewParameters.Num());
+		for (const auto& Parm : NewParameters)
+			Cached.Parameters.Add(Parm);
+	}
+	else if (AssetId >= 0)
+	{
+		CachedNodeParameters.Remove(NodeId);
+	}
+
+	if (bOutParametersChanged)
+		*bOutParametersChanged = true;
 	
 	return true;
 }
 
+bool
+FHoudiniParameterTranslator::HapiGetAllParameterValues(
+	const HAPI_NodeId& InNodeId,
+	const int32& InIntValueCount,
+	const int32& InFloatValueCount,
+	const int32& InStringValueCount,
+	TArray<int>& OutIntValues,
+	TArray<float>& OutFloatValues,
+	TArray<HAPI_StringHandle>& OutStringValues)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHoudiniParameterTranslator::HapiGetAllParameterValues);
+
+	OutIntValues.SetNumZeroed(FMath::Max(InIntValueCount, 0));
+	OutFloatValues.SetNumZeroed(FMath::Max(InFloatValueCount, 0));
+	OutStringValues.SetNumZeroed(FMath::Max(InStringValueCount, 0));
+
+	if (OutIntValues.Num() > 0)
+	{
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetParmIntValues(
+			FHoudiniEngine::Get().GetSession(), InNodeId, OutIntValues.GetData(), 0, OutIntValues.Num()), false);
+	}
+
+	if (OutFloatValues.Num() > 0)
+	{
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetParmFloatValues(
+			FHoudiniEngine::Get().GetSession(), InNodeId, OutFloatValues.GetData(), 0, OutFloatValues.Num()), false);
+	}
+
+	if (OutStringValues.Num() > 0)
+	{
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetParmStringValues(
+			FHoudiniEngine::Get().GetSession(), InNodeId, false, OutStringValues.GetData(), 0, OutStringValues.Num()), false);
+	}
+
+	return true;
+}
+
 
 void
 FHoudiniParameterTranslator::GetParmTypeFromParmInfo(
@@ -1338,6 +1657,13 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 	const bool bHasValidNodeId = InNodeId >= 0;
 	if (bHasValidNodeId)
 		HoudiniParameter->SetNodeId(InNodeId);
+
+	// When value arrays are provided (asset definition defaults, or the node's values fetched in bulk)
+	// the values are sliced from them, we only query HAPI when they're missing.
+	const bool bFetchIntValues = bHasValidNodeId && !DefaultIntValues;
+	const bool bFetchFloatValues = bHasValidNodeId && !DefaultFloatValues;
+	const bool bFetchStringValues = bHasValidNodeId && !DefaultStringValues;
+
 	HoudiniParameter->SetParmId(ParmInfo.id);
 	HoudiniParameter->SetParentParmId(ParmInfo.parentId);
 
@@ -1505,7 +1831,7 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 				// Stop if we don't want to update the value
 				if (bUpdateValue)
 				{
-					if (bHasValidNodeId)
+					if (bFetchIntValues)
 					{
 						if (FHoudiniApi::GetParmIntValues(
 							FHoudiniEngine::Get().GetSession(), InNodeId,
@@ -1586,7 +1912,7 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 				{
 					// Get the actual value for this property.
 					FLinearColor Color = FLinearColor::White;
-					if (bHasValidNodeId)
+					if (bFetchFloatValues)
 					{
 						if (FHoudiniApi::GetParmFloatValues(
 							FHoudiniEngine::Get().GetSession(), InNodeId,
@@ -1686,7 +2012,7 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 					// Get the actual values for this property.
 					TArray< HAPI_StringHandle > StringHandles;
 
-					if (bHasValidNodeId)
+					if (bFetchStringValues)
 					{
 						StringHandles.SetNumZeroed(ParmInfo.size);
 						if (FHoudiniApi::GetParmStringValues(
@@ -1745,7 +2071,7 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 					// Update the parameter's value
 					HoudiniParameterFloat->SetNumberOfValues(ParmInfo.size);
 
-					if (bHasValidNodeId)
+					if (bFetchFloatValues)
 					{
 						if (FHoudiniApi::GetParmFloatValues(
 								FHoudiniEngine::Get().GetSession(), InNodeId,
@@ -1951,7 +2277,7 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 					// Get the actual values for this property.
 					HoudiniParameterInt->SetNumberOfValues(ParmInfo.size);
 
-					if (bHasValidNodeId)
+					if (bFetchIntValues)
 					{
 						if (FHoudiniApi::GetParmIntValues(
 							FHoudiniEngine::Get().GetSession(), InNodeId,
@@ -2072,7 +2398,7 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 					// Get the actual values for this property.
 					int32 CurrentIntValue = 0;
 
-					if (bHasValidNodeId)
+					if (bFetchIntValues)
 					{
 						HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetParmIntValues(
 							FHoudiniEngine::Get().GetSession(),
@@ -2201,7 +2527,7 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 					// Get the actual values for this property.
 					HAPI_StringHandle StringHandle;
 
-					if (bHasValidNodeId)
+					if (bFetchStringValues)
 					{
 						HOUDINI_CHECK_ERROR_RETURN( FHoudiniApi::GetParmStringValues(
 							FHoudiniEngine::Get().GetSession(),
@@ -2314,7 +2640,7 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 				// Get the actual value for this property.
 				TArray<HAPI_StringHandle> StringHandles;
 
-				if (bHasValidNodeId)
+				if (bFetchStringValues)
 				{
 					StringHandles.SetNumZeroed(ParmInfo.size);
 					FHoudiniApi::GetParmStringValues(
@@ -2365,7 +2691,7 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 				// Set the multiparm value
 				int32 MultiParmValue = 0;
 
-				if (bHasValidNodeId)
+				if (bFetchIntValues)
 				{
 					HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetParmIntValues(
 						FHoudiniEngine::Get().GetSession(),
@@ -2429,7 +2755,7 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 					// Get the actual value for this property.
 					TArray< HAPI_StringHandle > StringHandles;
 
-					if (bHasValidNodeId)
+					if (bFetchStringValues)
 					{
 						StringHandles.SetNumZeroed(ParmInfo.size);
 						if (FHoudiniApi::GetParmStringValues(
@@ -2498,7 +2824,7 @@ FHoudiniParameterTranslator::UpdateParameterFromInfo(
 					// Get the actual values for this property.
 					HoudiniParameterToggle->SetNumberOfValues(ParmInfo.size);
 
-					if (bHasValidNodeId)
+					if (bFetchIntValues)
 					{
 						if (FHoudiniApi::GetParmIntValues(
 							FHoudiniEngine::Get().GetSession(), InNodeId,
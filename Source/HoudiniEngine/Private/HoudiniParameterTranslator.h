@@ -92,7 +92,21 @@ struct HOUDINIENGINE_API FHoudiniParameterTranslator
 		const bool& bUpdateValues,
 		const bool& InForceFullUpdate,
 		const UHoudiniAsset* InHoudiniAsset,
-		const FString& InHoudiniAssetName);
+		const FString& InHoudiniAssetName,
+		bool* bOutParametersChanged = nullptr);
+
+	// Forgets the node parameters cached by BuildAllParameters, when the session is stopped or restarted. Game thread only.
+	static void ResetCachedNodeParameters();
+
+	// Fetches all the int, float and string values of a node's parameters with a single call per type.
+	static bool HapiGetAllParameterValues(
+		const HAPI_NodeId& InNodeId,
+		const int32& InIntValueCount,
+		const int32& InFloatValueCount,
+		const int32& InStringValueCount,
+		TArray<int>& OutIntValues,
+		TArray<float>& OutFloatValues,
+		TArray<HAPI_StringHandle>& OutStringValues);
 
 	// Parameter creation
 	static UHoudiniParameter * CreateTypedParameter(
@@ -105,6 +119,8 @@ struct HOUDINIENGINE_API FHoudiniParameterTranslator
 	// and set to true when creating a new parameter
 	// bUpdateValue should be set to false when updating loaded parameters
 	// as the internal parameter's value from HAPI
+	// When the value arrays are provided, the parameter's values are read from them
+	// (asset definition defaults, or all the node's values fetched in bulk) instead of from HAPI.
 	static bool UpdateParameterFromInfo(
 		UHoudiniParameter * HoudiniParameter,
 		const HAPI_NodeId& InNodeId,
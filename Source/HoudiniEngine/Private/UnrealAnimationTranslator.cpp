@@ -38,6 +38,7 @@
 #include "HoudiniEngineRuntimeUtils.h"
 #include "HoudiniSkeletalMeshUtils.h"
 
+#include "Async/ParallelFor.h"
 #include "Animation/Skeleton.h"
 #include "Animation/AnimSequence.h"
 #include "ReferenceSkeleton.h"
@@ -328,7 +329,7 @@ FUnrealAnimationTranslator::GetCompSpaceTransformForBone(const FReferenceSkeleto
 {
 	FTransform resultBoneTransform = InSkel.GetRefBonePose()[InBoneIdx];
 
-	auto refBoneInfo = InSkel.GetRefBoneInfo();
+	const TArray<FMeshBoneInfo>& refBoneInfo = InSkel.GetRefBoneInfo();
 
 	int32 Bone = InBoneIdx;
 	while (Bone)
@@ -349,7 +350,7 @@ FUnrealAnimationTranslator::GetCompSpacePoseTransformForBoneMap(const TMap<int,F
 		resultBoneTransform = BoneMap.FindChecked(InBoneIdx);
 	}
 
-	auto refBoneInfo = InSkel.GetRefBoneInfo();
+	const TArray<FMeshBoneInfo>& refBoneInfo = InSkel.GetRefBoneInfo();
 
 	int32 Bone = InBoneIdx;
 	while (Bone)
@@ -375,7 +376,7 @@ FUnrealAnimationTranslator::GetCompSpacePoseTransformForBone(const TArray<FTrans
 {
 	FTransform resultBoneTransform = Bones[InBoneIdx];
 
-	auto refBoneInfo = InSkel.GetRefBoneInfo();
+	const TArray<FMeshBoneInfo>& refBoneInfo = InSkel.GetRefBoneInfo();
 
 	int32 Bone = InBoneIdx;
 	while (Bone)
@@ -393,20 +394,22 @@ FUnrealAnimationTranslator::GetCompSpacePoseTransformForBone(const TArray<FTrans
 void
 FUnrealAnimationTranslator::GetComponentSpaceTransforms(TArray<FTransform>& OutResult, const FReferenceSkeleton& InRefSkeleton)
 {
-	const int32 PoseNum = InRefSkeleton.GetRefBonePose().Num();
+	const TArray<FTransform>& RefBonePose = InRefSkeleton.GetRefBonePose();
+	const int32 PoseNum = RefBonePose.Num();
 	OutResult.SetNum(PoseNum);
 
+	// Parents are always before their children, so their component space transform is already computed
 	for (int32 i = 0; i < PoseNum; i++)
 	{
-		OutResult[i] = FUnrealAnimationTranslator::GetCompSpaceTransformForBone(InRefSkeleton, i);
-
+		const int32 ParentIndex = InRefSkeleton.GetParentIndex(i);
+		OutResult[i] = ParentIndex != INDEX_NONE ? RefBonePose[i] * OutResult[ParentIndex] : RefBonePose[i];
 	}
 }
 
 FString FUnrealAnimationTranslator::GetBonePathForBone(const FReferenceSkeleton& InSkel, int32 InBoneIdx)
 {
 	FString BonePath;
-	auto refBoneInfo = InSkel.GetRefBoneInfo();
+	const TArray<FMeshBoneInfo>& refBoneInfo = InSkel.GetRefBoneInfo();
 
 	int32 Bone = InBoneIdx;
 	TArray<int32> Indices;
@@ -452,77 +455,67 @@ FUnrealAnimationTranslator::AddBoneTracksToNode(HAPI_NodeId& NewNodeId, UAnimSeq
 	//Iterate over BoneTracks
 	for (FName TrackName : BonesTrackNames)
 	{
-		//const FMeshBoneInfo& CurrentBone = RefSkeleton.GetRefBoneInfo()[BoneIndex];
 		TArray<FTransform> ThisTrackTransforms;
 		DataModel->GetBoneTrackTransforms(TrackName, ThisTrackTransforms);
-		FString DetailAttributeName = FString::Printf(TEXT("%s_transforms"), *TrackName.ToString());
 		TotalTrackKeys = ThisTrackTransforms.Num();
-		TArray<float> TrackFloatKeys;
-		TrackFloatKeys.SetNumZeroed(TotalTrackKeys * 20);
-		TrackMap.Add(TrackName, ThisTrackTransforms);
+		TrackMap.Add(TrackName, MoveTemp(ThisTrackTransforms));
 	}
 
+	const int BoneCount = BonesTrackNames.Num();
+	const int RefBoneCount = RefSkeleton.GetRefBoneInfo().Num();
+	const int32 NumFrames = TotalTrackKeys + 1;  // adding extra key for append
+
 	TArray<float> WorldSpaceBonePositions;
+	WorldSpaceBonePositions.SetNumZeroed(3 * BoneCount * NumFrames);
+
 	TArray<float> LocalTransformData;  //for pCaptData property
-	LocalTransformData.SetNumZeroed(4 * 4 * BonesTrackNames.Num() * (TotalTrackKeys + 1));  //4x4 matrix  // adding extra key for append
+	LocalTransformData.SetNumZeroed(4 * 4 * BoneCount * NumFrames);  //4x4 matrix
 
 	TArray<float> WorldTransformData;
-	WorldTransformData.SetNumZeroed(3 * 3 * BonesTrackNames.Num() * (TotalTrackKeys + 1));  //3x3 matrix
+	WorldTransformData.SetNumZeroed(3 * 3 * BoneCount * NumFrames);  //3x3 matrix
 
 	TArray<int32> PrimIndices;
 	int PrimitiveCount = 0;
-	int BoneCount = BonesTrackNames.Num();
-	int RefBoneCount = RefSkeleton.GetRefBoneInfo().Num();
 	TArray<FString> BoneNames;
 	TArray<FString> BonePaths;
 	TArray<FString> UnrealSkeletonPaths;
-	
-	TArray< TMap<int, FTransform>> Frames;
-	TMap<int, int> BoneIndexCounterMap;
+
 	// AnimCurve data is stored in the fbx_custom_attributes dictionary which is stored on root joints for each frame
 	// For any joint that is not the "root" join, the dict can be empty.
 	// Note that we have to add an extra frame to the data for the topology frame.
 	TArray<FString> FbxCustomAttributes;
-	FbxCustomAttributes.SetNum(BonesTrackNames.Num() * (TotalTrackKeys+1));
+	FbxCustomAttributes.SetNum(BoneCount * NumFrames);
 
 	// Map Bone Indexes (from skeleton) to indexes for output data
 	// since animated bones are typically a subset of the bones from the skeleton.
+	TMap<int, int> BoneIndexCounterMap;
+	TArray<int32> TrackRefBoneIndices;
+	TrackRefBoneIndices.SetNumUninitialized(BoneCount);
 	int RootBoneIndex = INDEX_NONE;
+	for (int32 BoneDataIndex = 0; BoneDataIndex < BoneCount; BoneDataIndex++)
 	{
-		int BoneNameCounter = 0;
-		for (FName AnimBoneName : BonesTrackNames)
+		const FName& AnimBoneName = BonesTrackNames[BoneDataIndex];
+		const int32 BoneIndex = RefSkeleton.FindBoneIndex(AnimBoneName);
+		BoneIndexCounterMap.Add(BoneIndex, BoneDataIndex);
+		TrackRefBoneIndices[BoneDataIndex] = BoneIndex;
+		if (AnimBoneName == "root")
 		{
-			int32 BoneIndex = Skeleton->GetReferenceSkeleton().FindBoneIndex(AnimBoneName);
-			BoneIndexCounterMap.Add(BoneIndex, BoneNameCounter);
-			if (AnimBoneName == "root")
-			{
-				RootBoneIndex = BoneNameCounter;
-			}
-			BoneNameCounter++;
+			RootBoneIndex = BoneDataIndex;
 		}
 	}
 
-	for (int KeyFrame = 0; KeyFrame < TotalTrackKeys; KeyFrame++)
+	// Keys of each bone of the reference skeleton, null for bones without a track.
+	TArray<const TArray<FTransform>*> RefBoneTracks;
+	RefBoneTracks.SetNumZeroed(RefBoneCount);
+	for (int32 BoneIndex = 0; BoneIndex < RefBoneCount; BoneIndex++)
 	{
-		int32 BoneIndex = 0;
-		TArray<FTransform> KeyBoneTransforms;
-		//for each bone
-		TMap<int, FTransform> SingleFrame;
-		for (const FMeshBoneInfo& MeshBoneInfo : RefSkeleton.GetRefBoneInfo())
-		{
-			//add that tracks keys
-			if (TrackMap.Contains(MeshBoneInfo.Name))
-			{
-				TArray<FTransform>& TransformArray = TrackMap[MeshBoneInfo.Name];
-				FTransform KeyBoneTransform = TransformArray[KeyFrame];
-				KeyBoneTransforms.Add(KeyBoneTransform);
-				SingleFrame.Add(BoneIndex, KeyBoneTransform);
-			}
-			
-			BoneIndex++;
-		}
+		RefBoneTracks[BoneIndex] = TrackMap.Find(RefSkeleton.GetRefBoneInfo()[BoneIndex].Name);
+	}
 
-		if (RootBoneIndex != INDEX_NONE)
+	if (RootBoneIndex != INDEX_NONE)
+	{
+		const FAnimationCurveData& CurveData = DataModel->GetCurveData();
+		for (int KeyFrame = 0; KeyFrame < TotalTrackKeys; KeyFrame++)
 		{
 			// Sample anim curves and store the data on the root bone for this keyframe.
 			// Note that we're skipping over the topology frame (hence the Keyframe+1).
@@ -533,9 +526,7 @@ FUnrealAnimationTranslator::AddBoneTracksToNode(HAPI_NodeId& NewNodeId, UAnimSeq
 			TSharedPtr<FJsonObject> JSONObject = MakeShareable(new FJsonObject);
 
 			// Sample all the curves for the current time value
-			const FAnimationCurveData& CurveData = DataModel->GetCurveData();
-			TArray<FFloatCurve> FloatCurves = CurveData.FloatCurves;
-			for (const FFloatCurve& Curve : FloatCurves)
+			for (const FFloatCurve& Curve : CurveData.FloatCurves)
 			{
 				float Sample = Curve.Evaluate(SampleTime);
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 3
@@ -547,92 +538,98 @@ FUnrealAnimationTranslator::AddBoneTracksToNode(HAPI_NodeId& NewNodeId, UAnimSeq
 			
 			FbxCustomAttributes[DataIndex] = FHoudiniEngineUtils::JSONToString(JSONObject);
 		}
-		
-		Frames.Add(SingleFrame);
 	}
-	TArray<int32> FrameIndexData;
-	TArray<float> TimeData;
-	
-
-	bool AppendFirstFrame = true;  //topology frame
-	TMap<FName, FMeshBoneInfo> BoneInfos;
 
-	for (const FMeshBoneInfo& MeshBoneInfo : Skeleton->GetReferenceSkeleton().GetRefBoneInfo())
-	{
-		BoneInfos.Add(MeshBoneInfo.Name, MeshBoneInfo);
-	}
-	
-	//For Each Key Frame ( eg 1-60)
-	// We'll be using the FrameOffset to inject the first frame twice for the MotionClip topology frame.
-	int FrameOffset = 0;
-	for (int FrameIndex = 0; FrameIndex < TotalTrackKeys+1; FrameIndex++)
+	// Evaluate the component space pose of each frame and convert the animated bones' transforms.
+	// Frame 0 is the MotionClip topology frame, and uses the first key again.
+	// The reference skeleton orders parents before their children, so a single pass over the bones is
+	// enough to get the component space transforms. Frames are independent and evaluated in parallel.
+	ParallelFor(NumFrames, [&](int32 FrameIndex)
 	{
-		if (FrameIndex > 0)
+		const int32 KeyFrame = FMath::Max(FrameIndex - 1, 0);
+
+		TArray<FTransform> CompSpaceTransforms;
+		CompSpaceTransforms.SetNumUninitialized(RefBoneCount);
+		for (int32 BoneIndex = 0; BoneIndex < RefBoneCount; BoneIndex++)
 		{
-			FrameOffset = -1; 
+			// Bones without keys use the identity
+			const TArray<FTransform>* Track = RefBoneTracks[BoneIndex];
+			const FTransform& LocalTransform = (Track && Track->IsValidIndex(KeyFrame)) ? (*Track)[KeyFrame] : FTransform::Identity;
+
+			const int32 ParentIndex = RefSkeleton.GetParentIndex(BoneIndex);
+			CompSpaceTransforms[BoneIndex] = ParentIndex != INDEX_NONE
+				? LocalTransform * CompSpaceTransforms[ParentIndex]
+				: LocalTransform;
 		}
-		
-		int32 BoneRefIndex = 0;
-		int32 BoneDataIndex = 0;
-		//for each bone
-		for (FName KeyBoneName : BonesTrackNames)
+
+		for (int32 BoneDataIndex = 0; BoneDataIndex < BoneCount; BoneDataIndex++)
 		{
-			BoneRefIndex = Skeleton->GetReferenceSkeleton().FindBoneIndex(KeyBoneName);
-			const FMeshBoneInfo& MeshBoneInfo = BoneInfos.FindChecked(KeyBoneName);
-			//add that tracks keys
-			if (TrackMap.Contains(MeshBoneInfo.Name))
-			{
-                // Fetch Component Space Bone Matrices. We'll consider this World Space for now.
-				FTransform BoneTransform = FUnrealAnimationTranslator::GetCompSpacePoseTransformForBoneMap(Frames[FrameIndex+FrameOffset], RefSkeleton, BoneRefIndex);
-				FMatrix BoneMatrix = BoneTransform.ToMatrixWithScale();
-
-                // Convert Unreal to Houdini Matrix
-				int32 WorldDataIndex = (FrameIndex)*BonesTrackNames.Num() * 3 * 3 + (BoneDataIndex * 3 * 3);
-				float Pos[3];
-				FHoudiniSkeletalMeshUtils::UnrealToHoudiniMatrix(BoneMatrix, WorldTransformData.GetData() + WorldDataIndex, Pos);
-				WorldSpaceBonePositions.Add(Pos[0]);
-				WorldSpaceBonePositions.Add(Pos[1]);
-				WorldSpaceBonePositions.Add(Pos[2]);
-
-                // Generate Local Transform Data and store it in Houdini Forat
-
-				FMatrix FinalLocalMatrix = BoneMatrix;
-				if (BoneRefIndex > 0)
-				{
-                    // Take into account the parent bone's transform
-					int32 ParentBoneIndex = RefSkeleton.GetParentIndex(BoneRefIndex);
-					FTransform ParentPoseTransform = GetCompSpacePoseTransformForBoneMap(Frames[FrameIndex + FrameOffset], RefSkeleton, ParentBoneIndex);
-					FMatrix ParentMatrix = ParentPoseTransform.ToMatrixWithScale();
-					FinalLocalMatrix = BoneMatrix * ParentMatrix.Inverse();
-				}
+			const int32 BoneRefIndex = TrackRefBoneIndices[BoneDataIndex];
 
-				int32 LocalDataIndex = (FrameIndex) * BonesTrackNames.Num() * 4 * 4 + (BoneDataIndex * 4 * 4);
+			// Fetch Component Space Bone Matrices. We'll consider this World Space for now.
+			FMatrix BoneMatrix = CompSpaceTransforms[BoneRefIndex].ToMatrixWithScale();
 
-				FHoudiniSkeletalMeshUtils::UnrealToHoudiniMatrix(FinalLocalMatrix, LocalTransformData.GetData() + LocalDataIndex);
-  
-				// WorldTransformData[i * OutNames.Num() * 3 * 3] = BoneIndex;
-				const float TimeValue = FrameIndex > 0 ? (FrameIndex-1) * FrameRateInterval : 0.f;
-				if (BoneRefIndex > 0)
-				{
-					const int32 ParentDataIndex = BoneIndexCounterMap.FindChecked(MeshBoneInfo.ParentIndex);
-					PrimIndices.Add((FrameIndex * BoneCount) + ParentDataIndex);
-					PrimIndices.Add((FrameIndex * BoneCount) + BoneDataIndex);
-					FrameIndexData.Add(FrameIndex);
-					// The topology frame (FrameIndex = 0) and the first anim frame (FrameIndex = 1) Should have time = 0.
-					TimeData.Add(TimeValue);
-					PrimitiveCount++;
-				}
-				BoneNames.Add(MeshBoneInfo.Name.ToString());
-				BonePaths.Add(GetBonePathForBone(RefSkeleton, BoneRefIndex));
-				UnrealSkeletonPaths.Add(SkeletonPathName);
+			// Convert Unreal to Houdini Matrix
+			const int32 PointIndex = FrameIndex * BoneCount + BoneDataIndex;
+			FHoudiniSkeletalMeshUtils::UnrealToHoudiniMatrix(
+				BoneMatrix, WorldTransformData.GetData() + PointIndex * 3 * 3, WorldSpaceBonePositions.GetData() + PointIndex * 3);
+
+			// Generate Local Transform Data and store it in Houdini Format
+			FMatrix FinalLocalMatrix = BoneMatrix;
+			if (BoneRefIndex > 0)
+			{
+				// Take into account the parent bone's transform
+				const int32 ParentBoneIndex = RefSkeleton.GetParentIndex(BoneRefIndex);
+				const FMatrix ParentMatrix = CompSpaceTransforms[ParentBoneIndex].ToMatrixWithScale();
+				FinalLocalMatrix = BoneMatrix * ParentMatrix.Inverse();
 			}
-			else
+
+			FHoudiniSkeletalMeshUtils::UnrealToHoudiniMatrix(FinalLocalMatrix, LocalTransformData.GetData() + PointIndex * 4 * 4);
+		}
+	});
+
+	// Per bone data is identical for all frames, only build it once
+	TArray<FString> TrackBoneNames;
+	TArray<FString> TrackBonePaths;
+	TArray<int32> TrackParentDataIndices;
+	TrackBoneNames.SetNum(BoneCount);
+	TrackBonePaths.SetNum(BoneCount);
+	TrackParentDataIndices.Init(INDEX_NONE, BoneCount);
+	for (int32 BoneDataIndex = 0; BoneDataIndex < BoneCount; BoneDataIndex++)
+	{
+		const int32 BoneRefIndex = TrackRefBoneIndices[BoneDataIndex];
+		TrackBoneNames[BoneDataIndex] = BonesTrackNames[BoneDataIndex].ToString();
+		TrackBonePaths[BoneDataIndex] = GetBonePathForBone(RefSkeleton, BoneRefIndex);
+		if (BoneRefIndex > 0)
+			TrackParentDataIndices[BoneDataIndex] = BoneIndexCounterMap.FindChecked(RefSkeleton.GetParentIndex(BoneRefIndex));
+	}
+
+	TArray<int32> FrameIndexData;
+	TArray<float> TimeData;
+	BoneNames.Reserve(BoneCount * NumFrames);
+	BonePaths.Reserve(BoneCount * NumFrames);
+	UnrealSkeletonPaths.Reserve(BoneCount * NumFrames);
+	for (int FrameIndex = 0; FrameIndex < NumFrames; FrameIndex++)
+	{
+		// The topology frame (FrameIndex = 0) and the first anim frame (FrameIndex = 1) Should have time = 0.
+		const float TimeValue = FrameIndex > 0 ? (FrameIndex-1) * FrameRateInterval : 0.f;
+		for (int32 BoneDataIndex = 0; BoneDataIndex < BoneCount; BoneDataIndex++)
+		{
+			const int32 ParentDataIndex = TrackParentDataIndices[BoneDataIndex];
+			if (ParentDataIndex != INDEX_NONE)
 			{
-				HOUDINI_LOG_WARNING(TEXT("Missing Bone"));
+				PrimIndices.Add((FrameIndex * BoneCount) + ParentDataIndex);
+				PrimIndices.Add((FrameIndex * BoneCount) + BoneDataIndex);
+				FrameIndexData.Add(FrameIndex);
+				TimeData.Add(TimeValue);
+				PrimitiveCount++;
 			}
-			BoneDataIndex++;
 		}
 
+		BoneNames.Append(TrackBoneNames);
+		BonePaths.Append(TrackBonePaths);
+		for (int32 BoneDataIndex = 0; BoneDataIndex < BoneCount; BoneDataIndex++)
+			UnrealSkeletonPaths.Add(SkeletonPathName);
 	}
 
 	//----------------------------------------
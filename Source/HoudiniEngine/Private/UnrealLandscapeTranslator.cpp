@@ -54,6 +54,501 @@
 #include "HoudiniHLODLayerUtils.h"
 #include "HoudiniLandscapeUtils.h"
 
+#include "Hash/CityHash.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineLandscapeInputStreaming(
+	TEXT("HoudiniEngine.LandscapeInputStreaming"),
+	1,
+	TEXT("When enabled, landscapes sent as heightfields are read and uploaded one band of landscape components at a time,\n")
+	TEXT("and updating the input only uploads the bands whose values changed.\n")
+	TEXT("0: Extract and upload each layer of the whole landscape at once\n")
+	TEXT("1: Stream the landscape one band of components at a time (default)\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineLandscapeInputStreamingBandSize(
+	TEXT("HoudiniEngine.LandscapeInputStreamingBandSize"),
+	1,
+	TEXT("The width, in landscape components, of the bands used when streaming landscapes to Houdini.\n")
+	TEXT("Larger bands need more memory but fewer uploads.\n")
+);
+
+// Where the values of a streamed heightfield volume are read from.
+enum class EHoudiniStreamedVolumeSource : uint8
+{
+	Height,
+	EditLayerHeight,
+	TargetLayer,
+	EditLayerTargetLayer,
+	DefaultMask
+};
+
+// A volume of a heightfield streamed from a landscape.
+struct FHoudiniStreamedVolume
+{
+	FString VolumeName;
+	EHoudiniStreamedVolumeSource Source = EHoudiniStreamedVolumeSource::Height;
+
+	// The edit layer to read from, for the EditLayer sources.
+	FName EditLayerName;
+	FGuid EditLayerGuid;
+
+	// The target layer to read from, for the TargetLayer sources.
+	FName TargetLayerName;
+
+	HAPI_NodeId VolumeNodeId = -1;
+	HAPI_NodeId GeoNodeId = -1;
+	HAPI_PartId PartId = 0;
+
+	// Hash of the values last uploaded for each band.
+	TArray<uint64> BandHashes;
+};
+
+// The volumes of a heightfield input streamed from a landscape, kept so that updating the input can reuse its nodes.
+struct FHoudiniStreamedHeightfield
+{
+	// Describes the extents, volumes and attributes of the heightfield: the nodes can't be reused when it changes.
+	FString Layout;
+	FHoudiniExtents Extents;
+	int32 BandSize = 0;
+
+	HAPI_NodeId HLODNodeId = -1;
+	HAPI_NodeId DataLayerNodeId = -1;
+
+	// The object transform is set to the landscape's world transform instead of identity
+	bool bSetObjectTransformToWorldTransform = false;
+
+	TArray<FHoudiniStreamedVolume> Volumes;
+};
+
+// Maps landscape integer values to Houdini float values: (Value - IntOffset) * Spacing + Min.
+struct FHoudiniStreamedValueMapping
+{
+	double IntOffset = 0.0;
+	double Spacing = 1.0;
+	double Min = 0.0;
+};
+
+// The streamed heightfields, by heightfield node id. Only accessed on the game thread.
+static TMap<HAPI_NodeId, FHoudiniStreamedHeightfield> HoudiniStreamedHeightfields;
+
+static int32
+HoudiniGetStreamedBandSize(ALandscapeProxy* LandscapeProxy)
+{
+	return FMath::Max(1, CVarHoudiniEngineLandscapeInputStreamingBandSize.GetValueOnGameThread()) * FMath::Max(1, LandscapeProxy->ComponentSizeQuads);
+}
+
+// Returns the band of Extents at BandIndex. Bands span the full Y extents, as a range of X values is a contiguous range
+// of the (transposed) Houdini volume.
+static FHoudiniExtents
+HoudiniGetStreamedBand(const FHoudiniExtents& Extents, int32 BandSize, int32 BandIndex)
+{
+	FHoudiniExtents Band = Extents;
+	Band.Min.X = Extents.Min.X + BandIndex * BandSize;
+	Band.Max.X = FMath::Min(Band.Min.X + BandSize - 1, Extents.Max.X);
+	return Band;
+}
+
+// Lists the volumes sent for a landscape, in the order they are merged in the heightfield.
+static TArray<FHoudiniStreamedVolume>
+HoudiniGetStreamedVolumes(ALandscapeProxy* LandscapeProxy, const FHoudiniLandscapeExportOptions& Options)
+{
+	TArray<FHoudiniStreamedVolume> Volumes;
+
+	ULandscapeInfo* LandscapeInfo = LandscapeProxy->GetLandscapeInfo();
+	ALandscape* Landscape = LandscapeProxy->GetLandscapeActor();
+
+	FHoudiniStreamedVolume& HeightVolume = Volumes.AddDefaulted_GetRef();
+	HeightVolume.VolumeName = TEXT("height");
+	HeightVolume.Source = EHoudiniStreamedVolumeSource::Height;
+
+	bool bHasMask = false;
+	if (Options.bExportMergedPaintLayers)
+	{
+		for (const FLandscapeInfoLayerSettings& LayerSettings : LandscapeInfo->Layers)
+		{
+			if (!LayerSettings.LayerInfoObj)
+				continue;
+
+			FHoudiniStreamedVolume& Volume = Volumes.AddDefaulted_GetRef();
+			Volume.Source = EHoudiniStreamedVolumeSource::TargetLayer;
+			Volume.TargetLayerName = LayerSettings.GetLayerName();
+			Volume.VolumeName = Volume.TargetLayerName.ToString();
+
+			// Name the visibility layer according to the plugin's expectations instead of using the internal `DataLayer__` name.
+			if (Volume.TargetLayerName.Compare(ALandscape::VisibilityLayer->LayerName) == 0)
+				Volume.VolumeName = HAPI_UNREAL_VISIBILITY_LAYER_NAME;
+
+			if (Volume.VolumeName.Equals(TEXT("mask"), ESearchCase::IgnoreCase))
+				bHasMask = true;
+		}
+	}
+
+	// We need to have a mask layer as it is required for proper heightfield functionalities
+	if (!bHasMask)
+	{
+		FHoudiniStreamedVolume& MaskVolume = Volumes.AddDefaulted_GetRef();
+		MaskVolume.VolumeName = TEXT("mask");
+		MaskVolume.Source = EHoudiniStreamedVolumeSource::DefaultMask;
+	}
+
+	if (!IsValid(Landscape))
+		return Volumes;
+
+	if (Options.bExportPaintLayersPerEditLayer)
+	{
+		for (int32 EditLayerIndex = 0; EditLayerIndex < Landscape->GetLayerCount(); EditLayerIndex++)
+		{
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5
+			const FLandscapeLayer* EditLayer = Landscape->GetLayerConst(EditLayerIndex);
+#else
+			const FLandscapeLayer* EditLayer = Landscape->GetLayer(EditLayerIndex);
+#endif
+			if (!EditLayer)
+				continue;
+
+			for (const FLandscapeInfoLayerSettings& LayerSettings : LandscapeInfo->Layers)
+			{
+				FHoudiniStreamedVolume& Volume = Volumes.AddDefaulted_GetRef();
+				Volume.Source = EHoudiniStreamedVolumeSource::EditLayerTargetLayer;
+				Volume.EditLayerName = EditLayer->Name;
+				Volume.EditLayerGuid = EditLayer->Guid;
+				Volume.TargetLayerName = LayerSettings.GetLayerName();
+				Volume.VolumeName = FString::Format(TEXT("landscapelayer_{0}_{1}"), { Volume.EditLayerName.ToString(), Volume.TargetLayerName.ToString() });
+			}
+		}
+	}
+
+	if (Options.bExportHeightDataPerEditLayer)
+	{
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5	
+		for (const FLandscapeLayer& Layer : Landscape->GetLayers())
+#else
+		for (const FLandscapeLayer& Layer : Landscape->LandscapeLayers)
+#endif
+		{
+			FHoudiniStreamedVolume& Volume = Volumes.AddDefaulted_GetRef();
+			Volume.Source = EHoudiniStreamedVolumeSource::EditLayerHeight;
+			Volume.EditLayerName = Layer.Name;
+			Volume.EditLayerGuid = Layer.Guid;
+			Volume.VolumeName = FString::Format(TEXT("landscapelayer_{0}"), { Layer.Name.ToString() });
+		}
+	}
+
+	return Volumes;
+}
+
+// Describes everything that prevents reusing a streamed heightfield's nodes when it changes.
+static FString
+HoudiniGetStreamedHeightfieldLayout(
+	ALandscapeProxy* LandscapeProxy,
+	const FHoudiniExtents& Extents,
+	int32 BandSize,
+	const TArray<FHoudiniStreamedVolume>& Volumes)
+{
+	FString Layout = FString::Printf(TEXT("%d %d %d %d %d"), Extents.Min.X, Extents.Min.Y, Extents.Max.X, Extents.Max.Y, BandSize);
+
+	for (const FHoudiniStreamedVolume& Volume : Volumes)
+	{
+		Layout += FString::Printf(TEXT("|%s %d %s %s"),
+			*Volume.VolumeName, (int32)Volume.Source, *Volume.EditLayerGuid.ToString(), *Volume.TargetLayerName.ToString());
+	}
+
+	// The volume transform
+	ALandscape* Landscape = LandscapeProxy->GetLandscapeActor();
+	if (IsValid(Landscape))
+		Layout += TEXT("|") + Landscape->GetActorTransform().GetScale3D().ToString();
+
+	const UHoudiniRuntimeSettings* HoudiniRuntimeSettings = GetDefault<UHoudiniRuntimeSettings>();
+	if (HoudiniRuntimeSettings && HoudiniRuntimeSettings->MarshallingLandscapesUseDefaultUnrealScaling)
+		Layout += TEXT("|DefaultUnrealScaling");
+
+	// The attributes added by ApplyAttributesToHeightfieldNode
+	Layout += TEXT("|") + GetPathNameSafe(LandscapeProxy->GetLandscapeMaterial());
+	Layout += TEXT("|") + GetPathNameSafe(LandscapeProxy->GetLandscapeHoleMaterial());
+	Layout += TEXT("|") + GetPathNameSafe(LandscapeProxy->DefaultPhysMaterial);
+	Layout += TEXT("|") + LandscapeProxy->GetPathName();
+	Layout += TEXT("|") + GetPathNameSafe(LandscapeProxy->GetLevel());
+	for (const FName& Tag : LandscapeProxy->Tags)
+		Layout += TEXT("|") + Tag.ToString();
+
+	return Layout;
+}
+
+// Sets the object transform of a streamed heightfield, the landscape's scale is applied to the volumes instead.
+static void
+HoudiniSetStreamedHeightfieldTransform(ALandscapeProxy* LandscapeProxy, HAPI_NodeId HeightfieldNodeId, bool bSetObjectTransformToWorldTransform)
+{
+	// See CreateHeightfieldFromLandscape
+	FTransform LandscapeTransform = FHoudiniEngineRuntimeUtils::CalculateHoudiniLandscapeTransform(LandscapeProxy);
+	LandscapeTransform.SetScale3D(FVector::OneVector);
+
+	HAPI_TransformEuler HAPIObjectTransform;
+	FHoudiniApi::TransformEuler_Init(&HAPIObjectTransform);
+	if (bSetObjectTransformToWorldTransform)
+		FHoudiniEngineUtils::TranslateUnrealTransform(LandscapeTransform, HAPIObjectTransform);
+	else
+		FHoudiniEngineUtils::TranslateUnrealTransform(FTransform::Identity, HAPIObjectTransform);
+
+	HAPI_NodeId ParentObjNodeId = FHoudiniEngineUtils::HapiGetParentNodeId(HeightfieldNodeId);
+	FHoudiniApi::SetObjectTransform(FHoudiniEngine::Get().GetSession(), ParentObjNodeId, &HAPIObjectTransform);
+}
+
+// Converts a band of landscape values, in Unreal order, to float values in Houdini order (transposed).
+template<typename IntType>
+static void
+HoudiniConvertLandscapeBand(
+	const TArray<IntType>& IntValues,
+	int32 BandXSize,
+	int32 YSize,
+	const FHoudiniStreamedValueMapping& Mapping,
+	TArray<float>& OutFloatValues)
+{
+	for (int32 X = 0; X < BandXSize; X++)
+	{
+		for (int32 Y = 0; Y < YSize; Y++)
+		{
+			const double Value = ((double)IntValues[X + Y * BandXSize] - Mapping.IntOffset) * Mapping.Spacing + Mapping.Min;
+			OutFloatValues[Y + X * YSize] = (float)Value;
+		}
+	}
+}
+
+// Sets the volume info of a streamed volume, this allocates the volume in Houdini.
+static bool
+HoudiniSetStreamedVolumeInfo(FHoudiniStreamedVolume& Volume, const HAPI_VolumeInfo& VolumeInfo)
+{
+	// Cook the node to get proper infos on it
+	if (!FHoudiniEngineUtils::HapiCookNode(Volume.VolumeNodeId, nullptr, true))
+		return false;
+
+	HAPI_GeoInfo GeoInfo;
+	FHoudiniApi::GeoInfo_Init(&GeoInfo);
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetGeoInfo(
+		FHoudiniEngine::Get().GetSession(),
+		Volume.VolumeNodeId, &GeoInfo), false);
+
+	HAPI_PartInfo PartInfo;
+	FHoudiniApi::PartInfo_Init(&PartInfo);
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetPartInfo(
+		FHoudiniEngine::Get().GetSession(),
+		GeoInfo.nodeId, 0, &PartInfo), false);
+
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::SetVolumeInfo(
+		FHoudiniEngine::Get().GetSession(),
+		Volume.VolumeNodeId, PartInfo.id, &VolumeInfo), false);
+
+	Volume.GeoNodeId = GeoInfo.nodeId;
+	Volume.PartId = PartInfo.id;
+
+	return true;
+}
+
+// Reads the values of a volume one band at a time, and uploads the bands whose values changed since the last upload.
+// Memory use is bounded by the size of a band, not the size of the landscape.
+static bool
+HoudiniStreamLandscapeVolume(
+	ALandscapeProxy* LandscapeProxy,
+	const FHoudiniExtents& Extents,
+	int32 BandSize,
+	FHoudiniStreamedVolume& Volume,
+	int32& OutNumUploadedBands)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(HoudiniStreamLandscapeVolume);
+
+	ULandscapeInfo* LandscapeInfo = LandscapeProxy->GetLandscapeInfo();
+	ALandscape* Landscape = LandscapeProxy->GetLandscapeActor();
+	if (!IsValid(LandscapeInfo) || !IsValid(Landscape))
+		return false;
+
+	const int32 XSize = Extents.Max.X - Extents.Min.X + 1;
+	const int32 YSize = Extents.Max.Y - Extents.Min.Y + 1;
+	const int32 NumBands = FMath::DivideAndRoundUp(XSize, BandSize);
+
+	const bool bHeight = Volume.Source == EHoudiniStreamedVolumeSource::Height || Volume.Source == EHoudiniStreamedVolumeSource::EditLayerHeight;
+	const bool bWeight = Volume.Source == EHoudiniStreamedVolumeSource::TargetLayer || Volume.Source == EHoudiniStreamedVolumeSource::EditLayerTargetLayer;
+	const bool bEditLayer = Volume.Source == EHoudiniStreamedVolumeSource::EditLayerHeight || Volume.Source == EHoudiniStreamedVolumeSource::EditLayerTargetLayer;
+
+	ULandscapeLayerInfoObject* LayerInfo = bWeight ? LandscapeInfo->GetLayerInfoByName(Volume.TargetLayerName) : nullptr;
+
+	// Scope landscape access to the volume's edit layer
+	TOptional<FScopedSetLandscapeEditingLayer> EditLayerScope;
+	if (bEditLayer)
+		EditLayerScope.Emplace(Landscape, Volume.EditLayerGuid);
+
+	FLandscapeEditDataInterface LandscapeEdit(LandscapeInfo);
+	// Ensure we're not triggering a checkout, as we're just reading data
+	LandscapeEdit.SetShouldDirtyPackage(false);
+
+	TArray<uint16> HeightValues;
+	TArray<uint8> WeightValues;
+	auto ReadBand = [&](const FHoudiniExtents& Band, int32 NumPoints)
+	{
+		if (bHeight)
+		{
+			HeightValues.SetNumZeroed(NumPoints);
+			LandscapeEdit.GetHeightDataFast(Band.Min.X, Band.Min.Y, Band.Max.X, Band.Max.Y, HeightValues.GetData(), 0);
+		}
+		else if (bWeight)
+		{
+			WeightValues.SetNumZeroed(NumPoints);
+			LandscapeEdit.GetWeightDataFast(LayerInfo, Band.Min.X, Band.Min.Y, Band.Max.X, Band.Max.Y, WeightValues.GetData(), 0);
+		}
+	};
+
+	// See ConvertLandscapeDataToHeightFieldData and ConvertLandscapeLayerDataToHeightfieldData for the conversions.
+	FHoudiniStreamedValueMapping Mapping;
+	if (bHeight)
+	{
+		// Unreal's landscape uses 16bits precision and range from -256m to 256m with the default scale of 100.0
+		Mapping.IntOffset = 32767.0;
+		Mapping.Spacing = 512.0 / ((double)UINT16_MAX) * Landscape->GetActorTransform().GetScale3D().Z / 100.0;
+	}
+	else if (bWeight)
+	{
+		// Paint layer values are converted from [0 255] to [0 1]
+		Mapping.Spacing = 1.0 / (double)UINT8_MAX;
+
+		// If this layer came from Houdini, its debug color stores the original min and spacing of its values, but
+		// we need the min value of the whole layer to use it: find it with a first pass over the bands.
+		const FLinearColor LayerUsageDebugColor = LayerInfo ? LayerInfo->LayerUsageDebugColor : FLinearColor::White;
+		if (LayerUsageDebugColor.A == PI)
+		{
+			uint8 IntMin = UINT8_MAX;
+			for (int32 BandIndex = 0; BandIndex < NumBands; BandIndex++)
+			{
+				const FHoudiniExtents Band = HoudiniGetStreamedBand(Extents, BandSize, BandIndex);
+				ReadBand(Band, (Band.Max.X - Band.Min.X + 1) * YSize);
+				for (uint8 Value : WeightValues)
+					IntMin = FMath::Min(IntMin, Value);
+			}
+
+			Mapping.IntOffset = IntMin;
+			Mapping.Spacing = LayerUsageDebugColor.B;
+			Mapping.Min = LayerUsageDebugColor.R;
+		}
+	}
+
+	TArray<uint64> BandHashes;
+	BandHashes.SetNumZeroed(NumBands);
+
+	TArray<float> FloatValues;
+	for (int32 BandIndex = 0; BandIndex < NumBands; BandIndex++)
+	{
+		const FHoudiniExtents Band = HoudiniGetStreamedBand(Extents, BandSize, BandIndex);
+		const int32 BandXSize = Band.Max.X - Band.Min.X + 1;
+		const int32 NumPoints = BandXSize * YSize;
+
+		ReadBand(Band, NumPoints);
+
+		FloatValues.SetNumUninitialized(NumPoints);
+		if (bHeight)
+			HoudiniConvertLandscapeBand(HeightValues, BandXSize, YSize, Mapping, FloatValues);
+		else if (bWeight)
+			HoudiniConvertLandscapeBand(WeightValues, BandXSize, YSize, Mapping, FloatValues);
+		else
+			FMemory::Memzero(FloatValues.GetData(), NumPoints * sizeof(float));
+
+		// Skip the bands that are already in Houdini
+		BandHashes[BandIndex] = CityHash64(reinterpret_cast<const char*>(FloatValues.GetData()), NumPoints * sizeof(float));
+		if (Volume.BandHashes.Num() == NumBands && Volume.BandHashes[BandIndex] == BandHashes[BandIndex])
+			continue;
+
+		// The band's X values are rows of the transposed Houdini volume
+		const int32 Start = (Band.Min.X - Extents.Min.X) * YSize;
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiSetHeightFieldData(
+			Volume.GeoNodeId, Volume.PartId, FloatValues.GetData(), Start, NumPoints, Volume.VolumeName), false);
+
+		OutNumUploadedBands++;
+	}
+
+	Volume.BandHashes = MoveTemp(BandHashes);
+
+	return true;
+}
+
+// Creates the volume node of an edit layer's height, and the visualization / visibility nodes that are merged in the
+// heightfield instead of the volume node.
+static bool
+HoudiniCreateEditLayerHeightVolumeNode(
+	HAPI_NodeId HeightFieldId,
+	const FName& EditLayerName,
+	const FString& LayerVolumeName,
+	int32 XSize,
+	int32 YSize,
+	HAPI_NodeId& OutLayerNodeId,
+	HAPI_NodeId& OutVisibilityNodeId)
+{
+	HOUDINI_LANDSCAPE_MESSAGE(TEXT("[HoudiniCreateEditLayerHeightVolumeNode] Creating input node for editable landscape layer: %s"), *LayerVolumeName);
+
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CreateHeightfieldInputVolumeNode(
+		FHoudiniEngine::Get().GetSession(),
+		HeightFieldId,
+		&OutLayerNodeId,
+		TCHAR_TO_UTF8(*LayerVolumeName),
+		XSize, YSize,
+		1.f
+		), false);
+
+	// Create a volume visualization node
+	const FString VisualizationName = FString::Format(TEXT("visualization_{0}"), {EditLayerName.ToString()});
+	HAPI_NodeId VisualizationNodeId = -1;
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CreateNode(
+		FHoudiniEngine::Get().GetSession(),
+		HeightFieldId,
+		"volumevisualization",
+		TCHAR_TO_UTF8(*VisualizationName),
+		false,
+		&VisualizationNodeId
+		), false);
+
+	// Set Visualization Mode to Height Field
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::SetParmIntValue(
+		FHoudiniEngine::Get().GetSession(),
+		VisualizationNodeId,
+		"vismode",
+		0, 2
+		), false);
+	
+	// Set Density Field to '*'.
+	HAPI_ParmId DensityFieldParmId = -1;
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetParmIdFromName(
+		FHoudiniEngine::Get().GetSession(),
+		VisualizationNodeId,
+		"densityfield",
+		&DensityFieldParmId
+		), false);
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::SetParmStringValue(
+		FHoudiniEngine::Get().GetSession(),
+		VisualizationNodeId,
+		"*",
+		DensityFieldParmId, 0
+		), false);
+
+	// Create a visibility node
+	const FString VisibilityName = FString::Format(TEXT("visibility_{0}"), {EditLayerName.ToString()});
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CreateNode(
+		FHoudiniEngine::Get().GetSession(),
+		HeightFieldId,
+		"visibility",
+		TCHAR_TO_UTF8(*VisibilityName),
+		false,
+		&OutVisibilityNodeId
+		), false);
+
+	// Connect landscape layer to visualization
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::ConnectNodeInput(
+		FHoudiniEngine::Get().GetSession(),
+		VisualizationNodeId, 0, OutLayerNodeId, 0), false);
+
+	// Connect visualization to visibility
+	HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::ConnectNodeInput(
+		FHoudiniEngine::Get().GetSession(),
+		OutVisibilityNodeId, 0, VisualizationNodeId, 0), false);
+
+	return true;
+}
+
 
 bool 
 FUnrealLandscapeTranslator::CreateMeshOrPointsFromLandscape(
@@ -286,6 +781,10 @@ FUnrealLandscapeTranslator::CreateHeightfieldFromLandscape(
   	if (!LandscapeProxy)
 		return false;
 
+	// Read and upload the landscape per band of components instead, to bound memory use on large landscapes
+	if (CVarHoudiniEngineLandscapeInputStreaming.GetValueOnGameThread() > 0)
+		return CreateStreamedHeightfieldFromLandscape(LandscapeProxy, Options, CreatedHeightfieldNodeId, InputNodeNameStr, ParentNodeId, bSetObjectTransformToWorldTransform);
+
 	// Export the whole landscape and its layer as a single heightfield.
 	FString NodeName = InputNodeNameStr;
 
@@ -405,74 +904,9 @@ FUnrealLandscapeTranslator::CreateHeightfieldFromLandscape(
 			const FString LayerVolumeName = FString::Format(TEXT("landscapelayer_{0}"), {Layer.Name.ToString()});
 			
 			HAPI_NodeId LandscapeLayerNodeId = -1;
-			
-			HOUDINI_LANDSCAPE_MESSAGE(TEXT("[FUnrealLandscapeTranslator::CreateHeightfieldFromLandscape] Creating input node for editable landscape layer: %s"), *LayerVolumeName);
-
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CreateHeightfieldInputVolumeNode(
-				FHoudiniEngine::Get().GetSession(),
-				HeightFieldId,
-				&LandscapeLayerNodeId,
-				TCHAR_TO_UTF8(*LayerVolumeName),
-				XSize, YSize,
-				1.f
-				), false);
-
-			// Create a volume visualization node
-			const FString VisualizationName = FString::Format(TEXT("visualization_{0}"), {Layer.Name.ToString()});
-			HAPI_NodeId VisualizationNodeId = -1;
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CreateNode(
-				FHoudiniEngine::Get().GetSession(),
-				HeightFieldId,
-				"volumevisualization",
-				TCHAR_TO_UTF8(*VisualizationName),
-				false,
-				&VisualizationNodeId
-				), false);
-
-			// Set Visualization Mode to Height Field
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::SetParmIntValue(
-				FHoudiniEngine::Get().GetSession(),
-				VisualizationNodeId,
-				"vismode",
-				0, 2
-				), false);
-			
-			// Set Density Field to '*'.
-			HAPI_ParmId DensityFieldParmId = -1;
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::GetParmIdFromName(
-				FHoudiniEngine::Get().GetSession(),
-				VisualizationNodeId,
-				"densityfield",
-				&DensityFieldParmId
-				), false);
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::SetParmStringValue(
-				FHoudiniEngine::Get().GetSession(),
-				VisualizationNodeId,
-				"*",
-				DensityFieldParmId, 0
-				), false);
-
-			// Create a visibility node
-			const FString VisibilityName = FString::Format(TEXT("visibility_{0}"), {Layer.Name.ToString()});
 			HAPI_NodeId VisibilityNodeId = -1;
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CreateNode(
-				FHoudiniEngine::Get().GetSession(),
-				HeightFieldId,
-				"visibility",
-				TCHAR_TO_UTF8(*VisibilityName),
-				false,
-				&VisibilityNodeId
-				), false);
-
-			// Connect landscape layer to visualization
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::ConnectNodeInput(
-				FHoudiniEngine::Get().GetSession(),
-				VisualizationNodeId, 0, LandscapeLayerNodeId, 0), false);
-
-			// Connect visualization to visibility
-			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::ConnectNodeInput(
-				FHoudiniEngine::Get().GetSession(),
-				VisibilityNodeId, 0, VisualizationNodeId, 0), false);
+			if (!HoudiniCreateEditLayerHeightVolumeNode(HeightFieldId, Layer.Name, LayerVolumeName, XSize, YSize, LandscapeLayerNodeId, VisibilityNodeId))
+				return false;
 
 			// Connect the visibility node to the merge input
 			HOUDINI_CHECK_ERROR_RETURN(MergeInputFn(MergeId, VisibilityNodeId), false);
@@ -529,6 +963,197 @@ FUnrealLandscapeTranslator::CreateHeightfieldFromLandscape(
 	return true;
 }
 
+bool
+FUnrealLandscapeTranslator::CreateStreamedHeightfieldFromLandscape(
+	ALandscapeProxy* LandscapeProxy,
+	const FHoudiniLandscapeExportOptions& Options,
+	HAPI_NodeId& CreatedHeightfieldNodeId,
+	const FString& InputNodeNameStr,
+	HAPI_NodeId ParentNodeId,
+	const bool bSetObjectTransformToWorldTransform)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FUnrealLandscapeTranslator::CreateStreamedHeightfieldFromLandscape);
+
+	if (!LandscapeProxy)
+		return false;
+
+	ALandscape* Landscape = LandscapeProxy->GetLandscapeActor();
+	if (!IsValid(Landscape) || !IsValid(LandscapeProxy->GetLandscapeInfo()))
+		return false;
+
+	FHoudiniStreamedHeightfield Streamed;
+	Streamed.Extents = FHoudiniLandscapeUtils::GetLandscapeExtents(LandscapeProxy);
+
+	const int32 XSize = Streamed.Extents.Max.X - Streamed.Extents.Min.X + 1;
+	const int32 YSize = Streamed.Extents.Max.Y - Streamed.Extents.Min.Y + 1;
+	if ((XSize < 2) || (YSize < 2))
+		return false;
+
+	Streamed.BandSize = HoudiniGetStreamedBandSize(LandscapeProxy);
+	Streamed.Volumes = HoudiniGetStreamedVolumes(LandscapeProxy, Options);
+	Streamed.Layout = HoudiniGetStreamedHeightfieldLayout(LandscapeProxy, Streamed.Extents, Streamed.BandSize, Streamed.Volumes);
+
+	// All the volumes share the height volume's info
+	HAPI_VolumeInfo HeightfieldVolumeInfo;
+	FHoudiniApi::VolumeInfo_Init(&HeightfieldVolumeInfo);
+	InitHeightfieldVolumeInfo(XSize, YSize, Landscape->GetActorTransform().GetScale3D(), HeightfieldVolumeInfo);
+
+	//--------------------------------------------------------------------------------------------------
+	// Create the Heightfield Input Node
+	//-------------------------------------------------------------------------------------------------- 
+	HAPI_NodeId HeightFieldId = -1;
+	HAPI_NodeId HeightId = -1;
+	HAPI_NodeId MaskId = -1;
+	HAPI_NodeId MergeId = -1;
+	if (!CreateHeightfieldInputNode(InputNodeNameStr, XSize, YSize, HeightFieldId, HeightId, MaskId, MergeId, ParentNodeId))
+		return false;
+
+	//--------------------------------------------------------------------------------------------------
+	// Create and stream each volume
+	//--------------------------------------------------------------------------------------------------
+	int32 MergeInputIndex = 2;
+	for (FHoudiniStreamedVolume& Volume : Streamed.Volumes)
+	{
+		// The height and mask volumes are created with the heightfield, the other volumes are merged in it
+		if (Volume.Source == EHoudiniStreamedVolumeSource::Height)
+		{
+			Volume.VolumeNodeId = HeightId;
+		}
+		else if (Volume.VolumeName.Equals(TEXT("mask"), ESearchCase::IgnoreCase))
+		{
+			Volume.VolumeNodeId = MaskId;
+		}
+		else if (Volume.Source == EHoudiniStreamedVolumeSource::EditLayerHeight)
+		{
+			HAPI_NodeId VisibilityNodeId = -1;
+			if (!HoudiniCreateEditLayerHeightVolumeNode(HeightFieldId, Volume.EditLayerName, Volume.VolumeName, XSize, YSize, Volume.VolumeNodeId, VisibilityNodeId))
+				return false;
+
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::ConnectNodeInput(FHoudiniEngine::Get().GetSession(), MergeId, MergeInputIndex, VisibilityNodeId, 0), false);
+			MergeInputIndex++;
+		}
+		else
+		{
+			std::string VolumeNameString;
+			FHoudiniEngineUtils::ConvertUnrealString(Volume.VolumeName, VolumeNameString);
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CreateHeightfieldInputVolumeNode(
+				FHoudiniEngine::Get().GetSession(), HeightFieldId, &Volume.VolumeNodeId, VolumeNameString.c_str(), YSize, XSize, 1.0f), false);
+
+			HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::ConnectNodeInput(FHoudiniEngine::Get().GetSession(), MergeId, MergeInputIndex, Volume.VolumeNodeId, 0), false);
+			MergeInputIndex++;
+		}
+
+		if (!HoudiniSetStreamedVolumeInfo(Volume, HeightfieldVolumeInfo))
+			return false;
+
+		int32 NumUploadedBands = 0;
+		if (!HoudiniStreamLandscapeVolume(LandscapeProxy, Streamed.Extents, Streamed.BandSize, Volume, NumUploadedBands))
+			return false;
+
+		// Apply attributes to the heightfield input node
+		ApplyAttributesToHeightfieldNode(Volume.VolumeNodeId, Volume.PartId, LandscapeProxy);
+
+		// Commit the volume's geo
+		HOUDINI_CHECK_ERROR_RETURN(FHoudiniEngineUtils::HapiCommitGeo(Volume.VolumeNodeId), false);
+
+		// Add Data Layers and HLODS after the height volume
+		if (Volume.Source == EHoudiniStreamedVolumeSource::Height && ParentNodeId != -1)
+		{
+			Streamed.HLODNodeId = FHoudiniHLODLayerUtils::AddHLODAttributes(LandscapeProxy, ParentNodeId, HeightFieldId);
+			Streamed.DataLayerNodeId = FHoudiniDataLayerUtils::AddGroupsFromDataLayers(LandscapeProxy, ParentNodeId, Streamed.HLODNodeId);
+		}
+	}
+
+	Streamed.bSetObjectTransformToWorldTransform = bSetObjectTransformToWorldTransform;
+	HoudiniSetStreamedHeightfieldTransform(LandscapeProxy, HeightFieldId, bSetObjectTransformToWorldTransform);
+
+	// Finally, cook the Height field node
+	if (!FHoudiniEngineUtils::HapiCookNode(HeightFieldId, nullptr, true))
+		return false;
+
+	CreatedHeightfieldNodeId = HeightFieldId;
+
+	// Keep the uploaded bands so the heightfield can be updated in place
+	HoudiniStreamedHeightfields.Add(HeightFieldId, MoveTemp(Streamed));
+
+	return true;
+}
+
+bool
+FUnrealLandscapeTranslator::UpdateStreamedHeightfieldFromLandscape(
+	ALandscapeProxy* LandscapeProxy,
+	const FHoudiniLandscapeExportOptions& Options,
+	HAPI_NodeId HeightfieldNodeId)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FUnrealLandscapeTranslator::UpdateStreamedHeightfieldFromLandscape);
+
+	if (CVarHoudiniEngineLandscapeInputStreaming.GetValueOnGameThread() <= 0)
+		return false;
+
+	FHoudiniStreamedHeightfield* Streamed = HoudiniStreamedHeightfields.Find(HeightfieldNodeId);
+	if (!Streamed || !LandscapeProxy || !IsValid(LandscapeProxy->GetLandscapeActor()) || !IsValid(LandscapeProxy->GetLandscapeInfo()))
+		return false;
+
+	// The nodes can only be reused if the heightfield still has the same extents, volumes and attributes
+	const FHoudiniExtents Extents = FHoudiniLandscapeUtils::GetLandscapeExtents(LandscapeProxy);
+	const TArray<FHoudiniStreamedVolume> Volumes = HoudiniGetStreamedVolumes(LandscapeProxy, Options);
+	const FString Layout = HoudiniGetStreamedHeightfieldLayout(LandscapeProxy, Extents, HoudiniGetStreamedBandSize(LandscapeProxy), Volumes);
+
+	bool bCanReuseNodes = Layout == Streamed->Layout && FHoudiniEngineUtils::IsHoudiniNodeValid(HeightfieldNodeId);
+	for (int32 VolumeIndex = 0; bCanReuseNodes && VolumeIndex < Streamed->Volumes.Num(); VolumeIndex++)
+		bCanReuseNodes = FHoudiniEngineUtils::IsHoudiniNodeValid(Streamed->Volumes[VolumeIndex].VolumeNodeId);
+
+	if (!bCanReuseNodes)
+	{
+		HoudiniStreamedHeightfields.Remove(HeightfieldNodeId);
+		return false;
+	}
+
+	int32 NumUploadedBands = 0;
+	for (FHoudiniStreamedVolume& Volume : Streamed->Volumes)
+	{
+		int32 NumVolumeUploadedBands = 0;
+		bool bSuccess = HoudiniStreamLandscapeVolume(LandscapeProxy, Streamed->Extents, Streamed->BandSize, Volume, NumVolumeUploadedBands);
+		if (bSuccess && NumVolumeUploadedBands > 0)
+			bSuccess = FHoudiniEngineUtils::HapiCommitGeo(Volume.VolumeNodeId) == HAPI_RESULT_SUCCESS;
+
+		if (!bSuccess)
+		{
+			// The volume may have been partially updated, recreate the heightfield
+			HoudiniStreamedHeightfields.Remove(HeightfieldNodeId);
+			return false;
+		}
+
+		NumUploadedBands += NumVolumeUploadedBands;
+	}
+
+	// The landscape may have been moved or rotated, which doesn't change its layout
+	HoudiniSetStreamedHeightfieldTransform(LandscapeProxy, HeightfieldNodeId, Streamed->bSetObjectTransformToWorldTransform);
+
+	// The actor may have been moved to other HLOD or data layers
+	if (Streamed->HLODNodeId >= 0)
+		FHoudiniHLODLayerUtils::SetVexCode(Streamed->HLODNodeId, LandscapeProxy);
+	if (Streamed->DataLayerNodeId >= 0)
+		FHoudiniDataLayerUtils::SetVexCode(Streamed->DataLayerNodeId, LandscapeProxy);
+
+	HOUDINI_LANDSCAPE_MESSAGE(TEXT("[FUnrealLandscapeTranslator::UpdateStreamedHeightfieldFromLandscape] Uploaded %d changed bands of %s"),
+		NumUploadedBands, *LandscapeProxy->GetName());
+
+	return FHoudiniEngineUtils::HapiCookNode(HeightfieldNodeId, nullptr, true);
+}
+
+void
+FUnrealLandscapeTranslator::RemoveStreamedHeightfield(HAPI_NodeId HeightfieldNodeId)
+{
+	HoudiniStreamedHeightfields.Remove(HeightfieldNodeId);
+}
+
+void
+FUnrealLandscapeTranslator::ResetStreamedHeightfields()
+{
+	HoudiniStreamedHeightfields.Empty();
+}
+
 bool 
 FUnrealLandscapeTranslator::CreateHeightfieldFromLandscapeComponentArray(
 	ALandscapeProxy* LandscapeProxy,
@@ -817,6 +1442,11 @@ FUnrealLandscapeTranslator::CreateInputNodeForLandscapeObject(
 	bool bExportSelectionOnly = InputSettings.bLandscapeExportSelectionOnly;
 	bool bLandscapeAutoSelectComponent = InputSettings.bLandscapeAutoSelectComponent;
 
+	FHoudiniLandscapeExportOptions HeightfieldOptions;
+	HeightfieldOptions.bExportHeightDataPerEditLayer = InInput->IsEditLayerHeightExportEnabled();
+	HeightfieldOptions.bExportMergedPaintLayers = InInput->IsMergedPaintLayerExportEnabled();
+	HeightfieldOptions.bExportPaintLayersPerEditLayer = InInput->IsPaintLayerPerEditLayerExportEnabled();
+
 	// Get selected components if bLandscapeExportSelectionOnly or bLandscapeAutoSelectComponent is true
 	TSet<TObjectPtr<ULandscapeComponent>> SelectedComponents;
 	if (bExportSelectionOnly)
@@ -866,6 +1496,20 @@ FUnrealLandscapeTranslator::CreateInputNodeForLandscapeObject(
 			InputNodeId = -1;
 		}
 
+		// A streamed heightfield can be updated in place, only uploading the parts of the landscape that changed
+		if (ExportType == EHoudiniLandscapeExportType::Heightfield && InputNodeId >= 0
+			&& (!bExportSelectionOnly || SelectedComponents.Num() == InLandscape->LandscapeComponents.Num()))
+		{
+			if (FUnrealLandscapeTranslator::UpdateStreamedHeightfieldFromLandscape(InLandscape, HeightfieldOptions, InputNodeId))
+			{
+				HAPI_NodeId InputObjectNodeId = FHoudiniEngineUtils::HapiGetParentNodeId(InputNodeId);
+				if (FUnrealObjectInputUtils::AddNodeOrUpdateNode(Identifier, InputNodeId, Handle, InputObjectNodeId, nullptr, bInputNodesCanBeDeleted))
+					OutHandle = Handle;
+
+				return true;
+			}
+		}
+
 		HAPI_NodeId GeoObjNodeId = -1;
 
 		HOUDINI_CHECK_ERROR_RETURN(FHoudiniApi::CreateNode(
@@ -879,6 +1523,8 @@ FUnrealLandscapeTranslator::CreateInputNodeForLandscapeObject(
 			// Get the parent OBJ node ID before deleting!
 			HAPI_NodeId PreviousInputOBJNode = FHoudiniEngineUtils::HapiGetParentNodeId(InputNodeId);
 
+			FUnrealLandscapeTranslator::RemoveStreamedHeightfield(InputNodeId);
+
 			if (HAPI_RESULT_SUCCESS != FHoudiniApi::DeleteNode(
 				FHoudiniEngine::Get().GetSession(), InputNodeId))
 			{
@@ -925,18 +1571,13 @@ FUnrealLandscapeTranslator::CreateInputNodeForLandscapeObject(
 		// Ensure we destroy any (Houdini) input nodes before clobbering this object with a new heightfield.
 		//DestroyInputNodes(InInput, InInput->GetInputType());
 
-		FHoudiniLandscapeExportOptions Options;
-		Options.bExportHeightDataPerEditLayer = InInput->IsEditLayerHeightExportEnabled();
-		Options.bExportMergedPaintLayers = InInput->IsMergedPaintLayerExportEnabled();
-		Options.bExportPaintLayersPerEditLayer = InInput->IsPaintLayerPerEditLayerExportEnabled();
-
 		int32 NumComponents = InLandscape->LandscapeComponents.Num();
 		if(!bExportSelectionOnly || (SelectedComponents.Num() == NumComponents))
 		{
 			// Export the whole landscape and its layer as a single heightfield node
 			bSuccess = FUnrealLandscapeTranslator::CreateHeightfieldFromLandscape(
 				InLandscape,
-				Options,
+				HeightfieldOptions,
 				InputNodeId,
 				FinalInputNodeName,
 				ParentNodeId,
@@ -950,7 +1591,7 @@ FUnrealLandscapeTranslator::CreateInputNodeForLandscapeObject(
 			bSuccess = FUnrealLandscapeTranslator::CreateHeightfieldFromLandscapeComponentArray(
 				InLandscape,
 				SelectedLandscapeComponents,
-				Options,
+				HeightfieldOptions,
 				InputNodeId,
 				FinalInputNodeName,
 				ParentNodeId,
@@ -1241,13 +1882,6 @@ FUnrealLandscapeTranslator::ConvertLandscapeDataToHeightFieldData(
 	if (IntHeightData.Num() != SizeInPoints)
 		return false;
 
-	// Use default unreal scaling for marshalling landscapes
-	// A lot of precision will be lost in order to keep the same transform as the landscape input
-	bool bUseDefaultUE4Scaling = false;
-	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
-	if (HoudiniRuntimeSettings && HoudiniRuntimeSettings->MarshallingLandscapesUseDefaultUnrealScaling)
-		bUseDefaultUE4Scaling = HoudiniRuntimeSettings->MarshallingLandscapesUseDefaultUnrealScaling;
-
 	//--------------------------------------------------------------------------------------------------
 	// Convert values to float
 	//--------------------------------------------------------------------------------------------------
@@ -1286,6 +1920,28 @@ FUnrealLandscapeTranslator::ConvertLandscapeDataToHeightFieldData(
 		}
 	}
 
+	InitHeightfieldVolumeInfo(XSize, YSize, LandscapeActorScale, HeightfieldVolumeInfo);
+
+	return true;
+}
+
+void
+FUnrealLandscapeTranslator::InitHeightfieldVolumeInfo(
+	int32 XSize,
+	int32 YSize,
+	const FVector3d& LandscapeActorScale,
+	HAPI_VolumeInfo& HeightfieldVolumeInfo)
+{
+	int32 HoudiniXSize = YSize;
+	int32 HoudiniYSize = XSize;
+
+	// Use default unreal scaling for marshalling landscapes
+	// A lot of precision will be lost in order to keep the same transform as the landscape input
+	bool bUseDefaultUE4Scaling = false;
+	const UHoudiniRuntimeSettings * HoudiniRuntimeSettings = GetDefault< UHoudiniRuntimeSettings >();
+	if (HoudiniRuntimeSettings && HoudiniRuntimeSettings->MarshallingLandscapesUseDefaultUnrealScaling)
+		bUseDefaultUE4Scaling = HoudiniRuntimeSettings->MarshallingLandscapesUseDefaultUnrealScaling;
+
 	//--------------------------------------------------------------------------------------------------
 	// Set the Hapi Transform. Houdini expects the scale to be set here, but we set the position
 	// and rotation on the Geometry nodes, so clear here.
@@ -1333,8 +1989,6 @@ FUnrealLandscapeTranslator::ConvertLandscapeDataToHeightFieldData(
 	HeightfieldVolumeInfo.hasTaper = false;
 	HeightfieldVolumeInfo.xTaper = 0.0;
 	HeightfieldVolumeInfo.yTaper = 0.0;
-
-	return true;
 }
 
 bool
@@ -56,6 +56,30 @@ struct HOUDINIENGINE_API FUnrealLandscapeTranslator
 			HAPI_NodeId ParentNodeId,
 			bool bSetObjectTransformToWorldTransform);
 
+		// Same as CreateHeightfieldFromLandscape, but reads and uploads each volume one band of landscape components
+		// at a time, so memory use is bounded by the band size instead of the landscape size.
+		static bool CreateStreamedHeightfieldFromLandscape(
+			ALandscapeProxy* LandscapeProxy,
+			const FHoudiniLandscapeExportOptions& Options,
+			HAPI_NodeId& CreatedHeightfieldNodeId,
+			const FString& InputNodeNameStr,
+			HAPI_NodeId ParentNodeId,
+			bool bSetObjectTransformToWorldTransform);
+
+		// Streams the landscape again into a heightfield created by CreateStreamedHeightfieldFromLandscape, only
+		// uploading the bands whose values changed. Returns false if the heightfield can't be reused (different
+		// extents, layers or attributes), in which case it has to be recreated.
+		static bool UpdateStreamedHeightfieldFromLandscape(
+			ALandscapeProxy* LandscapeProxy,
+			const FHoudiniLandscapeExportOptions& Options,
+			HAPI_NodeId HeightfieldNodeId);
+
+		// Forgets the uploaded bands of a streamed heightfield, when its node is deleted.
+		static void RemoveStreamedHeightfield(HAPI_NodeId HeightfieldNodeId);
+
+		// Forgets all the streamed heightfields, when the session is stopped or restarted. Game thread only.
+		static void ResetStreamedHeightfields();
+
 		static bool CreateHeightfieldFromLandscapeComponentArray(
 			ALandscapeProxy* LandscapeProxy,
 			const TSet< ULandscapeComponent * > & SelectedComponents,
@@ -138,6 +162,13 @@ struct HOUDINIENGINE_API FUnrealLandscapeTranslator
 			TArray<float>& HeightfieldFloatValues,
 			HAPI_VolumeInfo& HeightfieldVolumeInfo);
 
+		// Fills the volume info of a heightfield of XSize x YSize landscape points
+		static void InitHeightfieldVolumeInfo(
+			int32 XSize,
+			int32 YSize,
+			const FVector3d& LandscapeActorScale,
+			HAPI_VolumeInfo& HeightfieldVolumeInfo);
+
 		// Converts Unreal uint8 values to Houdini Float
 		static bool ConvertLandscapeLayerDataToHeightfieldData(
 			const TArray<uint8>& IntHeightData,
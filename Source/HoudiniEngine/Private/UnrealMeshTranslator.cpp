@@ -26,6 +26,8 @@
 
 #include "UnrealMeshTranslator.h"
 
+#include "HAPI/HAPI_Version.h"
+
 #include "HoudiniDataLayerUtils.h"
 #include "HoudiniEngine.h"
 #include "HoudiniEnginePrivatePCH.h"
@@ -41,12 +43,16 @@
 #include "DynamicMeshBuilder.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/StaticMeshSocket.h"
+#include "HAL/FileManager.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialInterface.h"
 #include "MeshAttributes.h"
 #include "MeshDescription.h"
 #include "MeshDescriptionOperations.h"
 #include "MeshUtilities.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "RawMesh.h"
@@ -79,6 +85,81 @@ static TAutoConsoleVariable<int32> CVarHoudiniEngineStaticMeshExportMethod(
 	TEXT("2: Render Mesh / LODResources\n")
 );
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineInputGeometryCache(
+	TEXT("HoudiniEngine.InputGeometryCache"),
+	0,
+	TEXT("When enabled, the geometry extracted from Static Mesh assets is stored on disk, keyed by the mesh content and export options.\n")
+	TEXT("Rebuilding the input node for the same mesh (after a session restart, a level reload, or from another HDA) then loads it from the cache instead of extracting it again.\n")
+	TEXT("0: Disabled (default)\n")
+	TEXT("1: Enabled\n")
+);
+
+static TAutoConsoleVariable<int32> CVarHoudiniEngineInputGeometryCacheMaxSizeMB(
+	TEXT("HoudiniEngine.InputGeometryCache.MaxSizeMB"),
+	2048,
+	TEXT("Maximum size of the input geometry cache on disk, in MB. The least recently used files are deleted when it is exceeded.\n")
+);
+
+static FAutoConsoleCommand CCmdHoudiniEngineClearInputGeometryCache(
+	TEXT("HoudiniEngine.ClearInputGeometryCache"),
+	TEXT("Deletes all the files from the Static Mesh input geometry cache."),
+	FConsoleCommandDelegate::CreateStatic(&FUnrealMeshTranslator::ClearStaticMeshInputCache));
+
+// Bump this when changes to the mesh export should invalidate the cached geometry
+static const TCHAR* HoudiniInputGeometryCacheVersion = TEXT("1");
+
+static FString
+GetInputGeometryCacheDirectory()
+{
+	return FPaths::ConvertRelativePathToFull(FPaths::ProjectIntermediateDir() / TEXT("HoudiniEngine") / TEXT("InputGeometryCache"));
+}
+
+static FString
+GetInputGeometryCacheFile(const FString& InCacheKey)
+{
+	return GetInputGeometryCacheDirectory() / InCacheKey + TEXT(".bgeo.sc");
+}
+
+// Deletes the least recently used files until the cache fits in its maximum size
+static void
+TrimInputGeometryCache()
+{
+	const int64 MaxSize = (int64)FMath::Max(CVarHoudiniEngineInputGeometryCacheMaxSizeMB.GetValueOnAnyThread(), 0) * 1024 * 1024;
+
+	struct FCacheFile
+	{
+		FString Path;
+		FDateTime AccessTime;
+		int64 Size;
+	};
+
+	TArray<FCacheFile> Files;
+	int64 TotalSize = 0;
+	IFileManager::Get().IterateDirectoryStat(*GetInputGeometryCacheDirectory(),
+		[&Files, &TotalSize](const TCHAR* Path, const FFileStatData& StatData)
+		{
+			if (!StatData.bIsDirectory)
+			{
+				Files.Add({ FString(Path), FMath::Max(StatData.AccessTime, StatData.ModificationTime), StatData.FileSize });
+				TotalSize += StatData.FileSize;
+			}
+			return true;
+		});
+
+	if (TotalSize <= MaxSize)
+		return;
+
+	Files.Sort([](const FCacheFile& A, const FCacheFile& B) { return A.AccessTime < B.AccessTime; });
+	for (const FCacheFile& File : Files)
+	{
+		if (TotalSize <= MaxSize)
+			break;
+
+		if (IFileManager::Get().Delete(*File.Path, false, true, true))
+			TotalSize -= File.Size;
+	}
+}
+
 
 bool
 FUnrealMeshTranslator::HapiCreateInputNodeForStaticMesh(
@@ -349,6 +430,26 @@ FUnrealMeshTranslator::HapiCreateInputNodeForStaticMesh(
 	uint8 ExportMethod = 1; // Mesh description
 	ExportMethod = (uint8)CVarHoudiniEngineStaticMeshExportMethod.GetValueOnAnyThread();
 
+	// Only the geometry of single node static mesh assets is cached: components add per-instance data
+	// (override colors, tags, attribute data components...) and material parameters can change without the mesh.
+	FString InputCacheKey;
+	const bool bUseInputCache = !UseMergeNode && !StaticMeshComponent && !bExportMaterialParameters
+		&& CVarHoudiniEngineInputGeometryCache.GetValueOnAnyThread() > 0
+		&& FUnrealMeshTranslator::GetStaticMeshInputCacheKey(
+			StaticMesh, ExportMethod, ExportMainMesh, ExportAllLODs, bPreferNaniteFallbackMesh, InputCacheKey);
+
+	if (bUseInputCache && FUnrealMeshTranslator::LoadStaticMeshInputFromCache(NewNodeId, InputCacheKey))
+	{
+		FUnrealObjectInputHandle Handle;
+		if (FUnrealObjectInputUtils::AddNodeOrUpdateNode(Identifier, InputNodeId, Handle, InputObjectNodeId, nullptr, bInputNodesCanBeDeleted))
+			OutHandle = Handle;
+
+		return true;
+	}
+
+	// Set to true when the mesh geometry was exported successfully
+	bool bMeshExported = false;
+
 	// Next Index used to connect nodes to the merge
 	int32 NextMergeIndex = 0;
 
@@ -390,6 +491,7 @@ FUnrealMeshTranslator::HapiCreateInputNodeForStaticMesh(
 			StaticMeshComponent);
 
 		HOUDINI_LOG_MESSAGE(TEXT("FUnrealMeshTranslator::CreateInputNodeForMeshDescription HiRes mesh completed in %.4f seconds"), FPlatformTime::Seconds() - StartTime);
+		bMeshExported |= bHiResMeshSuccess;
 
 		if (UseMergeNode)
 		{
@@ -552,6 +654,8 @@ FUnrealMeshTranslator::HapiCreateInputNodeForStaticMesh(
 			if (!bMeshSuccess)
 				continue;
 
+			bMeshExported = true;
+
 			if (UseMergeNode)
 			{
 				// Connect the LOD node to the merge node.
@@ -745,6 +849,9 @@ FUnrealMeshTranslator::HapiCreateInputNodeForStaticMesh(
 		}
 	}
 
+	if (bUseInputCache && bMeshExported)
+		FUnrealMeshTranslator::SaveStaticMeshInputToCache(NewNodeId, InputCacheKey);
+
 	{
 		FUnrealObjectInputHandle Handle;
 		if (FUnrealObjectInputUtils::AddNodeOrUpdateNode(Identifier, InputNodeId, Handle, InputObjectNodeId, nullptr, bInputNodesCanBeDeleted))
@@ -755,6 +862,123 @@ FUnrealMeshTranslator::HapiCreateInputNodeForStaticMesh(
 	return true;
 }
 
+bool
+FUnrealMeshTranslator::GetStaticMeshInputCacheKey(
+	UStaticMesh const* StaticMesh,
+	const uint8& ExportMethod,
+	const bool& bExportMainMesh,
+	const bool& bExportAllLODs,
+	const bool& bPreferNaniteFallbackMesh,
+	FString& OutCacheKey)
+{
+	OutCacheKey.Empty();
+
+#if WITH_EDITORONLY_DATA
+	if (!IsValid(StaticMesh) || !StaticMesh->GetRenderData())
+		return false;
+
+	// The DDC key covers the source mesh descriptions (including the Nanite HiRes one) and their build settings
+	const FString& DerivedDataKey = StaticMesh->GetRenderData()->DerivedDataKey;
+	if (DerivedDataKey.IsEmpty())
+		return false;
+
+	FString KeyString = FString::Printf(TEXT("%s|%d.%d.%d|%s|%s|%d|%d|%d|%d|%d"),
+		HoudiniInputGeometryCacheVersion,
+		HAPI_VERSION_HOUDINI_MAJOR, HAPI_VERSION_HOUDINI_MINOR, HAPI_VERSION_HOUDINI_BUILD,
+		*StaticMesh->GetPathName(),
+		*DerivedDataKey,
+		ExportMethod,
+		bExportMainMesh,
+		bExportAllLODs,
+		bPreferNaniteFallbackMesh,
+		StaticMesh->GetLightMapResolution());
+
+	// Materials are not part of the DDC key, but are exported as attributes
+	for (const FStaticMaterial& StaticMaterial : StaticMesh->GetStaticMaterials())
+	{
+		KeyString += TEXT("|") + StaticMaterial.MaterialSlotName.ToString();
+		KeyString += TEXT("|") + (StaticMaterial.MaterialInterface ? StaticMaterial.MaterialInterface->GetPathName() : FString());
+	}
+
+	if (UBodySetup const* BodySetup = StaticMesh->GetBodySetup())
+	{
+		KeyString += TEXT("|") + (BodySetup->PhysMaterial ? BodySetup->PhysMaterial->GetPathName() : FString());
+	}
+
+	OutCacheKey = FSHA1::HashBuffer(*KeyString, KeyString.Len() * sizeof(TCHAR)).ToString();
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool
+FUnrealMeshTranslator::LoadStaticMeshInputFromCache(const HAPI_NodeId& InNodeId, const FString& InCacheKey)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FUnrealMeshTranslator::LoadStaticMeshInputFromCache);
+
+	const FString CacheFile = GetInputGeometryCacheFile(InCacheKey);
+	TArray<uint8> Buffer;
+	if (!IFileManager::Get().FileExists(*CacheFile) || !FFileHelper::LoadFileToArray(Buffer, *CacheFile))
+		return false;
+
+	if (Buffer.Num() <= 0)
+		return false;
+
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::LoadGeoFromMemory(
+		FHoudiniEngine::Get().GetSession(), InNodeId, ".bgeo.sc", (const char*)Buffer.GetData(), Buffer.Num()))
+	{
+		HOUDINI_LOG_WARNING(TEXT("Failed to load cached input geometry %s: %s"), *CacheFile, *FHoudiniEngineUtils::GetErrorDescription());
+		return false;
+	}
+
+	// Update the access time so the least recently used files are trimmed first
+	IFileManager::Get().SetTimeStamp(*CacheFile, FDateTime::UtcNow());
+
+	HOUDINI_LOG_MESSAGE(TEXT("Loaded cached input geometry %s"), *CacheFile);
+	return true;
+}
+
+bool
+FUnrealMeshTranslator::SaveStaticMeshInputToCache(const HAPI_NodeId& InNodeId, const FString& InCacheKey)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FUnrealMeshTranslator::SaveStaticMeshInputToCache);
+
+	int32 GeoSize = 0;
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::GetGeoSize(
+		FHoudiniEngine::Get().GetSession(), InNodeId, ".bgeo.sc", &GeoSize) || GeoSize <= 0)
+		return false;
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(GeoSize);
+	if (HAPI_RESULT_SUCCESS != FHoudiniApi::SaveGeoToMemory(
+		FHoudiniEngine::Get().GetSession(), InNodeId, (char*)Buffer.GetData(), GeoSize))
+		return false;
+
+	// Write to a temporary file first so a partially written file is never loaded
+	const FString CacheFile = GetInputGeometryCacheFile(InCacheKey);
+	const FString TempFile = CacheFile + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Buffer, *TempFile))
+		return false;
+
+	if (!IFileManager::Get().Move(*CacheFile, *TempFile, true, true))
+	{
+		IFileManager::Get().Delete(*TempFile, false, true, true);
+		return false;
+	}
+
+	TrimInputGeometryCache();
+	return true;
+}
+
+void
+FUnrealMeshTranslator::ClearStaticMeshInputCache()
+{
+	const FString CacheDirectory = GetInputGeometryCacheDirectory();
+	if (IFileManager::Get().DeleteDirectory(*CacheDirectory, false, true))
+		HOUDINI_LOG_MESSAGE(TEXT("Deleted the input geometry cache in %s"), *CacheDirectory);
+}
+
 bool
 FUnrealMeshTranslator::CreateInputNodeForMeshSockets(
 	const TArray<UStaticMeshSocket*>& InMeshSocket, const HAPI_NodeId& InParentNodeId, HAPI_NodeId& OutSocketsNodeId)
@@ -70,6 +70,26 @@ struct HOUDINIENGINE_API FUnrealMeshTranslator
 			const bool& bExportMaterialParameters,
 			const bool& bForceReferenceInputNodeCreation);
 
+		// Input geometry cache: stores the geometry extracted from static mesh assets on disk,
+		// so the same mesh can be reloaded with a single HAPI call instead of being extracted again.
+		// Builds the content key for a static mesh, returns false if the mesh/options cannot be cached.
+		static bool GetStaticMeshInputCacheKey(
+			UStaticMesh const* StaticMesh,
+			const uint8& ExportMethod,
+			const bool& bExportMainMesh,
+			const bool& bExportAllLODs,
+			const bool& bPreferNaniteFallbackMesh,
+			FString& OutCacheKey);
+
+		// Loads the cached geometry for a key on an input node, returns false on cache miss
+		static bool LoadStaticMeshInputFromCache(const HAPI_NodeId& InNodeId, const FString& InCacheKey);
+
+		// Saves an input node's geometry to the cache
+		static bool SaveStaticMeshInputToCache(const HAPI_NodeId& InNodeId, const FString& InCacheKey);
+
+		// Deletes all the cached input geometry
+		static void ClearStaticMeshInputCache();
+
 		// Convert the Mesh using FStaticMeshLODResources
 		static bool CreateInputNodeForStaticMeshLODResources(
 			const HAPI_NodeId& NodeId,
@@ -50,6 +50,10 @@
 #endif
 #include "SkeletalMeshAttributes.h"
 #include "Rendering/SkeletalMeshModel.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/ObjectKey.h"
 
 
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2
@@ -57,34 +61,152 @@
 #endif
 
 
-FTransform
-GetCompSpaceTransformForBone(const FReferenceSkeleton& InSkel, const int32& InBoneIdx)
+// The skeleton attributes sent with each skeletal mesh, ready to be uploaded.
+struct FHoudiniReferenceSkeletonData
 {
-    FTransform resultBoneTransform = InSkel.GetRefBonePose()[InBoneIdx];
+	// capt_names and boneCapture_pCaptPath
+	TArray<FString> CaptNames;
 
-    auto refBoneInfo = InSkel.GetRefBoneInfo();
+	// capt_parents
+	TArray<int32> CaptParents;
 
-    int32 Bone = InBoneIdx;
-    while (Bone)
-    {
-        resultBoneTransform *= InSkel.GetRefBonePose()[refBoneInfo[Bone].ParentIndex];
-        Bone = refBoneInfo[Bone].ParentIndex;
-    }
+	// capt_xforms, 16 floats per bone
+	TArray<float> CaptXForms;
 
-    return resultBoneTransform;
+	// boneCapture_pCaptData, 20 floats per bone
+	TArray<float> CaptData;
+};
+
+// Crowd setups send many skeletal meshes sharing the same skeleton, so the skeleton data is cached per USkeleton.
+// Meshes sharing a skeleton can have different bones or reference poses, so the entry also stores a hash of the
+// reference skeleton it was built from, and is replaced when a mesh with a different reference skeleton is sent.
+struct FHoudiniCachedReferenceSkeleton
+{
+	uint64 RefSkeletonHash = 0;
+	TSharedPtr<const FHoudiniReferenceSkeletonData> Data;
+};
+
+static FCriticalSection HoudiniReferenceSkeletonCacheLock;
+static TMap<TObjectKey<USkeleton>, FHoudiniCachedReferenceSkeleton> HoudiniReferenceSkeletonCache;
+
+static uint64
+HoudiniHashReferenceSkeleton(const FReferenceSkeleton& RefSkeleton)
+{
+	const int32 NumRawBones = RefSkeleton.GetRawBoneNum();
+	const TArray<FMeshBoneInfo>& BoneInfos = RefSkeleton.GetRawRefBoneInfo();
+	const TArray<FTransform>& RefBonePose = RefSkeleton.GetRawRefBonePose();
+
+	uint64 Hash = NumRawBones;
+	for (int32 BoneIndex = 0; BoneIndex < NumRawBones; ++BoneIndex)
+	{
+		const FMeshBoneInfo& BoneInfo = BoneInfos[BoneIndex];
+		const FQuat Rotation = RefBonePose[BoneIndex].GetRotation();
+		const FVector Translation = RefBonePose[BoneIndex].GetTranslation();
+		const FVector Scale = RefBonePose[BoneIndex].GetScale3D();
+
+		const double BoneValues[] = {
+			Rotation.X, Rotation.Y, Rotation.Z, Rotation.W,
+			Translation.X, Translation.Y, Translation.Z,
+			Scale.X, Scale.Y, Scale.Z,
+			(double)BoneInfo.ParentIndex, (double)GetTypeHash(BoneInfo.Name) };
+
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(BoneValues), sizeof(BoneValues), Hash);
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*BoneInfo.ExportName), BoneInfo.ExportName.Len() * sizeof(TCHAR), Hash);
+	}
+
+	return Hash;
 }
 
-void
-GetComponentSpaceTransforms(TArray<FTransform>& OutResult, const FReferenceSkeleton& InRefSkeleton)
+static TSharedPtr<const FHoudiniReferenceSkeletonData>
+HoudiniBuildReferenceSkeletonData(const FReferenceSkeleton& RefSkeleton)
 {
-    const int32 PoseNum = InRefSkeleton.GetRefBonePose().Num();
-    OutResult.SetNum(PoseNum);
+	TSharedPtr<FHoudiniReferenceSkeletonData> Data = MakeShared<FHoudiniReferenceSkeletonData>();
+
+	const int32 TotalBones = RefSkeleton.GetRawBoneNum();
+	const TArray<FMeshBoneInfo>& BoneInfos = RefSkeleton.GetRawRefBoneInfo();
+	const TArray<FTransform>& RefBonePose = RefSkeleton.GetRawRefBonePose();
+
+	// Component-space reference pose of each bone
+	TArray<FTransform> ComponentSpaceTransforms;
+	ComponentSpaceTransforms.SetNumUninitialized(TotalBones);
+
+	Data->CaptNames.SetNum(TotalBones);
+	Data->CaptParents.SetNumUninitialized(TotalBones);
+	Data->CaptXForms.SetNumZeroed(16 * TotalBones);
+	Data->CaptData.SetNumZeroed(20 * TotalBones);
+
+	for (int32 BoneIndex = 0; BoneIndex < TotalBones; ++BoneIndex)
+	{
+		const FMeshBoneInfo& CurrentBone = BoneInfos[BoneIndex];
+
+		// Parents always come before their children, so the parent's component-space transform is already known
+		FTransform& BoneTransform = ComponentSpaceTransforms[BoneIndex];
+		BoneTransform = RefBonePose[BoneIndex];
+		if (CurrentBone.ParentIndex != INDEX_NONE)
+			BoneTransform *= ComponentSpaceTransforms[CurrentBone.ParentIndex];
+
+		FMatrix M44 = FHoudiniSkeletalMeshUtils::UnrealToHoudiniMatrix(BoneTransform);
+		FMatrix M44Inverse = M44.Inverse();  //see pCaptData property
+
+		int32 row = 0;
+		int32 col = 0;
+		for (int32 i = 0; i < 16; i++)
+		{
+			Data->CaptXForms[16 * BoneIndex + i] = M44.M[row][col];
+			Data->CaptData[20 * BoneIndex + i] = M44Inverse.M[row][col];
+			col++;
+			if (col > 3)
+			{
+				row++;
+				col = 0;
+			}
+		}
+		Data->CaptData[20 * BoneIndex + 16] = 1.0f;//Top height
+		Data->CaptData[20 * BoneIndex + 17] = 1.0f;//Bottom Height
+		Data->CaptData[20 * BoneIndex + 18] = 1.0f;//Ratio of (top x radius of tube)/(bottom x radius of tube) adjusted for orientation
+		Data->CaptData[20 * BoneIndex + 19] = 1.0f;//Ratio of (top z radius of tube)/(bottom z radius of tube) adjusted for orientation
+
+		Data->CaptNames[BoneIndex] = CurrentBone.ExportName;
+		Data->CaptParents[BoneIndex] = CurrentBone.ParentIndex;
+	}
+
+	return Data;
+}
+
+static TSharedPtr<const FHoudiniReferenceSkeletonData>
+HoudiniGetReferenceSkeletonData(USkeletalMesh const* const InSkeletalMesh)
+{
+	const FReferenceSkeleton& RefSkeleton = InSkeletalMesh->GetRefSkeleton();
+
+	USkeleton* Skeleton = InSkeletalMesh->GetSkeleton();
+	if (!Skeleton)
+		return HoudiniBuildReferenceSkeletonData(RefSkeleton);
+
+	const TObjectKey<USkeleton> Key(Skeleton);
+	const uint64 RefSkeletonHash = HoudiniHashReferenceSkeleton(RefSkeleton);
+	{
+		FScopeLock ScopeLock(&HoudiniReferenceSkeletonCacheLock);
+		const FHoudiniCachedReferenceSkeleton* Cached = HoudiniReferenceSkeletonCache.Find(Key);
+		if (Cached && Cached->RefSkeletonHash == RefSkeletonHash)
+			return Cached->Data;
+	}
+
+	TSharedPtr<const FHoudiniReferenceSkeletonData> Data = HoudiniBuildReferenceSkeletonData(RefSkeleton);
+
+	FScopeLock ScopeLock(&HoudiniReferenceSkeletonCacheLock);
+
+	// Forget the skeletons that have been garbage collected
+	for (auto It = HoudiniReferenceSkeletonCache.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().ResolveObjectPtr())
+			It.RemoveCurrent();
+	}
 
-    for (int32 i = 0; i < PoseNum; i++)
-    {
-        OutResult[i] = GetCompSpaceTransformForBone(InRefSkeleton, i);
+	FHoudiniCachedReferenceSkeleton& Cached = HoudiniReferenceSkeletonCache.FindOrAdd(Key);
+	Cached.RefSkeletonHash = RefSkeletonHash;
+	Cached.Data = Data;
 
-    }
+	return Data;
 }
 
 bool
@@ -795,55 +917,14 @@ FUnrealSkeletalMeshTranslator::CreateSkeletalMeshBoneCaptureAttributes(
 	// Capt_Names
 	// Bone Names
 	//---------------------------------------------------------------------------------------------------------------------
-	const FReferenceSkeleton& RefSkeleton = InSkeletalMesh->GetRefSkeleton();
-
-	TArray<FTransform> ComponentSpaceTransforms;
-	GetComponentSpaceTransforms(ComponentSpaceTransforms, RefSkeleton);
-
-	TArray<FString> CaptNamesData;
-	TArray<int32> CaptParentsData;
-	TArray<float> XFormsData;
-
-	const int32 TotalBones = RefSkeleton.GetRawBoneNum();
-	TArray<float> CaptData;  //for pCaptData property
-	CaptData.SetNumZeroed(TotalBones * 20);
-	//CaptData.Init(0.0f, TotalBones * 20);
+	const TSharedPtr<const FHoudiniReferenceSkeletonData> SkeletonData = HoudiniGetReferenceSkeletonData(InSkeletalMesh);
 
-	XFormsData.AddZeroed(16 * TotalBones);
-	CaptParentsData.AddUninitialized(TotalBones);
-	CaptNamesData.SetNum(TotalBones);
+	const TArray<FString>& CaptNamesData = SkeletonData->CaptNames;
+	const TArray<int32>& CaptParentsData = SkeletonData->CaptParents;
+	const TArray<float>& XFormsData = SkeletonData->CaptXForms;
+	const TArray<float>& CaptData = SkeletonData->CaptData;
 
-	for (int32 BoneIndex = 0; BoneIndex < TotalBones; ++BoneIndex)
-	{
-		const FMeshBoneInfo& CurrentBone = RefSkeleton.GetRefBoneInfo()[BoneIndex];
-		const FTransform& LocalBoneTransform = RefSkeleton.GetRefBonePose()[BoneIndex];
-		FTransform& BoneTransform = ComponentSpaceTransforms[BoneIndex];
-
-		FMatrix M44 = FHoudiniSkeletalMeshUtils::UnrealToHoudiniMatrix(BoneTransform);
-		FMatrix M44Inverse = M44.Inverse();  //see pCaptData property
-
-		int32 row = 0;
-		int32 col = 0;
-		for (int32 i = 0; i < 16; i++)
-		{
-			XFormsData[16 * BoneIndex + i] = M44.M[row][col];
-			CaptData[20 * BoneIndex + i] = M44Inverse.M[row][col];
-			col++;
-			if (col > 3)
-			{
-				row++;
-				col = 0;
-			}
-		}
-		CaptData[20 * BoneIndex + 16] = 1.0f;//Top height
-		CaptData[20 * BoneIndex + 17] = 1.0f;//Bottom Height
-		CaptData[20 * BoneIndex + 18] = 1.0f;//Ratio of (top x radius of tube)/(bottom x radius of tube) adjusted for orientation
-		CaptData[20 * BoneIndex + 19] = 1.0f;//Ratio of (top z radius of tube)/(bottom z radius of tube) adjusted for orientation
-
-
-		CaptNamesData[BoneIndex] = CurrentBone.ExportName;
-		CaptParentsData[BoneIndex] = CurrentBone.ParentIndex;
-	}
+	const int32 TotalBones = CaptNamesData.Num();
 
 	HAPI_AttributeInfo CaptNamesInfo;
 	FHoudiniApi::AttributeInfo_Init(&CaptNamesInfo);
@@ -1108,36 +1189,67 @@ FUnrealSkeletalMeshTranslator::SetSkeletalMeshDataOnNodeFromMeshDescription(
 	const int32 NumVertices = Vertices.Num();
 
 	const FSkinWeightsVertexAttributesConstRef VertexSkinWeights = MeshConstAttributes.GetVertexSkinWeights();
-	
-	TArray<int32> BoneCaptureIndexArray;
-	BoneCaptureIndexArray.Reserve(NumVertices * MAX_TOTAL_INFLUENCES);
-	TArray<float> BoneCaptureDataArray;
-	BoneCaptureDataArray.Reserve(NumVertices * MAX_TOTAL_INFLUENCES);
-	TArray<int32> SizesBoneCaptureIndexArray;
-	SizesBoneCaptureIndexArray.Reserve(NumVertices);
 
+	TArray<FVertexID> VertexIDs;
+	VertexIDs.Reserve(NumVertices);
 	for (const FVertexID& VertexID : Vertices.GetElementIDs())
+		VertexIDs.Add(VertexID);
+
+	// The vertices are processed in parallel, in chunks
+	constexpr int32 VerticesPerChunk = 4096;
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumVertices, VerticesPerChunk);
+
+	// Count the influences of each vertex first, so they can then be written directly at their offset in the arrays
+	// that are uploaded to Houdini.
+	TArray<int32> SizesBoneCaptureIndexArray;
+	SizesBoneCaptureIndexArray.SetNumUninitialized(NumVertices);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
 	{
-		FVertexBoneWeightsConst VertexBoneWeights = VertexSkinWeights.Get(VertexID);
-		uint32 WeightCount = 0;
-		for (const UE::AnimationCore::FBoneWeight& BoneWeight : VertexBoneWeights)
+		const int32 End = FMath::Min((ChunkIndex + 1) * VerticesPerChunk, NumVertices);
+		for (int32 VertexIndex = ChunkIndex * VerticesPerChunk; VertexIndex < End; VertexIndex++)
 		{
-			// Get normalized weight
-			const float Weight = BoneWeight.GetWeight();
-			if (Weight > 0.0f)
+			int32 WeightCount = 0;
+			for (const UE::AnimationCore::FBoneWeight& BoneWeight : VertexSkinWeights.Get(VertexIDs[VertexIndex]))
 			{
-				BoneCaptureDataArray.Add(Weight);
-				const FBoneIndexType BoneIndex = BoneWeight.GetBoneIndex();
-				BoneCaptureIndexArray.Add(BoneIndex);
-				WeightCount++;
+				if (BoneWeight.GetWeight() > 0.0f)
+					WeightCount++;
 			}
+			SizesBoneCaptureIndexArray[VertexIndex] = WeightCount;
 		}
-		SizesBoneCaptureIndexArray.Add(WeightCount);
+	});
+
+	TArray<int32> FirstInfluenceIndices;
+	FirstInfluenceIndices.SetNumUninitialized(NumVertices);
+	int32 NumInfluences = 0;
+	for (int32 VertexIndex = 0; VertexIndex < NumVertices; VertexIndex++)
+	{
+		FirstInfluenceIndices[VertexIndex] = NumInfluences;
+		NumInfluences += SizesBoneCaptureIndexArray[VertexIndex];
 	}
 
-	BoneCaptureIndexArray.Shrink();
-	BoneCaptureDataArray.Shrink();
-	SizesBoneCaptureIndexArray.Shrink();
+	TArray<int32> BoneCaptureIndexArray;
+	BoneCaptureIndexArray.SetNumUninitialized(NumInfluences);
+	TArray<float> BoneCaptureDataArray;
+	BoneCaptureDataArray.SetNumUninitialized(NumInfluences);
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+	{
+		const int32 End = FMath::Min((ChunkIndex + 1) * VerticesPerChunk, NumVertices);
+		for (int32 VertexIndex = ChunkIndex * VerticesPerChunk; VertexIndex < End; VertexIndex++)
+		{
+			int32 InfluenceIndex = FirstInfluenceIndices[VertexIndex];
+			for (const UE::AnimationCore::FBoneWeight& BoneWeight : VertexSkinWeights.Get(VertexIDs[VertexIndex]))
+			{
+				// Get normalized weight
+				const float Weight = BoneWeight.GetWeight();
+				if (Weight > 0.0f)
+				{
+					BoneCaptureDataArray[InfluenceIndex] = Weight;
+					BoneCaptureIndexArray[InfluenceIndex] = BoneWeight.GetBoneIndex();
+					InfluenceIndex++;
+				}
+			}
+		}
+	});
 
 	if (!CreateSkeletalMeshBoneCaptureAttributes(
 			NewNodeId, SkeletalMesh, PartInfo, BoneCaptureIndexArray, BoneCaptureDataArray, SizesBoneCaptureIndexArray))
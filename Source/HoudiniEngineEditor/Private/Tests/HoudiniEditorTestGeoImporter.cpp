@@ -0,0 +1,168 @@
+/*
+* Copyright (c) <2021> Side Effects Software Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. The name of Side Effects Software may not be used to endorse or
+*    promote products derived from this software without specific prior
+*    written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY SIDE EFFECTS SOFTWARE "AS IS" AND ANY EXPRESS
+* OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+* OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.  IN
+* NO EVENT SHALL SIDE EFFECTS SOFTWARE BE LIABLE FOR ANY DIRECT, INDIRECT,
+* INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+* LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+* OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+* LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+* NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+* EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "HoudiniEditorTestGeoImporter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+#include "HoudiniEditorTestUtils.h"
+#include "HoudiniEditorUnitTestUtils.h"
+#include "HoudiniEditorUnitTestMeshUtils.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "HoudiniApi.h"
+#include "HoudiniEngine.h"
+#include "HoudiniGeoImporter.h"
+#include "HoudiniOutput.h"
+#include "HoudiniPackageParams.h"
+#include "HoudiniEngineRuntimeUtils.h"
+
+// Imports InFilePath with the importer: loads it, builds its outputs and creates their objects in temporary packages.
+// Returns the elapsed time in seconds or a negative value on failure.
+static double
+HoudiniTimeGeoImport(const FString& InFilePath, int32& OutNumObjects)
+{
+	UHoudiniGeoImporter* GeoImporter = NewObject<UHoudiniGeoImporter>(GetTransientPackage());
+	GeoImporter->AddToRoot();
+
+	FHoudiniPackageParams PackageParams;
+	PackageParams.PackageMode = EPackageMode::CookToTemp;
+	PackageParams.ReplaceMode = EPackageReplaceMode::CreateNewAssets;
+	PackageParams.TempCookFolder = FHoudiniEditorTestGeoImporter::TempCookFolder;
+	PackageParams.ObjectName = FPaths::GetBaseFilename(InFilePath);
+	PackageParams.OuterPackage = GeoImporter;
+	PackageParams.ComponentGUID = FGuid::NewGuid();
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	HAPI_NodeId NodeId = -1;
+	TArray<TObjectPtr<UHoudiniOutput>> OldOutputs;
+	TArray<TObjectPtr<UHoudiniOutput>> NewOutputs;
+	const bool bSuccess = GeoImporter->SetFilePath(InFilePath)
+		&& GeoImporter->LoadBGEOFileInHAPI(NodeId)
+		&& GeoImporter->BuildOutputsForNode(NodeId, OldOutputs, NewOutputs)
+		&& GeoImporter->CreateObjectsFromOutputs(
+			NewOutputs, PackageParams,
+			FHoudiniEngineRuntimeUtils::GetDefaultStaticMeshGenerationProperties(),
+			FHoudiniEngineRuntimeUtils::GetDefaultMeshBuildSettings());
+
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	OutNumObjects = GeoImporter->GetOutputObjects().Num();
+	for (UObject* Object : GeoImporter->GetOutputObjects())
+	{
+		if (IsValid(Object))
+			Object->MarkAsGarbage();
+	}
+	GeoImporter->GetOutputObjects().Empty();
+
+	for (auto& Output : NewOutputs)
+		Output->RemoveFromRoot();
+
+	UHoudiniGeoImporter::DeleteCreatedNode(NodeId);
+	GeoImporter->RemoveFromRoot();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return bSuccess ? ElapsedTime : -1.0;
+}
+
+IMPLEMENT_SIMPLE_HOUDINI_AUTOMATION_TEST(FHoudiniEditorTestGeoImporter_DirectIngestion, "Houdini.UnitTests.GeoImporter.DirectIngestion",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FHoudiniEditorTestGeoImporter_DirectIngestion::RunTest(const FString& Parameters)
+{
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// Times the direct BGEO ingestion (attribute prefetch, memory load) against the File SOP path, from loading
+	/// the file to creating the objects, and checks that all the modes create the same objects.
+	/// A .bgeo or .bgeo.sc file can be passed as parameter, otherwise grids are generated in the Saved folder.
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// Make sure we have a Houdini Session before doing anything.
+	FHoudiniEditorTestUtils::CreateSessionIfInvalidWithLatentRetries(this, FHoudiniEditorTestUtils::HoudiniEngineSessionPipeName, {}, {});
+
+	AddCommand(new FFunctionLatentCommand([this, Parameters]()
+	{
+		const HAPI_Session* Session = FHoudiniEngine::Get().GetSession();
+		HOUDINI_TEST_NOT_NULL_ON_FAIL(Session, return true);
+
+		TArray<FString> Files;
+		if (!Parameters.IsEmpty())
+		{
+			Files.Add(Parameters);
+		}
+		else
+		{
+			const FString OutputDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("HoudiniEngine") / TEXT("Tests"));
+			IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+			for (const int32 Size : { 256, 1024 })
+			{
+				for (const TCHAR* Extension : { TEXT("bgeo"), TEXT("bgeo.sc") })
+				{
+					const FString FilePath = FString::Printf(TEXT("%s/grid_%d.%s"), *OutputDir, Size, Extension);
+					HOUDINI_TEST_EQUAL_ON_FAIL(FHoudiniEditorUnitTestMeshUtils::SaveSyntheticGrid(Size, Size, FilePath), true, continue);
+					Files.Add(FilePath);
+				}
+			}
+		}
+
+		IConsoleVariable* DirectIngestionCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("HoudiniEngine.GeoImportDirectIngestion"));
+		HOUDINI_TEST_NOT_NULL_ON_FAIL(DirectIngestionCVar, return true);
+
+		// Mode 1 only loads from memory with in-process sessions, mode 2 shows what it would cost with the current session
+		AddInfo(FString::Printf(TEXT("Session type: %s"), Session->type == HAPI_SESSION_INPROCESS ? TEXT("in-process") : TEXT("out-of-process")));
+
+		const int32 PreviousMode = DirectIngestionCVar->GetInt();
+		for (const FString& FilePath : Files)
+		{
+			const FString CleanFilename = FPaths::GetCleanFilename(FilePath);
+
+			double Times[3] = { -1.0, -1.0, -1.0 };
+			int32 NumObjects[3] = { 0, 0, 0 };
+			for (int32 Mode = 0; Mode < 3; Mode++)
+			{
+				DirectIngestionCVar->Set(Mode);
+				Times[Mode] = HoudiniTimeGeoImport(FilePath, NumObjects[Mode]);
+				TestTrue(FString::Printf(TEXT("%s imported with mode %d"), *CleanFilename, Mode), Times[Mode] >= 0.0);
+			}
+
+			TestEqual(FString::Printf(TEXT("%s objects (mode 1)"), *CleanFilename), NumObjects[1], NumObjects[0]);
+			TestEqual(FString::Printf(TEXT("%s objects (mode 2)"), *CleanFilename), NumObjects[2], NumObjects[0]);
+			AddInfo(FString::Printf(TEXT("%s: File SOP %.1f ms, prefetch %.1f ms, prefetch + memory load %.1f ms"),
+				*CleanFilename, Times[0] * 1000.0, Times[1] * 1000.0, Times[2] * 1000.0));
+		}
+		DirectIngestionCVar->Set(PreviousMode);
+
+		return true;
+	}));
+
+	return true;
+}
+
+#endif
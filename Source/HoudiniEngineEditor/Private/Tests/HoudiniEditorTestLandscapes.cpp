@@ -41,6 +41,8 @@
 #include "HoudiniEditorUnitTestUtils.h"
 #include "LandscapeEdit.h"
 #include <HoudiniLandscapeUtils.h>
+#include "HoudiniEngineRuntimePrivatePCH.h"
+#include "HAL/PlatformTime.h"
 
 TArray<FString> FHoudiniEditorTestLandscapes::CheckLandscapeValues(
 	TArray<float> & Results, 
@@ -130,6 +132,22 @@ TArray<float> FHoudiniEditorTestLandscapes::CreateExpectedHeightValues(const FIn
 	return ExpectedResults;
 }
 
+FHoudiniHeightFieldData FHoudiniEditorTestLandscapes::CreateSyntheticHeightField(const FIntPoint& Size, float Amplitude)
+{
+	FHoudiniHeightFieldData HeightField;
+	HeightField.Dimensions = Size;
+	HeightField.bHoudiniOrder = true;
+	HeightField.Values.SetNumUninitialized(HeightField.GetNumPoints());
+	for (int X = 0; X < Size.X; X++)
+	{
+		for (int Y = 0; Y < Size.Y; Y++)
+		{
+			HeightField.Values[Y + X * Size.Y] = Amplitude * FMath::Sin(X * 0.011f) * FMath::Cos(Y * 0.007f);
+		}
+	}
+	return HeightField;
+}
+
 float FHoudiniEditorTestLandscapes::GetMin(const TArray<float>& Values)
 {
 	float MinValue = TNumericLimits<float>::Max();
@@ -775,5 +793,104 @@ bool FHoudiniEditorTestLandscapes_ModifyExisting::RunTest(const FString& Paramet
 
 	return true;
 }
+IMPLEMENT_SIMPLE_HOUDINI_AUTOMATION_TEST(FHoudiniEditorTestLandscapes_Conversion, "Houdini.UnitTests.Landscapes.HeightFieldConversion",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FHoudiniEditorTestLandscapes_Conversion::RunTest(const FString & Parameters)
+{
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// Checks the fused height field conversion against the multi-pass pipeline it replaced
+	/// (Transpose, ReDimension, Realign, Clamp, Quantize) on large synthetic volumes, and times both.
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Height range of a landscape with a Z scale of 100.
+	const float HeightRangeInCM = 256.0f * 100.0f;
+
+	// Pairs of Houdini volume / Unreal landscape sizes: the second case of each size needs resampling.
+	const TArray<TPair<FIntPoint, FIntPoint>> Cases = {
+		{ FIntPoint(1009, 1009), FIntPoint(1009, 1009) },
+		{ FIntPoint(1000, 1000), FIntPoint(1009, 1009) },
+		{ FIntPoint(2017, 2017), FIntPoint(2017, 2017) },
+		{ FIntPoint(2000, 2000), FIntPoint(2017, 2017) },
+		{ FIntPoint(4033, 4033), FIntPoint(4033, 4033) },
+		{ FIntPoint(4000, 4000), FIntPoint(4033, 4033) }
+	};
+
+	for (const TPair<FIntPoint, FIntPoint>& Case : Cases)
+	{
+		const FIntPoint& VolumeSize = Case.Key;
+		const FIntPoint& LandscapeSize = Case.Value;
+
+		// Height layer
+		{
+			const FHoudiniHeightFieldData HeightField = CreateSyntheticHeightField(VolumeSize, 100.0f);
+
+			double StartTime = FPlatformTime::Seconds();
+			FHoudiniHeightFieldData MultiPass = HeightField;
+			FHoudiniLandscapeUtils::TransposeValues(MultiPass.Values, MultiPass.Dimensions);
+			MultiPass.bHoudiniOrder = false;
+			if (MultiPass.Dimensions != LandscapeSize)
+				MultiPass = FHoudiniLandscapeUtils::ReDimensionLandscape(MultiPass, LandscapeSize);
+			FHoudiniLandscapeUtils::RealignHeightFieldData(MultiPass.Values, 0.5f, 100.0f / HeightRangeInCM * 0.5f);
+			FHoudiniLandscapeUtils::ClampHeightFieldData(MultiPass.Values, 0.0f, 1.0f);
+			TArray<uint16> Expected = FHoudiniLandscapeUtils::QuantizeNormalizedDataTo16Bit(MultiPass.Values);
+			const double MultiPassTime = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			bool bClamped = false;
+			TArray<uint16> Actual = FHoudiniLandscapeUtils::ConvertHeightFieldData(HeightField, LandscapeSize, HeightRangeInCM, bClamped);
+			const double FusedTime = FPlatformTime::Seconds() - StartTime;
+
+			// Allow a difference of one unit, since the fused conversion may use fused multiply-adds.
+			HOUDINI_TEST_EQUAL_ON_FAIL(Actual.Num(), Expected.Num(), continue);
+			TArray<float> ExpectedValues(Expected);
+			TArray<float> ActualValues(Actual);
+			TArray<FString> Errors = CheckLandscapeValues(ActualValues, ExpectedValues, LandscapeSize, 1.0f);
+			HOUDINI_TEST_EQUAL(Errors.Num(), 0);
+			for (auto& Error : Errors)
+				HOUDINI_LOG_ERROR(TEXT("Height %dx%d -> %dx%d: %s"), VolumeSize.X, VolumeSize.Y, LandscapeSize.X, LandscapeSize.Y, *Error);
+
+			AddInfo(FString::Printf(TEXT("Height %dx%d -> %dx%d: multi-pass %.1f ms, fused %.1f ms"),
+				VolumeSize.X, VolumeSize.Y, LandscapeSize.X, LandscapeSize.Y, MultiPassTime * 1000.0, FusedTime * 1000.0));
+		}
+
+		// Paint layer, with values above 1.0 so they get normalized
+		{
+			const FHoudiniHeightFieldData HeightField = CreateSyntheticHeightField(VolumeSize, 2.0f);
+
+			double StartTime = FPlatformTime::Seconds();
+			FHoudiniHeightFieldData MultiPass = HeightField;
+			FHoudiniLandscapeUtils::TransposeValues(MultiPass.Values, MultiPass.Dimensions);
+			MultiPass.bHoudiniOrder = false;
+			if (MultiPass.Dimensions != LandscapeSize)
+				MultiPass = FHoudiniLandscapeUtils::ReDimensionLandscape(MultiPass, LandscapeSize);
+			FHoudiniLandscapeUtils::NormalizePaintLayers(MultiPass.Values, true);
+			TArray<float> ExpectedValues;
+			ExpectedValues.SetNumUninitialized(MultiPass.Values.Num());
+			for (int Index = 0; Index < ExpectedValues.Num(); Index++)
+				ExpectedValues[Index] = static_cast<uint8>(FMath::Clamp(MultiPass.Values[Index], 0.0f, 1.0f) * 255);
+			const double MultiPassTime = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			bool bExceededRange = false;
+			TArray<uint8> Actual = FHoudiniLandscapeUtils::ConvertPaintLayerData(HeightField, LandscapeSize, true, bExceededRange);
+			const double FusedTime = FPlatformTime::Seconds() - StartTime;
+
+			HOUDINI_TEST_EQUAL(bExceededRange, true);
+			HOUDINI_TEST_EQUAL_ON_FAIL(Actual.Num(), ExpectedValues.Num(), continue);
+			TArray<float> ActualValues(Actual);
+			TArray<FString> Errors = CheckLandscapeValues(ActualValues, ExpectedValues, LandscapeSize, 1.0f);
+			HOUDINI_TEST_EQUAL(Errors.Num(), 0);
+			for (auto& Error : Errors)
+				HOUDINI_LOG_ERROR(TEXT("Paint %dx%d -> %dx%d: %s"), VolumeSize.X, VolumeSize.Y, LandscapeSize.X, LandscapeSize.Y, *Error);
+
+			AddInfo(FString::Printf(TEXT("Paint %dx%d -> %dx%d: multi-pass %.1f ms, fused %.1f ms"),
+				VolumeSize.X, VolumeSize.Y, LandscapeSize.X, LandscapeSize.Y, MultiPassTime * 1000.0, FusedTime * 1000.0));
+		}
+	}
+
+	return true;
+}
+
 #endif
 
@@ -30,6 +30,8 @@
 
 #include "CoreMinimal.h"
 
+struct FHoudiniHeightFieldData;
+
 class FHoudiniEditorTestLandscapes
 {
 public:
@@ -39,6 +41,9 @@ public:
     static TArray<float> GetLandscapeHeightValues(ALandscape* LandscapeActor);
     static TArray<float> CreateExpectedHeightValues(const FIntPoint& ExpectedSize, float HeightScale);
 
+    // Creates a height field of Size (in Unreal space) with its values in Houdini order, like HAPI returns them.
+    static FHoudiniHeightFieldData CreateSyntheticHeightField(const FIntPoint& Size, float Amplitude);
+
     // Functions for getting and setting paint layers
     static TArray<float> GetLandscapePaintLayerValues(ALandscape* LandscapeActor, const FString & TargetLayerName);
     static TArray<float> CreateExpectedPaintLayer1Values(const FIntPoint& ExpectedSize);
@@ -37,6 +37,15 @@
 #include "FoliageType_InstancedStaticMesh.h"
 #include "HoudiniEngineBakeUtils.h"
 #include "HoudiniEngineRuntimePrivatePCH.h"
+#include "HoudiniApi.h"
+#include "HoudiniEngine.h"
+#include "HoudiniEngineUtils.h"
+#include "HoudiniEngineRuntimeUtils.h"
+#include "HoudiniMeshTranslator.h"
+#include "HoudiniOutputTranslator.h"
+#include "HoudiniPackageParams.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 
 IMPLEMENT_SIMPLE_HOUDINI_AUTOMATION_TEST(FHoudiniEditorTestsProxyMeshVertices, "Houdini.UnitTests.ProxyMesh.Vertices",
 	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::CommandletContext  | EAutomationTestFlags::ProductFilter)
@@ -140,5 +149,129 @@ bool FHoudiniEditorTestsProxyMeshVertices::RunTest(const FString& Parameters)
 }
 
 
+// Builds the Houdini Static Mesh of InHGPO with the given HoudiniEngine.MeshBuildParallel value.
+// Returns the elapsed time in seconds or a negative value on failure.
+static double
+HoudiniTimeProxyMeshBuild(
+	IConsoleVariable* InParallelCVar,
+	const int32 InParallelMode,
+	const FHoudiniGeoPartObject& InHGPO,
+	UObject* InOuter,
+	UHoudiniStaticMesh*& OutMesh)
+{
+	OutMesh = nullptr;
+	InParallelCVar->Set(InParallelMode);
+
+	FHoudiniPackageParams PackageParams;
+	PackageParams.PackageMode = EPackageMode::CookToTemp;
+	PackageParams.ReplaceMode = EPackageReplaceMode::CreateNewAssets;
+	PackageParams.TempCookFolder = TEXT("/Game/HoudiniEngine/Temp/Tests");
+	PackageParams.ObjectName = FString::Printf(TEXT("ParallelProxyBuild_%d"), InParallelMode);
+	PackageParams.OuterPackage = InOuter;
+	PackageParams.ComponentGUID = FGuid::NewGuid();
+
+	TMap<FHoudiniOutputObjectIdentifier, FHoudiniOutputObject> InputObjects;
+	TMap<FHoudiniOutputObjectIdentifier, FHoudiniOutputObject> OutputObjects;
+	TMap<FHoudiniMaterialIdentifier, TObjectPtr<UMaterialInterface>> AssignmentMaterials;
+	TMap<FHoudiniMaterialIdentifier, TObjectPtr<UMaterialInterface>> ReplacementMaterials;
+	TMap<FHoudiniMaterialIdentifier, TObjectPtr<UMaterialInterface>> AllOutputMaterials;
+
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bSuccess = FHoudiniMeshTranslator::CreateStaticMeshFromHoudiniGeoPartObject(
+		InHGPO, PackageParams, InputObjects, OutputObjects,
+		AssignmentMaterials, ReplacementMaterials, AllOutputMaterials,
+		nullptr, true, EHoudiniStaticMeshMethod::UHoudiniStaticMesh, false,
+		FHoudiniEngineRuntimeUtils::GetDefaultStaticMeshGenerationProperties(),
+		FHoudiniEngineRuntimeUtils::GetDefaultMeshBuildSettings());
+	const double ElapsedTime = FPlatformTime::Seconds() - StartTime;
+
+	for (auto& Pair : OutputObjects)
+	{
+		OutMesh = Cast<UHoudiniStaticMesh>(Pair.Value.ProxyObject);
+		if (IsValid(OutMesh))
+			break;
+	}
+
+	return bSuccess && IsValid(OutMesh) ? ElapsedTime : -1.0;
+}
+
+IMPLEMENT_SIMPLE_HOUDINI_AUTOMATION_TEST(FHoudiniEditorTestsProxyMeshParallelBuild, "Houdini.UnitTests.ProxyMesh.ParallelBuild",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FHoudiniEditorTestsProxyMeshParallelBuild::RunTest(const FString& Parameters)
+{
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+	/// Checks that the parallel proxy mesh build gives the same meshes as the serial build on large grids, and times both.
+	/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+	/// Make sure we have a Houdini Session before doing anything.
+	FHoudiniEditorTestUtils::CreateSessionIfInvalidWithLatentRetries(this, FHoudiniEditorTestUtils::HoudiniEngineSessionPipeName, {}, {});
+
+	AddCommand(new FFunctionLatentCommand([this]()
+	{
+		HOUDINI_TEST_NOT_NULL_ON_FAIL(FHoudiniEngine::Get().GetSession(), return true);
+
+		IConsoleVariable* ParallelCVar = IConsoleManager::Get().FindConsoleVariable(TEXT("HoudiniEngine.MeshBuildParallel"));
+		HOUDINI_TEST_NOT_NULL_ON_FAIL(ParallelCVar, return true);
+
+		const int32 PreviousMode = ParallelCVar->GetInt();
+		for (const int32 Size : { 256, 1024, 2048 })
+		{
+			const int32 NodeId = FHoudiniEditorUnitTestMeshUtils::CreateSyntheticGrid(Size, Size);
+			HOUDINI_TEST_NOT_EQUAL_ON_FAIL(NodeId, -1, continue);
+
+			UPackage* Outer = GetTransientPackage();
+			TArray<HAPI_NodeId> OutputNodes;
+			FHoudiniEngineUtils::GatherAllAssetOutputs(NodeId, false, false, false, OutputNodes);
+
+			TMap<HAPI_NodeId, int32> OutputNodeCookCounts;
+			TArray<TObjectPtr<UHoudiniOutput>> OldOutputs;
+			TArray<TObjectPtr<UHoudiniOutput>> NewOutputs;
+			FHoudiniOutputTranslator::BuildAllOutputs(NodeId, Outer, OutputNodes, OutputNodeCookCounts, OldOutputs, NewOutputs, false, false, false);
+
+			for (UHoudiniOutput* Output : NewOutputs)
+			{
+				if (!IsValid(Output) || Output->GetType() != EHoudiniOutputType::Mesh)
+					continue;
+
+				for (const FHoudiniGeoPartObject& HGPO : Output->GetHoudiniGeoPartObjects())
+				{
+					if (HGPO.Type != EHoudiniPartType::Mesh)
+						continue;
+
+					UHoudiniStaticMesh* SerialMesh = nullptr;
+					UHoudiniStaticMesh* ParallelMesh = nullptr;
+					const double SerialTime = HoudiniTimeProxyMeshBuild(ParallelCVar, 0, HGPO, Outer, SerialMesh);
+					const double ParallelTime = HoudiniTimeProxyMeshBuild(ParallelCVar, 1, HGPO, Outer, ParallelMesh);
+
+					const FString CaseName = FString::Printf(TEXT("%dx%d grid"), Size, Size);
+					if (!TestTrue(CaseName + TEXT(" built"), SerialTime >= 0.0 && ParallelTime >= 0.0))
+						continue;
+
+					TestTrue(CaseName + TEXT(" positions"), SerialMesh->GetVertexPositions() == ParallelMesh->GetVertexPositions());
+					TestTrue(CaseName + TEXT(" triangles"), SerialMesh->GetTriangleIndices() == ParallelMesh->GetTriangleIndices());
+					TestTrue(CaseName + TEXT(" normals"), SerialMesh->GetVertexInstanceNormals() == ParallelMesh->GetVertexInstanceNormals());
+					TestTrue(CaseName + TEXT(" uvs"), SerialMesh->GetVertexInstanceUVs() == ParallelMesh->GetVertexInstanceUVs());
+					TestTrue(CaseName + TEXT(" material ids"), SerialMesh->GetMaterialIDsPerTriangle() == ParallelMesh->GetMaterialIDsPerTriangle());
+
+					AddInfo(FString::Printf(TEXT("%s (%d triangles): serial %.1f ms, parallel %.1f ms"),
+						*CaseName, SerialMesh->GetNumTriangles(), SerialTime * 1000.0, ParallelTime * 1000.0));
+
+					SerialMesh->MarkAsGarbage();
+					ParallelMesh->MarkAsGarbage();
+				}
+			}
+
+			FHoudiniApi::DeleteNode(FHoudiniEngine::Get().GetSession(), FHoudiniEngineUtils::HapiGetParentNodeId(NodeId));
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+		ParallelCVar->Set(PreviousMode);
+
+		return true;
+	}));
+
+	return true;
+}
+
 #endif
 
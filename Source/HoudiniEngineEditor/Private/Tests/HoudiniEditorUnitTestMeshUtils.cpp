@@ -25,6 +25,9 @@
 #include "HoudiniParameterToggle.h"
 #include "HoudiniEngineOutputStats.h"
 #include "HoudiniPDGManager.h"
+#include "HoudiniApi.h"
+#include "HoudiniEngine.h"
+#include "HoudiniEngineUtils.h"
 
 FHoudiniTestMeshData FHoudiniEditorUnitTestMeshUtils::GetExpectedMeshData()
 {
@@ -134,6 +137,59 @@ TArray<FString> FHoudiniEditorUnitTestMeshUtils::CheckMesh(FHoudiniTestMeshData&
 }
 
 
+int32 FHoudiniEditorUnitTestMeshUtils::CreateSyntheticGrid(const int32 InRows, const int32 InColumns)
+{
+	const HAPI_Session* Session = FHoudiniEngine::Get().GetSession();
+	if (!Session)
+		return -1;
+
+	HAPI_NodeId GridNodeId = -1;
+	if (HAPI_RESULT_SUCCESS != FHoudiniEngineUtils::CreateNode(-1, TEXT("SOP/grid"), TEXT("test_grid"), false, &GridNodeId))
+		return -1;
+
+	FHoudiniApi::SetParmIntValue(Session, GridNodeId, "rows", 0, InRows);
+	FHoudiniApi::SetParmIntValue(Session, GridNodeId, "cols", 0, InColumns);
+
+	// Add normals and uvs so the translators have some attributes to read
+	HAPI_NodeId NormalNodeId = -1;
+	HAPI_NodeId UVNodeId = -1;
+	const HAPI_NodeId ParentNodeId = FHoudiniEngineUtils::HapiGetParentNodeId(GridNodeId);
+	bool bSuccess = HAPI_RESULT_SUCCESS == FHoudiniEngineUtils::CreateNode(ParentNodeId, TEXT("normal"), TEXT("test_normal"), false, &NormalNodeId)
+		&& HAPI_RESULT_SUCCESS == FHoudiniEngineUtils::CreateNode(ParentNodeId, TEXT("uvtexture"), TEXT("test_uv"), false, &UVNodeId)
+		&& HAPI_RESULT_SUCCESS == FHoudiniApi::ConnectNodeInput(Session, NormalNodeId, 0, GridNodeId, 0)
+		&& HAPI_RESULT_SUCCESS == FHoudiniApi::ConnectNodeInput(Session, UVNodeId, 0, NormalNodeId, 0)
+		&& HAPI_RESULT_SUCCESS == FHoudiniApi::SetNodeDisplay(Session, UVNodeId, 1);
+
+	if (bSuccess)
+	{
+		HAPI_CookOptions CookOptions = FHoudiniEngine::GetDefaultCookOptions();
+		bSuccess = FHoudiniEngineUtils::HapiCookNode(UVNodeId, &CookOptions, true);
+	}
+
+	if (!bSuccess)
+	{
+		FHoudiniApi::DeleteNode(Session, ParentNodeId);
+		return -1;
+	}
+
+	return UVNodeId;
+}
+
+bool FHoudiniEditorUnitTestMeshUtils::SaveSyntheticGrid(const int32 InRows, const int32 InColumns, const FString& InFilePath)
+{
+	const HAPI_NodeId NodeId = CreateSyntheticGrid(InRows, InColumns);
+	if (NodeId < 0)
+		return false;
+
+	const HAPI_Session* Session = FHoudiniEngine::Get().GetSession();
+	const std::string ConvertedPath = TCHAR_TO_UTF8(*InFilePath);
+	const bool bSuccess = HAPI_RESULT_SUCCESS == FHoudiniApi::SaveGeoToFile(Session, NodeId, ConvertedPath.c_str());
+
+	FHoudiniApi::DeleteNode(Session, FHoudiniEngineUtils::HapiGetParentNodeId(NodeId));
+
+	return bSuccess;
+}
+
 FString FHoudiniTestMeshData::ToString()
 {
 	FString Result;
@@ -60,6 +60,13 @@ struct FHoudiniEditorUnitTestMeshUtils
 	static FHoudiniTestMeshData ExtractMeshData(UStaticMesh& Mesh, int LOD);
 	static TArray<FString> CheckMesh(FHoudiniTestMeshData & ExpectedMesh, FHoudiniTestMeshData& ActualData);
 
+	// Creates and cooks a grid with InRows x InColumns points, with normals and uvs, in the current session.
+	// Returns the node id of its display SOP, or -1 on failure. Delete the SOP's parent node when done.
+	static int32 CreateSyntheticGrid(const int32 InRows, const int32 InColumns);
+
+	// Saves a grid created by CreateSyntheticGrid to InFilePath (.bgeo, .bgeo.sc...), then deletes its nodes.
+	static bool SaveSyntheticGrid(const int32 InRows, const int32 InColumns, const FString& InFilePath);
+
 };
 
 #if WITH_DEV_AUTOMATION_TESTS
@@ -267,6 +267,7 @@ UHoudiniAssetComponent::UHoudiniAssetComponent(const FObjectInitializer & Object
 
 	LastTickTime = 0.0;
 	LastLiveSyncPingTime = 0.0;
+	SchedulerAffinity = INDEX_NONE;
 
 	// Initialize the default SM Build settings with the plugin's settings default values
 	StaticMeshBuildSettings = FHoudiniEngineRuntimeUtils::GetDefaultMeshBuildSettings();
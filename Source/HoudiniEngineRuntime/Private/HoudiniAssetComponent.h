@@ -348,6 +348,12 @@ public:
 	//
 	void ClearDownstreamHoudiniAsset() { DownstreamHoudiniAssets.Empty(); };
 	//
+	const TSet<TObjectPtr<UHoudiniAssetComponent>>& GetDownstreamHoudiniAssets() const { return DownstreamHoudiniAssets; };
+	// Scheduler affinity this component's tasks are dispatched with, see FHoudiniEngineManager::GetSchedulerAffinity
+	int32 GetSchedulerAffinity() const { return SchedulerAffinity; };
+	//
+	void SetSchedulerAffinity(const int32 InSchedulerAffinity) { SchedulerAffinity = InSchedulerAffinity; };
+	//
 	bool NotifyCookedToDownstreamAssets();
 	//
 	bool NeedsToWaitForInputHoudiniAssets();
@@ -851,6 +857,11 @@ protected:
 	UPROPERTY(Transient)
 	double LastLiveSyncPingTime;
 
+	// Scheduler affinity of the node tree this component was instantiated in, INDEX_NONE if unassigned.
+	// Kept until the tree is explicitly re-homed so that all its tasks go to the same scheduler.
+	UPROPERTY(Transient, DuplicateTransient)
+	int32 SchedulerAffinity;
+
 	UPROPERTY()
 	TArray<int8> ParameterPresetBuffer;
 
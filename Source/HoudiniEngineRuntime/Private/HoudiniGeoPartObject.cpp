@@ -52,6 +52,7 @@ FHoudiniGeoPartObject::FHoudiniGeoPartObject()
 	, bHasTransformChanged(true)
 	, bHasMaterialsChanged(true)
 	, bLoaded(false)
+	, PartFingerprint(0)
 	, bKeepTags(false)
 {
 
@@ -401,6 +401,10 @@ public:
 	// Indicates this object has been loaded
 	bool bLoaded;
 
+	// Hash of the part's data, used to keep the outputs of parts that haven't changed between cooks.
+	// 0 if it hasn't been computed.
+	uint64 PartFingerprint;
+
 	// We also keep a cache of the various info objects
 	// That we've extracted from HAPI
 	
@@ -247,6 +247,11 @@ public:
 	UPROPERTY()
 	TArray<FHoudiniGenericAttribute> PropertyAttributes;
 
+	// Hash of the data written to each landscape component (within Extents) during the cook.
+	// When set, the next cook only writes the components whose current landscape data differs from its new data.
+	UPROPERTY(Transient)
+	TArray<uint64> ComponentDataHashes;
+
 };
 
 UCLASS()
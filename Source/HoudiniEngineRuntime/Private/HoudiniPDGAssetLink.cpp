@@ -364,7 +364,11 @@ UTOPNode::UTOPNode()
 	
 	bCachedHaveNotLoadedWorkResults = false;
 	bCachedHaveLoadedWorkResults = false;
+	NumLoadedWorkResultObjects = 0;
+	NumNotLoadedWorkResultObjects = 0;
+	bWorkResultObjectCountsValid = false;
 	bHasChildNodes = false;
+	bHasPendingWorkResultChanges = true;
 	
 	bShow = false;
 
@@ -498,8 +502,9 @@ UTOPNode::SetNotLoadedWorkResultsToLoad(bool bInAlsoSetDeletedToLoad)
 			if (WRO.State == EPDGWorkResultState::NotLoaded ||
 					(WRO.State == EPDGWorkResultState::Deleted && bInAlsoSetDeletedToLoad))
 			{
-				WRO.State = EPDGWorkResultState::ToLoad;
+				SetWorkResultObjectState(WRO, EPDGWorkResultState::ToLoad);
 				WRO.SetAutoBakedSinceLastLoad(false);
+				bHasPendingWorkResultChanges = true;
 			}
 		}
 	}
@@ -513,7 +518,10 @@ UTOPNode::SetLoadedWorkResultsToDelete()
 		for (FTOPWorkResultObject& WRO : WorkItem.ResultObjects)
 		{
 			if (WRO.State == EPDGWorkResultState::Loaded)
-				WRO.State = EPDGWorkResultState::ToDelete;
+			{
+				SetWorkResultObjectState(WRO, EPDGWorkResultState::ToDelete);
+				bHasPendingWorkResultChanges = true;
+			}
 		}
     }	
 }
@@ -543,7 +551,7 @@ UTOPNode::DeleteWorkResultObjectOutputs(const int32 InWorkResultArrayIndex, cons
 	WRO.DestroyResultOutputs(GetHoudiniComponentGuid());
 	if (bInDeleteOutputActors)
 		WRO.GetOutputActorOwner().DestroyOutputActor();
-	WRO.State = EPDGWorkResultState::Deleted;
+	SetWorkResultObjectState(WRO, EPDGWorkResultState::Deleted);
 
 	// Ensure that the outer level (or actor in the case of OFPA) is marked as dirty so that references to the
 	// output actors / objects are saved
@@ -572,7 +580,77 @@ UTOPNode::DeleteAllWorkResultObjectOutputs(const bool bInDeleteOutputActors)
 	{
 		DeleteWorkItemOutputs(WorkItemIndex, bInDeleteOutputActors);
 	}
-	bCachedHaveLoadedWorkResults = false;
+}
+
+void
+UTOPNode::SetWorkResultObjectState(FTOPWorkResultObject& InWorkResultObject, const EPDGWorkResultState& InNewState)
+{
+	if (InWorkResultObject.State == InNewState)
+		return;
+
+	// The object's current state is part of the recount, only apply the transition once counted
+	if (!bWorkResultObjectCountsValid)
+		UpdateWorkResultObjectCounts();
+
+	AddWorkResultObjectStateCount(InWorkResultObject.State, -1);
+	InWorkResultObject.State = InNewState;
+	AddWorkResultObjectStateCount(InNewState, 1);
+}
+
+void
+UTOPNode::OnWorkResultObjectsRemoved(const TArray<FTOPWorkResultObject>& InWorkResultObjects)
+{
+	if (!bWorkResultObjectCountsValid)
+		UpdateWorkResultObjectCounts();
+
+	for (const FTOPWorkResultObject& WorkResultObject : InWorkResultObjects)
+		AddWorkResultObjectStateCount(WorkResultObject.State, -1);
+}
+
+void
+UTOPNode::OnWorkResultObjectsAdded(const TArray<FTOPWorkResultObject>& InWorkResultObjects)
+{
+	// A recount already includes the added objects
+	if (!bWorkResultObjectCountsValid)
+	{
+		UpdateWorkResultObjectCounts();
+		return;
+	}
+
+	for (const FTOPWorkResultObject& WorkResultObject : InWorkResultObjects)
+		AddWorkResultObjectStateCount(WorkResultObject.State, 1);
+}
+
+void
+UTOPNode::UpdateWorkResultObjectCounts()
+{
+	NumLoadedWorkResultObjects = 0;
+	NumNotLoadedWorkResultObjects = 0;
+	bWorkResultObjectCountsValid = true;
+
+	for (const FTOPWorkResult& CurrentWorkResult : WorkResult)
+	{
+		for (const FTOPWorkResultObject& WorkResultObject : CurrentWorkResult.ResultObjects)
+			AddWorkResultObjectStateCount(WorkResultObject.State, 1);
+	}
+
+	bCachedHaveLoadedWorkResults = NumLoadedWorkResultObjects > 0;
+	bCachedHaveNotLoadedWorkResults = NumNotLoadedWorkResultObjects > 0;
+}
+
+void
+UTOPNode::AddWorkResultObjectStateCount(const EPDGWorkResultState& InState, const int32 InDelta)
+{
+	if (InState == EPDGWorkResultState::Loaded)
+	{
+		NumLoadedWorkResultObjects = FMath::Max(NumLoadedWorkResultObjects + InDelta, 0);
+		bCachedHaveLoadedWorkResults = NumLoadedWorkResultObjects > 0;
+	}
+	else if (InState == EPDGWorkResultState::NotLoaded || InState == EPDGWorkResultState::Deleted)
+	{
+		NumNotLoadedWorkResultObjects = FMath::Max(NumNotLoadedWorkResultObjects + InDelta, 0);
+		bCachedHaveNotLoadedWorkResults = NumNotLoadedWorkResultObjects > 0;
+	}
 }
 
 FString
@@ -1188,6 +1266,7 @@ UHoudiniPDGAssetLink::ClearTOPNodeWorkItemResults(UTOPNode* TOPNode)
 		CurrentWorkResult.ClearAndDestroyResultObjects(HoudiniComponentGuid);
 	}
 	TOPNode->WorkResult.Empty();
+	TOPNode->UpdateWorkResultObjectCounts();
 
 	FOutputActorOwner& OutputActorOwner = TOPNode->GetOutputActorOwner();
 	AActor* OutputActor = OutputActorOwner.GetOutputActor();
@@ -1230,6 +1309,7 @@ UHoudiniPDGAssetLink::ClearWorkItemResultByID(const int32& InWorkItemID, UTOPNod
 	FTOPWorkResult* WorkResult = GetWorkResultByID(InWorkItemID, InTOPNode);
 	if (WorkResult)
 	{
+		InTOPNode->OnWorkResultObjectsRemoved(WorkResult->ResultObjects);
 		WorkResult->ClearAndDestroyResultObjects(InTOPNode->GetHoudiniComponentGuid());
 		// TODO: Should we destroy the FTOPWorkResult struct entirely here?
 		//TOPNode.WorkResult.RemoveByPredicate
@@ -1593,8 +1673,7 @@ UHoudiniPDGAssetLink::UpdatePostDuplicate()
 				}
 			}
 			TOPNode->GetOutputActorOwner().SetOutputActor(nullptr);
-			TOPNode->bCachedHaveNotLoadedWorkResults = false;
-			TOPNode->bCachedHaveLoadedWorkResults = false;
+			TOPNode->UpdateWorkResultObjectCounts();
 		}
 	}
 }
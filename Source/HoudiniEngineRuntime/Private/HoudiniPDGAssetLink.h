@@ -447,6 +447,19 @@ public:
 	// actors).
 	void SetLoadedWorkResultsToDelete();
 
+	// Sets the state of one of this node's work result objects, and updates the loaded / not loaded counts behind
+	// bCachedHaveLoadedWorkResults and bCachedHaveNotLoadedWorkResults.
+	void SetWorkResultObjectState(FTOPWorkResultObject& InWorkResultObject, const EPDGWorkResultState& InNewState);
+
+	// Must be called before result objects are removed from one of this node's work results.
+	void OnWorkResultObjectsRemoved(const TArray<FTOPWorkResultObject>& InWorkResultObjects);
+
+	// Must be called after result objects were added to one of this node's work results.
+	void OnWorkResultObjectsAdded(const TArray<FTOPWorkResultObject>& InWorkResultObjects);
+
+	// Recounts the loaded / not loaded work result objects of this node from their states.
+	void UpdateWorkResultObjectCounts();
+
 	// Immediately delete the Loaded work result output object (keeps the work item and result structs in the arrays but
 	// deletes the output object and the actor and sets the state to Deleted.
 	void DeleteWorkResultObjectOutputs(const int32 InWorkResultArrayIndex, const int32 InWorkResultObjectArrayIndex, const bool bInDeleteOutputActors=true);
@@ -528,13 +541,11 @@ public:
 	UPROPERTY(Transient, NonTransactional)
 	EPDGNodeState 			NodeState;
 
-	// This is set when the TOP node's work items are processed by
-	// FHoudiniPDGManager based on if any NotLoaded work result objects are found
+	// True if any work result object is NotLoaded or Deleted, kept up to date by SetWorkResultObjectState
 	UPROPERTY(NonTransactional)
 	bool bCachedHaveNotLoadedWorkResults;
 
-	// This is set when the TOP node's work items are processed by
-	// FHoudiniPDGManager based on if any Loaded work result objects are found
+	// True if any work result object is Loaded, kept up to date by SetWorkResultObjectState
 	UPROPERTY(NonTransactional)
 	bool bCachedHaveLoadedWorkResults;
 
@@ -542,6 +553,10 @@ public:
 	UPROPERTY(NonTransactional)
 	bool bHasChildNodes;
 
+	// Set when work result objects changed state outside of FHoudiniPDGManager's result queue (for example from
+	// the details panel), so that the manager rescans this node's work results on its next tick.
+	bool bHasPendingWorkResultChanges;
+
 	// These notification events have been introduced so that we can start encapsulating code.
 	// in this class as opposed to modifying this object in various places throughout the codebase.
 
@@ -562,6 +577,14 @@ public:
 protected:
 	void InvalidateLandscapeCache();
 
+	// Adds InDelta to the loaded / not loaded count matching InState, and updates the cached flags
+	void AddWorkResultObjectStateCount(const EPDGWorkResultState& InState, const int32 InDelta);
+
+	// Number of Loaded and of NotLoaded / Deleted work result objects. Not saved, they are recounted on first use.
+	int32 NumLoadedWorkResultObjects;
+	int32 NumNotLoadedWorkResultObjects;
+	bool bWorkResultObjectCountsValid;
+
 	// Visible in the level
 	UPROPERTY()
 	bool					bShow;
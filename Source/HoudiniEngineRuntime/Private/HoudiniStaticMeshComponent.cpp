@@ -30,10 +30,27 @@
 #include "Engine/CollisionProfile.h"
 #include "SceneInterface.h"
 #include "Engine/Texture2D.h" 
+#include "HAL/IConsoleManager.h"
 
 #include "HoudiniStaticMesh.h"
 #include "HoudiniStaticMeshSceneProxy.h"
 
+static TAutoConsoleVariable<int32> CVarHoudiniEngineProxyMeshStaticDraw(
+	TEXT("HoudiniEngine.ProxyMeshStaticDraw"),
+	1,
+	TEXT("Controls how Houdini proxy meshes are rendered.\n")
+	TEXT("0: Always rebuild the mesh batches every frame (dynamic draw path)\n")
+	TEXT("1: Use cached static draw commands, except while the mesh is being refined (default)\n")
+);
+
+static TAutoConsoleVariable<float> CVarHoudiniEngineProxyMeshRefinementWindow(
+	TEXT("HoudiniEngine.ProxyMeshRefinementWindow"),
+	1.0f,
+	TEXT("Time (in s) between two updates of a proxy mesh under which it is considered as being refined.\n")
+	TEXT("Refined proxy meshes use the dynamic draw path, and switch back to the static draw path once not updated for that long.\n")
+	TEXT("<= 0.0: Never consider proxy meshes as being refined\n")
+	TEXT("1.0: Default\n")
+);
 
 UHoudiniStaticMeshComponent::UHoudiniStaticMeshComponent(const FObjectInitializer &InInitialzer) :
 	Super(InInitialzer)
@@ -63,6 +80,17 @@ void UHoudiniStaticMeshComponent::OnRegister()
 #endif
 }
 
+void UHoudiniStaticMeshComponent::BeginDestroy()
+{
+	if (MeshRefinementTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(MeshRefinementTickerHandle);
+		MeshRefinementTickerHandle.Reset();
+	}
+
+	Super::BeginDestroy();
+}
+
 //void
 //UHoudiniStaticMeshComponent::PostLoad()
 //{
@@ -136,8 +164,28 @@ void UHoudiniStaticMeshComponent::SetHoudiniIconVisible(bool bInHoudiniIconVisib
 #endif
 }
 
+bool UHoudiniStaticMeshComponent::ShouldUseStaticDrawPath() const
+{
+	return CVarHoudiniEngineProxyMeshStaticDraw.GetValueOnAnyThread() > 0 && !bMeshBeingRefined;
+}
+
 void UHoudiniStaticMeshComponent::NotifyMeshUpdated()
 {
+	// Updates arriving in quick succession mean the mesh is being refined: keep the proxy on the
+	// dynamic draw path until the updates stop, so we don't recache draw commands for every update.
+	const double Now = FPlatformTime::Seconds();
+	const float RefinementWindow = CVarHoudiniEngineProxyMeshRefinementWindow.GetValueOnGameThread();
+	if (RefinementWindow > 0.0f && LastMeshUpdateTime > 0.0 && (Now - LastMeshUpdateTime) < RefinementWindow)
+	{
+		bMeshBeingRefined = true;
+		if (!MeshRefinementTickerHandle.IsValid())
+		{
+			MeshRefinementTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+				FTickerDelegate::CreateUObject(this, &UHoudiniStaticMeshComponent::TickMeshRefinement), RefinementWindow);
+		}
+	}
+	LastMeshUpdateTime = Now;
+
 	MarkRenderStateDirty();
 	if (Mesh)
 	{
@@ -155,6 +203,26 @@ void UHoudiniStaticMeshComponent::NotifyMeshUpdated()
 #endif
 }
 
+bool UHoudiniStaticMeshComponent::TickMeshRefinement(float DeltaTime)
+{
+	const float RefinementWindow = CVarHoudiniEngineProxyMeshRefinementWindow.GetValueOnGameThread();
+	if (RefinementWindow > 0.0f && (FPlatformTime::Seconds() - LastMeshUpdateTime) < RefinementWindow)
+	{
+		// Still being updated, check again later
+		return true;
+	}
+
+	MeshRefinementTickerHandle.Reset();
+	if (bMeshBeingRefined)
+	{
+		// Recreate the proxy so it uses the static draw path
+		bMeshBeingRefined = false;
+		MarkRenderStateDirty();
+	}
+
+	return false;
+}
+
 #if WITH_EDITORONLY_DATA
 void UHoudiniStaticMeshComponent::UpdateSpriteComponent()
 {
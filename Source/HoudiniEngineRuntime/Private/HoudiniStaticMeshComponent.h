@@ -28,6 +28,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/MeshComponent.h"
+#include "Containers/Ticker.h"
 
 #include "HoudiniStaticMeshComponent.generated.h"
 
@@ -56,6 +57,8 @@ public:
 	
 	virtual void OnRegister() override;
 
+	virtual void BeginDestroy() override;
+
 	//virtual void PostLoad() override;
 
 	// UPrimitiveComponent interface
@@ -81,6 +84,13 @@ public:
 	UFUNCTION()
 	void SetHoudiniIconVisible(bool bInHoudiniIconVisible);
 
+	// Returns true while the mesh is receiving back-to-back updates (ie, interactive cooks).
+	bool IsMeshBeingRefined() const { return bMeshBeingRefined; }
+
+	// Returns true if the scene proxy should render via cached static draw commands
+	// instead of rebuilding its mesh batches every frame.
+	bool ShouldUseStaticDrawPath() const;
+
 protected:
 #if WITH_EDITORONLY_DATA
 	virtual void UpdateSpriteComponent();
@@ -97,4 +107,16 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Icons")
 	bool bHoudiniIconVisible;
 
+private:
+	// Switch the proxy back to the static draw path once the mesh stopped being updated.
+	bool TickMeshRefinement(float DeltaTime);
+
+	// Time (FPlatformTime::Seconds) of the last call to NotifyMeshUpdated.
+	double LastMeshUpdateTime = 0.0;
+
+	// Set while the mesh is updated repeatedly, the proxy then uses the dynamic draw path.
+	bool bMeshBeingRefined = false;
+
+	FTSTicker::FDelegateHandle MeshRefinementTickerHandle;
+
 };
\ No newline at end of file
@@ -158,6 +158,7 @@ FHoudiniStaticMeshSceneProxy::FHoudiniStaticMeshSceneProxy(UHoudiniStaticMeshCom
 	, FeatureLevel(InFeatureLevel)
 	, Component(InComponent)
 	, MaterialRelevance(InComponent ? InComponent->GetMaterialRelevance(InFeatureLevel) : FMaterialRelevance())
+	, bUseStaticDrawPath(InComponent ? InComponent->ShouldUseStaticDrawPath() : false)
 #if STATICMESH_ENABLE_DEBUG_RENDERING
 	, Owner(InComponent ? InComponent->GetOwner() : nullptr)
 #endif
@@ -252,6 +253,29 @@ void FHoudiniStaticMeshSceneProxy::Build()
 	}
 }
 
+void FHoudiniStaticMeshSceneProxy::DrawStaticElements(FStaticPrimitiveDrawInterface* PDI)
+{
+	if (!bUseStaticDrawPath)
+		return;
+
+	const ESceneDepthPriorityGroup DepthPriority = SDPG_World;
+
+	// Each (per material) buffer set is cached as a single mesh batch
+	for (FHoudiniStaticMeshRenderBufferSet* BufferSet : BufferSets)
+	{
+		if (BufferSet->NumTriangles == 0 || BufferSet->TriangleIndexBuffer.Indices.Num() == 0)
+			continue;
+
+		FMaterialRenderProxy* MaterialProxy = BufferSet->Material->GetRenderProxy();
+
+		FMeshBatch MeshBatch;
+		if (PopulateStaticMeshElement(MeshBatch, *BufferSet, MaterialProxy, DepthPriority))
+		{
+			PDI->DrawMesh(MeshBatch, FLT_MAX);
+		}
+	}
+}
+
 void FHoudiniStaticMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const
 {
 	const FEngineShowFlags EngineShowFlags = ViewFamily.EngineShowFlags;
@@ -286,7 +310,10 @@ void FHoudiniStaticMeshSceneProxy::GetDynamicMeshElements(const TArray<const FSc
 		GetScene().GetPrimitiveUniformShaderParameters_RenderThread(
 			GetPrimitiveSceneInfo(), bHasPrecomputedVolumetricLightmap, PreviousLocalToWorld, SingleCaptureIndex, bOutputVelocity);
 
-		const uint32 NumBufferSets = BufferSets.Num();
+		// The buffer sets are already drawn as static elements for this view
+		const bool bDrawBufferSets = !bUseStaticDrawPath || RequiresDynamicDrawPath(View);
+
+		const uint32 NumBufferSets = bDrawBufferSets ? BufferSets.Num() : 0;
 		for (uint32 BufferSetIdx = 0; BufferSetIdx < NumBufferSets; ++BufferSetIdx)
 		{
 			FHoudiniStaticMeshRenderBufferSet *BufferSet = BufferSets[BufferSetIdx];
@@ -367,13 +394,55 @@ bool FHoudiniStaticMeshSceneProxy::PopulateMeshElement(
 	return true;
 }
 
+bool FHoudiniStaticMeshSceneProxy::PopulateStaticMeshElement(
+	FMeshBatch &InMeshBatch,
+	const FHoudiniStaticMeshRenderBufferSet& Buffers,
+	FMaterialRenderProxy* Material,
+	ESceneDepthPriorityGroup DepthPriority) const
+{
+	// Same as PopulateMeshElement, but the batch uses the primitive's uniform buffer
+	// and lets the renderer apply the view mode overrides.
+	FMeshBatchElement& BatchElement = InMeshBatch.Elements[0];
+	BatchElement.IndexBuffer = &Buffers.TriangleIndexBuffer;
+	InMeshBatch.VertexFactory = &Buffers.LocalVertexFactory;
+	InMeshBatch.MaterialRenderProxy = Material;
+
+	BatchElement.FirstIndex = 0;
+	BatchElement.NumPrimitives = Buffers.NumTriangles;
+	BatchElement.MinVertexIndex = 0;
+	BatchElement.MaxVertexIndex = Buffers.PositionVertexBuffer.GetNumVertices() - 1;
+	InMeshBatch.LODIndex = 0;
+	InMeshBatch.ReverseCulling = IsLocalToWorldDeterminantNegative();
+	InMeshBatch.Type = PT_TriangleList;
+	InMeshBatch.DepthPriorityGroup = DepthPriority;
+	InMeshBatch.CastShadow = true;
+	InMeshBatch.bUseAsOccluder = ShouldUseAsOccluder();
+	InMeshBatch.bCanApplyViewModeOverrides = true;
+
+	return true;
+}
+
+bool FHoudiniStaticMeshSceneProxy::RequiresDynamicDrawPath(const FSceneView* View) const
+{
+	const FEngineShowFlags& EngineShowFlags = View->Family->EngineShowFlags;
+	return IsRichView(*View->Family)
+		|| (AllowDebugViewmodes() && EngineShowFlags.Wireframe)
+		|| EngineShowFlags.Bounds;
+}
 
 FPrimitiveViewRelevance FHoudiniStaticMeshSceneProxy::GetViewRelevance(const FSceneView* View) const
 {
 	FPrimitiveViewRelevance Result;
 
 	Result.bDrawRelevance = IsShown(View);
-	Result.bDynamicRelevance = true;
+	if (bUseStaticDrawPath && !RequiresDynamicDrawPath(View))
+	{
+		Result.bStaticRelevance = true;
+	}
+	else
+	{
+		Result.bDynamicRelevance = true;
+	}
 	Result.bRenderCustomDepth = ShouldRenderCustomDepth();
 	Result.bRenderInMainPass = ShouldRenderInMainPass();
 	Result.bShadowRelevance = IsShadowCast(View);
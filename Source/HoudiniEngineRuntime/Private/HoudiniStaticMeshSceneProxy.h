@@ -110,6 +110,8 @@ public:
 	virtual void Build();
 
 	// FPrimitiveSceneProxy
+	virtual void DrawStaticElements(FStaticPrimitiveDrawInterface* PDI) override;
+
 	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap, FMeshElementCollector& Collector) const override;
 
 	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override;
@@ -156,6 +158,16 @@ protected:
 		int ViewIndex,
 		FDynamicPrimitiveUniformBuffer& DynamicPrimitiveUniformBuffer) const;
 
+	// Fill a mesh batch that is cached by the renderer (static draw path).
+	virtual bool PopulateStaticMeshElement(
+		FMeshBatch &InMeshBatch,
+		const FHoudiniStaticMeshRenderBufferSet& Buffers,
+		FMaterialRenderProxy* Material,
+		ESceneDepthPriorityGroup DepthPriority) const;
+
+	// Returns true if the view needs the dynamic draw path (ie, wireframe or other debug views).
+	bool RequiresDynamicDrawPath(const FSceneView* View) const;
+
 	virtual UMaterialInterface* GetMaterial(uint32 InMaterialIdx) const;
 
 	UHoudiniStaticMeshComponent *Component;
@@ -166,6 +178,9 @@ protected:
 
 	FMaterialRelevance MaterialRelevance;
 
+	// If true, the buffer sets are drawn through DrawStaticElements instead of GetDynamicMeshElements.
+	bool bUseStaticDrawPath;
+
 private:
 #if STATICMESH_ENABLE_DEBUG_RENDERING
 	AActor* Owner;